@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltBlobStore.generated.h"
+
+class FGameJoltDeltaStore;
+
+/* Called once a blob has been saved, or couldn't be */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBlobSaved, const FString&, Name, bool, bWasSaved);
+
+/* Called once a blob has been loaded, or couldn't be */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnBlobLoaded, const FString&, Name, bool, bWasLoaded, const TArray<uint8>&, Data);
+
+/**
+ * Stores binary blobs like save games in the data-store
+ * A blob is compressed and split into chunks small enough for the query string of a single request, which are transferred in parallel
+ * The chunks of a save are written under a new version first. The manifest key, named like the blob, is switched to that version
+ * once all chunks arrived, so loads see either the old or the new version but never a mix. The chunks of the old version are removed afterwards
+ * With delta sync, blobs are split into content-defined chunks stored under their hash instead, and the version only holds the list of them.
+ * Saves upload the chunks the server doesn't hold yet and loads fetch the chunks which aren't kept on disk, so both scale with the size of the change
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltBlobStore : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates a blob store
+	 * @param API The instance the chunks are transferred with. Its events aren't triggered by the blob store
+	 * @param Type Whether blobs are stored globally or for the current user
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Blob Store"), Category = "GameJolt|Data-Store|Blob")
+	static UGameJoltBlobStore* CreateBlobStore(UUEGameJoltAPI* API, EDataStore Type);
+
+	/**
+	 * Compresses a blob and uploads it
+	 * @param Name The key of the blob's manifest
+	 * @param Data The content of the blob
+	 * @return False if the blob is being transferred already or couldn't be compressed
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Save Blob"), Category = "GameJolt|Data-Store|Blob")
+	bool SaveBlob(const FString& Name, const TArray<uint8>& Data);
+
+	/**
+	 * Downloads a blob and decompresses it
+	 * @param Name The key of the blob's manifest
+	 * @return False if the blob is being transferred already or the request couldn't be sent
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Blob"), Category = "GameJolt|Data-Store|Blob")
+	bool LoadBlob(const FString& Name);
+
+	/* Whether a blob is being saved or loaded */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Is Transferring Blob"), Category = "GameJolt|Data-Store|Blob")
+	bool IsTransferring(const FString& Name) const;
+
+	/* The maximum size of a chunk in bytes, before it is encoded for the query string. Each chunk takes a third more in the URL. Content-defined chunks are half as large on average */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Chunk Size", ClampMin = "256"), Category = "GameJolt|Data-Store|Blob")
+	int32 MaxChunkSize;
+
+	/* The maximum amount of chunks transferred at once, per blob */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Parallel Transfers", ClampMin = "1"), Category = "GameJolt|Data-Store|Blob")
+	int32 MaxParallelTransfers;
+
+	/**
+	 * Whether saves only upload the parts of a blob which changed since it was last synced on this device
+	 * Blobs saved with delta sync are loaded that way whether it is set or not
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Delta Sync"), Category = "GameJolt|Data-Store|Blob")
+	bool bDeltaSync;
+
+	/* How often a chunk is sent again after it failed, before the whole transfer fails */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Chunk Retries", ClampMin = "0"), Category = "GameJolt|Data-Store|Blob")
+	int32 ChunkRetries;
+
+	/* Event which triggers when a blob has been saved, or couldn't be */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Data-Store|Blob")
+	FOnBlobSaved OnBlobSaved;
+
+	/* Event which triggers when a blob has been loaded, or couldn't be */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Data-Store|Blob")
+	FOnBlobLoaded OnBlobLoaded;
+
+private:
+
+	/* A blob being saved or loaded. Defined next to the functions which use it */
+	struct FTransfer;
+
+	/* Adds the compressed content of a version as pieces */
+	bool AddVersionPieces(const FString& Name, FTransfer& Transfer, const TArray<uint8>& Data);
+
+	/**
+	 * Adds the content-defined chunks of a save which the server doesn't hold as pieces, unless they are added already
+	 * @return False if a chunk couldn't be compressed
+	 */
+	bool AddContentUploads(const FString& Name, FTransfer& Transfer, const TSet<FString>& HeldHashes);
+
+	/* Adds the content-defined chunks of a load which aren't kept on disk as pieces */
+	void AddContentDownloads(const FString& Name, FTransfer& Transfer);
+
+	/* Callback of a manifest fetch */
+	void OnManifestFetched(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version);
+
+	/* Transfers the next pieces until the limit of transfers in flight is reached */
+	void PumpChunks(const FString& Name);
+
+	/* Callback of a piece transfer */
+	void OnChunkTransferred(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version, int32 PieceIndex);
+
+	/* Switches the manifest to the new version once all pieces have been uploaded */
+	void TryCommit(const FString& Name);
+
+	/* Callback of the manifest update */
+	void OnCommitted(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version);
+
+	/* Joins and decompresses the downloaded chunks of the version, then fetches the content-defined chunks it lists */
+	void FinishLoad(const FString& Name);
+
+	/* Fails a transfer and removes the chunks a failed save uploaded */
+	void FailTransfer(const FString& Name);
+
+	/* Removes the chunks of a version, without waiting for the server */
+	void RemoveChunks(const FString& Name, const FString& Version, int32 NumChunks);
+
+	/* Removes a key, without waiting for the server */
+	void RemoveKey(const FString& Key);
+
+	/* Gets the transfer of a blob, if it is still the one of the specified version */
+	FTransfer* FindTransfer(const FString& Name, const FString& Version);
+
+	/* Gets the key of a chunk of a version */
+	static FString GetChunkKey(const FString& Name, const FString& Version, int32 ChunkIndex);
+
+	/* Gets the key of a content-defined chunk */
+	static FString GetContentKey(const FString& Name, const FString& Hash);
+
+	/* Gets the directory scope of the delta store. Blobs of different users are kept apart */
+	FString GetDeltaScope() const;
+
+	/* Gets the local side of delta syncs, creating it on first use */
+	FGameJoltDeltaStore& GetDeltaStore();
+
+	/* The instance the chunks are transferred with */
+	UPROPERTY()
+	UUEGameJoltAPI* API;
+
+	EDataStore Type;
+
+	/* The running transfers, by blob name */
+	TMap<FString, TSharedRef<FTransfer>> Transfers;
+
+	TSharedPtr<FGameJoltDeltaStore> DeltaStore;
+};
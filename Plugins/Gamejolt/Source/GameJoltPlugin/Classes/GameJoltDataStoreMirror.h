@@ -0,0 +1,118 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltDataStoreMirror.generated.h"
+
+/* Called once a sync completed */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDataStoreMirrorSynced, int32, NumKeys);
+
+/* Called if the keys or some of the data couldn't be fetched. Data which was fetched is kept */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDataStoreMirrorSyncFailed, int32, NumFailedKeys);
+
+/**
+ * Local copy of every data-store key under a prefix, e.g. all keys of a player profile
+ * A sync fetches the keys with a single request and their data with a bounded amount of requests in flight
+ * Reads are answered from memory afterwards. Writes made through the mirror update it right away and are sent to the server
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltDataStoreMirror : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates a mirror of the keys under a prefix. Nothing is fetched until it is synced
+	 * @param API The instance the data is fetched with. Its events aren't triggered by the mirror
+	 * @param Type Whether to mirror global keys or the keys stored for the current user
+	 * @param Prefix Only keys starting with this text are mirrored. Leave blank to mirror all keys
+	 * @param MaxParallelFetches The maximum amount of data fetches in flight at once
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Data-Store Mirror"), Category = "GameJolt|Data-Store|Mirror")
+	static UGameJoltDataStoreMirror* CreateDataStoreMirror(UUEGameJoltAPI* API, EDataStore Type, const FString& Prefix, int32 MaxParallelFetches = 4);
+
+	/**
+	 * Fetches all keys under the prefix and their data. Keys which were removed on the server are removed from the mirror
+	 * @return False if a sync is running already or the request couldn't be sent
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Sync Data-Store Mirror"), Category = "GameJolt|Data-Store|Mirror")
+	bool Sync();
+
+	/**
+	 * Gets the mirrored data of a key
+	 * @return Whether the key is mirrored
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Mirrored Data"), Category = "GameJolt|Data-Store|Mirror")
+	bool GetData(const FString& Key, FString& Data) const;
+
+	/* Gets all mirrored keys */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Mirrored Keys"), Category = "GameJolt|Data-Store|Mirror")
+	TArray<FString> GetKeys() const;
+
+	/* Sets the data of a key in the mirror and on the server */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Mirrored Data"), Category = "GameJolt|Data-Store|Mirror")
+	void SetData(const FString& Key, const FString& Data);
+
+	/* Removes a key from the mirror and the server */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Remove Mirrored Data"), Category = "GameJolt|Data-Store|Mirror")
+	void RemoveData(const FString& Key);
+
+	/* Whether a sync is running */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Is Syncing"), Category = "GameJolt|Data-Store|Mirror")
+	bool IsSyncing() const;
+
+	/* The maximum amount of data fetches in flight at once */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Parallel Fetches", ClampMin = "1"), Category = "GameJolt|Data-Store|Mirror")
+	int32 MaxParallelFetches;
+
+	/* Event which triggers when a sync completed */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Data-Store|Mirror")
+	FOnDataStoreMirrorSynced OnSynced;
+
+	/* Event which triggers when a sync couldn't fetch everything */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Data-Store|Mirror")
+	FOnDataStoreMirrorSyncFailed OnSyncFailed;
+
+private:
+
+	/* Callback of the key fetch */
+	void OnKeysFetched(const FGameJoltRequest& GameJoltRequest);
+
+	/* Fetches the data of the next keys until the limit of requests in flight is reached */
+	void FetchNextKeys();
+
+	/* Callback of a data fetch */
+	void OnDataFetched(const FGameJoltRequest& GameJoltRequest, const FString& Key);
+
+	/* Broadcasts the result of the sync once all fetches completed */
+	void FinishSync();
+
+	/* The instance the data is fetched with */
+	UPROPERTY()
+	UUEGameJoltAPI* API;
+
+	EDataStore Type;
+	FString Prefix;
+
+	/* The mirrored data, by key */
+	TMap<FString, FString> Values;
+
+	/* The keys of the running sync */
+	TArray<FString> SyncKeys;
+
+	/* Index of the next key of the running sync to fetch */
+	int32 NextKeyIndex;
+
+	/* The amount of data fetches in flight */
+	int32 NumFetching;
+
+	/* The amount of data fetches of the running sync which failed */
+	int32 NumFailed;
+
+	bool bSyncing;
+
+	/* Keys written through the mirror during the running sync. Their fetched data would be outdated */
+	TSet<FString> WrittenKeys;
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameJoltTransport.h"
+
+class FJsonObject;
+
+/**
+ * In-process stand-in for the GameJolt API
+ * Implements the users, friends, sessions, trophies, scores, data-store, time and batch endpoints on in-memory state,
+ * and rejects requests with a wrong game id or signature like the real server does
+ * Responses are delivered on the next tick of the game thread
+ * Must be created with Create, on the game thread. May be released on any thread, e.g. by the session heartbeat
+ */
+class GAMEJOLTPLUGIN_API FGameJoltFakeServer : public IGameJoltTransport
+{
+public:
+
+	/**
+	 * Creates a fake server and registers it with the core ticker
+	 * @param InGameID The game id requests have to be sent with
+	 * @param InPrivateKey The private key requests have to be signed with
+	 * @param InUrlPrefix The URL all endpoints are appended to
+	 */
+	static TSharedRef<FGameJoltFakeServer, ESPMode::ThreadSafe> Create(int32 InGameID, const FString& InPrivateKey, const FString& InUrlPrefix = TEXT("https://api.gamejolt.com/api/game/v1_2"));
+
+	/**
+	 * Adds a user who can log in
+	 * @return The id of the new user
+	 */
+	int32 AddUser(const FString& UserName, const FString& UserToken);
+
+	/* Makes two users friends of each other */
+	void AddFriends(int32 UserID, int32 FriendID);
+
+	/* Adds a trophy which can be achieved */
+	void AddTrophy(int32 TrophyID, const FString& Title, const FString& Difficulty = TEXT("Bronze"));
+
+	/* Adds a scoreboard. The first one added is the primary one unless another one is marked as primary */
+	void AddScoreTable(int32 TableID, const FString& Name, bool bPrimary = false);
+
+	/* Adds a score of a guest to a scoreboard added before */
+	void AddGuestScore(int32 TableID, const FString& Score, int32 Sort, const FString& Guest);
+
+	/* Adds a score of a user added before to a scoreboard added before */
+	void AddUserScore(int32 TableID, const FString& Score, int32 Sort, int32 UserID);
+
+	/* Gets the amount of requests received, sub-requests of batches included */
+	int32 GetNumRequests() const;
+
+	virtual void Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete) override;
+
+private:
+
+	FGameJoltFakeServer(int32 InGameID, const FString& InPrivateKey, const FString& InUrlPrefix);
+
+	struct FFakeUser
+	{
+		int32 Id;
+		FString Name;
+		FString Token;
+		int64 SignedUp;
+		int64 LastLoggedIn;
+		bool bSessionOpen;
+		FString SessionStatus;
+		TArray<int32> FriendIDs;
+
+		/* Unix time each trophy was achieved at, by trophy id */
+		TMap<int32, int64> AchievedTrophies;
+
+		TMap<FString, FString> Data;
+	};
+
+	struct FFakeTrophy
+	{
+		int32 Id;
+		FString Title;
+		FString Difficulty;
+	};
+
+	struct FFakeScore
+	{
+		FString Score;
+		int32 Sort;
+		FString ExtraData;
+		int32 UserID;
+		FString UserName;
+		FString Guest;
+		int64 Stored;
+	};
+
+	struct FFakeTable
+	{
+		int32 Id;
+		FString Name;
+		bool bPrimary;
+
+		/* Sorted from best to worst */
+		TArray<FFakeScore> Scores;
+	};
+
+	/* A request waiting for the next tick */
+	struct FQueuedRequest
+	{
+		FString Url;
+		FGameJoltTransportCallback OnComplete;
+	};
+
+	/**
+	 * Handles a request and serializes the response
+	 * @return The complete response, including the "response" envelope
+	 */
+	FString HandleUrl(const FString& Url);
+
+	/**
+	 * Checks the game id and signature of a URL and splits it into its path and decoded parameters
+	 * @param bWithPrefix Whether the URL starts with the server. Sub-requests of a batch don't
+	 * @return The failed response if the URL was rejected, invalid otherwise
+	 */
+	TSharedPtr<FJsonObject> ParseUrl(const FString& Url, bool bWithPrefix, FString& OutPath, TMultiMap<FString, FString>& OutParameters) const;
+
+	/* Handles a request within the "response" envelope */
+	TSharedRef<FJsonObject> HandleEndpoint(const FString& Path, const TMultiMap<FString, FString>& Parameters);
+
+	/* Handles the sub-requests of a batch */
+	TSharedRef<FJsonObject> HandleBatch(const TMultiMap<FString, FString>& Parameters);
+
+	/* Finds the user the username and user_token parameters belong to. Null if they don't match */
+	FFakeUser* FindAuthenticatedUser(const TMultiMap<FString, FString>& Parameters);
+
+	/* Inserts a score behind all scores which are at least as good, so equal scores stay in the order they were added */
+	static FFakeScore& InsertScore(FFakeTable& Table, const FFakeScore& Score);
+
+	/* Finds the scoreboard of the table_id parameter, or the primary one */
+	FFakeTable* FindTable(const TMultiMap<FString, FString>& Parameters);
+
+	/* Ticker callback which answers the queued requests */
+	bool Tick(float DeltaTime);
+
+	int32 GameID;
+	FString PrivateKey;
+	FString UrlPrefix;
+
+	TArray<FFakeUser> Users;
+	TArray<FFakeTrophy> Trophies;
+	TArray<FFakeTable> Tables;
+	TMap<FString, FString> GlobalData;
+
+	int32 NumRequests;
+
+	/* Guards the queued requests, which may be sent from any thread */
+	FCriticalSection QueueLock;
+	TArray<FQueuedRequest> QueuedRequests;
+};
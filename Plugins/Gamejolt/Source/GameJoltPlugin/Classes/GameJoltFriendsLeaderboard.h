@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltFriendsLeaderboard.generated.h"
+
+/* Called once the scores of the current user and their friends have been loaded */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFriendsLeaderboardLoaded, const TArray<FScoreInfo>&, Scores);
+
+/* Called if the friends or the scoreboard couldn't be fetched */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnFriendsLeaderboardFailed);
+
+/**
+ * Scoreboard of the current user and their friends, loaded with a single call
+ * The server only returns the scores of the whole scoreboard or of the current user, so the friend list, the current user's best score
+ * and the first page of the scoreboard are fetched at once. Further pages are fetched until every friend was found or the page limit is reached
+ * The result keeps the best score of every friend, ordered like the scoreboard. The friend list is cached and only fetched again once it expired
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltFriendsLeaderboard : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates a friends leaderboard. Nothing is fetched until it is loaded
+	 * @param API The instance the friends and scores are fetched with. Its events aren't triggered by the leaderboard
+	 * @param TableID The id of the scoreboard. 0 for the primary one
+	 * @param MaxPages The maximum amount of scoreboard pages searched for friends, 100 scores each
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Friends Leaderboard"), Category = "GameJolt|Scoreboard|Friends")
+	static UGameJoltFriendsLeaderboard* CreateFriendsLeaderboard(UUEGameJoltAPI* API, int32 TableID, int32 MaxPages = 10);
+
+	/**
+	 * Fetches the scores of the current user and their friends. Triggers OnLoaded once they are known
+	 * @return False if a load is running already, no user is logged in or the requests couldn't be sent
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Friends Leaderboard"), Category = "GameJolt|Scoreboard|Friends")
+	bool Load();
+
+	/* Gets the scores of the last load, best first */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Friends Scores"), Category = "GameJolt|Scoreboard|Friends")
+	TArray<FScoreInfo> GetScores() const;
+
+	/* Gets the IDs of the cached friends */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Cached Friends"), Category = "GameJolt|Scoreboard|Friends")
+	TArray<int32> GetFriendIDs() const;
+
+	/* Whether a load is running */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Is Loading"), Category = "GameJolt|Scoreboard|Friends")
+	bool IsLoading() const;
+
+	/* Drops the cached friend list, so the next load fetches it again, e.g. after a friend was added */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Cached Friends"), Category = "GameJolt|Scoreboard|Friends")
+	void ClearFriends();
+
+	/* Seconds the friend list is used before it is fetched again */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Friend List Lifetime", ClampMin = "0"), Category = "GameJolt|Scoreboard|Friends")
+	float FriendListLifetime;
+
+	/* The maximum amount of scoreboard pages searched for friends, 100 scores each */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Pages", ClampMin = "1"), Category = "GameJolt|Scoreboard|Friends")
+	int32 MaxPages;
+
+	/* Event which triggers when the scores have been loaded */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Scoreboard|Friends")
+	FOnFriendsLeaderboardLoaded OnLoaded;
+
+	/* Event which triggers when a load failed */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Scoreboard|Friends")
+	FOnFriendsLeaderboardFailed OnFailed;
+
+private:
+
+	/* Callback of the friend list fetch */
+	void OnFriendsFetched(const FGameJoltRequest& GameJoltRequest, const FString& FetchUserName, uint32 LoadGeneration);
+
+	/* Callback of the current user's score fetch */
+	void OnOwnScoreFetched(const FGameJoltRequest& GameJoltRequest, uint32 LoadGeneration);
+
+	/* Fetches the next page of the scoreboard. Returns false if it couldn't be sent */
+	bool FetchPage();
+
+	/* Callback of a page request */
+	void OnPageFetched(const FGameJoltRequest& GameJoltRequest, int32 NumSkipped, uint32 LoadGeneration);
+
+	/* Fetches the next page or finishes the load, once the responses it depends on arrived */
+	void Advance();
+
+	/* Merges the fetched scores and broadcasts them */
+	void FinishLoad();
+
+	/* Ends the running load and broadcasts the failure */
+	void FailLoad();
+
+	/* The instance the friends and scores are fetched with */
+	UPROPERTY()
+	UUEGameJoltAPI* API;
+
+	int32 TableID;
+
+	/* The scores of the last load */
+	TArray<FScoreInfo> Scores;
+
+	/* The cached friends */
+	TSet<int32> FriendIDs;
+
+	/* The user the cached friends belong to */
+	FString FriendsUserName;
+
+	/* FPlatformTime::Seconds() when the friends were fetched */
+	double FriendsFetchTime;
+
+	/* The scoreboard pages fetched by the running load, best first */
+	TArray<FScoreInfo> PageScores;
+
+	/* Best score of the current user. Its user id is 0 if the user has none or it couldn't be fetched */
+	FScoreInfo OwnScore;
+
+	/* The amount of pages fetched by the running load */
+	int32 NumPagesFetched;
+
+	/* The sort value of the last score of the last page, and how many scores ended the page with it */
+	int32 LastPageSort;
+	int32 LastPageNumTied;
+
+	/* Whether better scores have lower sort values. Detected from the first page */
+	bool bAscending;
+
+	bool bLoading;
+	bool bFetchingFriends;
+	bool bFetchingOwnScore;
+	bool bFetchingPage;
+	bool bEndReached;
+
+	/* Bumped with every load, so responses of earlier loads are ignored */
+	uint32 Generation;
+};
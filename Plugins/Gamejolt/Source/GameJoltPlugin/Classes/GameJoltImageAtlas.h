@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Styling/SlateBrush.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltImageAtlas.generated.h"
+
+class UTexture2D;
+
+/* Called once an image has been packed into the atlas, or couldn't be */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAtlasImageAdded, const FString&, URL, bool, bWasAdded);
+
+/**
+ * Packs avatars and trophy images loaded by the image loader into a few shared textures
+ * Widgets drawing images of the same page use the same texture with different UV regions, so Slate batches them into one draw
+ * and a grid of trophies costs a single texture instead of one per trophy
+ * Images are placed on shelves as they arrive. Only the new image is uploaded, the rest of the page stays as it is
+ * The pixels of each page are kept on the CPU as well, as texture data can't be read back in cooked builds
+ * Each image is surrounded by a border repeating its edge pixels, so filtering never samples its neighbours
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltImageAtlas : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates an image atlas
+	 * @param PageSize The width and height of each texture. A new page is started once an image doesn't fit anymore
+	 * @param Padding The border around each image, in pixels
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Image Atlas"), Category = "GameJolt|Images")
+	static UGameJoltImageAtlas* CreateImageAtlas(int32 PageSize = 1024, int32 Padding = 2);
+
+	/**
+	 * Loads an image and packs it into the atlas. Triggers OnImageAdded once it is packed, right away if it is already
+	 * @return False if the URL is empty
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Image"), Category = "GameJolt|Images")
+	bool AddImage(const FString& URL);
+
+	/* Packs the avatar of a user into the atlas */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Avatar"), Category = "GameJolt|Images")
+	bool AddAvatar(const FUserInfo& User);
+
+	/* Packs the image of a trophy into the atlas */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Trophy Image"), Category = "GameJolt|Images")
+	bool AddTrophyImage(const FTrophyInfo& Trophy);
+
+	/**
+	 * Packs the images of trophies into the atlas, like the ones fetched with Fetch Trophies
+	 * @return The amount of images which are being added
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Trophy Images"), Category = "GameJolt|Images")
+	int32 AddTrophyImages(const TArray<FTrophyInfo>& Trophies);
+
+	/**
+	 * Gets a brush drawing a packed image
+	 * @return False if the image isn't packed (yet)
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Atlas Brush"), Category = "GameJolt|Images")
+	bool GetBrush(const FString& URL, FSlateBrush& OutBrush) const;
+
+	/**
+	 * Gets where a packed image is placed, for drawing it with materials or canvas
+	 * @param OutTexture The page the image is packed into
+	 * @return False if the image isn't packed (yet)
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Atlas Region"), Category = "GameJolt|Images")
+	bool GetRegion(const FString& URL, UTexture2D*& OutTexture, FVector2D& OutMinUV, FVector2D& OutMaxUV) const;
+
+	/* Event which triggers when an image has been packed into the atlas, or couldn't be */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Images")
+	FOnAtlasImageAdded OnImageAdded;
+
+private:
+
+	/* Where a packed image is placed, without its border */
+	struct FRegion
+	{
+		int32 Page;
+		FIntRect Rect;
+	};
+
+	/* A row of images of similar height */
+	struct FShelf
+	{
+		int32 Y;
+		int32 Height;
+
+		/* Where the next image is placed */
+		int32 X;
+	};
+
+	/* The shelves of a page */
+	struct FPageLayout
+	{
+		TArray<FShelf> Shelves;
+
+		/* Where the next shelf is placed */
+		int32 NextY;
+	};
+
+	/**
+	 * Packs a loaded image into the atlas
+	 * @param Pixels The 8 bit BGRA pixels of the image. Null if it couldn't be loaded
+	 */
+	void OnImageLoaded(const FString& URL, const TArray<uint8>* Pixels, int32 Width, int32 Height);
+
+	/**
+	 * Finds a place for an image, starting a new page if none has room left
+	 * @param Width, Height The size of the image including its border
+	 */
+	bool Allocate(int32 Width, int32 Height, int32& OutPage, FIntPoint& OutPosition);
+
+	/* Finds a place for an image on a page. Returns false if the page is full */
+	bool AllocateOnPage(FPageLayout& Layout, int32 Width, int32 Height, FIntPoint& OutPosition) const;
+
+	/* Creates a texture for a new page */
+	UTexture2D* CreatePage() const;
+
+	/* The textures of the pages */
+	UPROPERTY(Transient)
+	TArray<UTexture2D*> Pages;
+
+	/* The 8 bit BGRA pixels of each page */
+	TArray<TArray<uint8>> PagePixels;
+
+	/* The shelves of each page */
+	TArray<FPageLayout> Layouts;
+
+	/* Where each packed image is placed, by URL */
+	TMap<FString, FRegion> Regions;
+
+	/* URLs which are being loaded */
+	TSet<FString> Pending;
+
+	int32 PageSize;
+
+	int32 Padding;
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltImageLoader.generated.h"
+
+class UTexture2D;
+class IImageWrapperModule;
+struct FGameJoltDecodedImage;
+
+/* Called once an image has been loaded. The texture is null if it couldn't be */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnImageLoaded, const FString&, URL, UTexture2D*, Texture);
+
+/* Called once a single image has been loaded. Used by C++ callers which need exactly their image */
+typedef TFunction<void(UTexture2D*)> FGameJoltImageCallback;
+
+/**
+ * Called once a single image has been decoded, with its pixels. Used by C++ callers which copy the pixels elsewhere, e.g. into an atlas
+ * @param Pixels The 8 bit BGRA pixels, Width * Height * 4 bytes. Null if the image couldn't be loaded. Only valid during the call
+ */
+typedef TFunction<void(UTexture2D* Texture, const TArray<uint8>* Pixels, int32 Width, int32 Height)> FGameJoltImagePixelsCallback;
+
+/**
+ * Loads avatars and trophy images into textures, shared by the whole game
+ * Images are downloaded with a bounded amount of requests in flight and decoded on worker threads
+ * Textures are kept in memory up to a budget in bytes, evicting the least recently used ones
+ * Downloaded files are kept on disk, named by the hash of their content so an image shared by many users is stored once.
+ * They are downloaded again once they expired, and still used while the server can't be reached
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltImageLoader : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/* Gets the image loader shared by the whole game, creating it on first use */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Image Loader"), Category = "GameJolt|Images")
+	static UGameJoltImageLoader* GetImageLoader();
+
+	/**
+	 * Loads an image. Triggers OnImageLoaded once it is loaded, right away if it is in memory
+	 * @return False if the URL is empty
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Image"), Category = "GameJolt|Images")
+	bool LoadImage(const FString& URL);
+
+	/* Loads the avatar of a user. Triggers OnImageLoaded with the avatar's URL */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Avatar"), Category = "GameJolt|Images")
+	bool LoadAvatar(const FUserInfo& User);
+
+	/* Loads the image of a trophy. Triggers OnImageLoaded with the image's URL */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Trophy Image"), Category = "GameJolt|Images")
+	bool LoadTrophyImage(const FTrophyInfo& Trophy);
+
+	/* Gets an image if it is in memory. Null otherwise */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Find Image"), Category = "GameJolt|Images")
+	UTexture2D* FindImage(const FString& URL);
+
+	/**
+	 * Loads an image and calls back with it, without triggering OnImageLoaded
+	 * The callback is called right away if the image is in memory, and with null if it couldn't be loaded
+	 */
+	void RequestImage(const FString& URL, FGameJoltImageCallback OnLoaded);
+
+	/**
+	 * Loads an image and calls back with its decoded pixels, without triggering OnImageLoaded
+	 * Textures don't keep their pixels readable, so the image is decoded again even if it is in memory, from disk if it is kept there
+	 */
+	void RequestImagePixels(const FString& URL, FGameJoltImagePixelsCallback OnLoaded);
+
+	/* Removes all images from memory. Textures still used elsewhere stay valid */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Image Memory"), Category = "GameJolt|Images")
+	void ClearMemory();
+
+	/* The maximum amount of images downloaded or read from disk at once */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Parallel Loads", ClampMin = "1"), Category = "GameJolt|Images")
+	int32 MaxParallelLoads;
+
+	/* The maximum size of the textures kept in memory, in bytes */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Memory Bytes", ClampMin = "0"), Category = "GameJolt|Images")
+	int32 MaxMemoryBytes;
+
+	/* Whether downloaded images are kept on disk */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Use Disk Cache"), Category = "GameJolt|Images")
+	bool bUseDiskCache;
+
+	/* Seconds an image is used from disk before it is downloaded again */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Disk Cache Lifetime", ClampMin = "0"), Category = "GameJolt|Images")
+	float DiskCacheLifetime;
+
+	/* Event which triggers when an image requested with Load Image has been loaded, or couldn't be */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Images")
+	FOnImageLoaded OnImageLoaded;
+
+private:
+
+	/* Use of an image kept in memory */
+	struct FImageUse
+	{
+		/* Size of the texture */
+		int32 Bytes;
+
+		/* FPlatformTime::Seconds() when the image was used last. Used to evict the least recently used image */
+		double LastAccessTime;
+	};
+
+	/* Starts loading the next images until the limit of loads in flight is reached */
+	void StartNextLoads();
+
+	/* Reads an image from disk and decodes it on a worker thread, downloading it if it isn't kept or expired */
+	void StartLoad(const FString& URL);
+
+	/**
+	 * Downloads an image
+	 * @param ExpiredFile The expired file kept on disk, used if the download fails
+	 */
+	void Download(const FString& URL, const TArray<uint8>& ExpiredFile);
+
+	/* Decodes a downloaded image on a worker thread, keeping it on disk if it could be decoded */
+	void Decode(const FString& URL, TArray<uint8> File, bool bKeepOnDisk);
+
+	/* Creates the texture of a decoded image and calls the waiting callbacks */
+	void OnDecoded(const FString& URL, const FGameJoltDecodedImage* Image);
+
+	/* Keeps a texture in memory, evicting the least recently used ones beyond the budget */
+	void AddToMemory(const FString& URL, UTexture2D* Texture, int32 Bytes);
+
+	/* Removes an image from memory */
+	void RemoveFromMemory(const FString& URL);
+
+	/* Gets the image wrapper module. Loaded on the game thread, used by the worker threads */
+	IImageWrapperModule& GetImageWrapperModule();
+
+	/* The textures kept in memory, by URL */
+	UPROPERTY(Transient)
+	TMap<FString, UTexture2D*> Images;
+
+	/* Use of the textures kept in memory, by URL */
+	TMap<FString, FImageUse> ImageUses;
+
+	/* Size of the textures kept in memory */
+	int32 MemoryBytes;
+
+	/* The callbacks waiting for an image, by URL. An image is loaded once, however often it is requested */
+	TMap<FString, TArray<FGameJoltImagePixelsCallback>> Waiters;
+
+	/* URLs waiting for a load to start, in request order */
+	TArray<FString> Queue;
+
+	/* The amount of loads in flight */
+	int32 NumLoading;
+
+	/* Whether files long past their lifetime have been removed from disk */
+	bool bDiskCachePruned;
+
+	FString DiskDirectory;
+
+	IImageWrapperModule* ImageWrapperModule;
+};
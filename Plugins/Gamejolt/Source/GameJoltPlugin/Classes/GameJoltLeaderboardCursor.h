@@ -0,0 +1,152 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltLeaderboardCursor.generated.h"
+
+/* Called once a page of rows has been loaded */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLeaderboardRowsLoaded, int32, FirstIndex, int32, NumRows);
+
+/* Called once the last page has been loaded, so the amount of rows is known */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLeaderboardEndReached, int32, NumRows);
+
+/* Called if a page couldn't be loaded. It is requested again with the next visible range */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnLeaderboardPageFailed, int32, FirstIndex);
+
+/**
+ * Pages through a scoreboard for a scrolling list
+ * Keeps the pages around the visible range loaded, fetches the pages next to it before they become visible
+ * and evicts the pages furthest away once the cached rows exceed the memory cap
+ * Pages are chained with worse_than, starting at the best score. Scores tied across a page boundary are neither skipped nor repeated
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltLeaderboardCursor : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates a cursor over a scoreboard. Nothing is fetched until the visible range is set
+	 * @param API The instance the pages are fetched with. Its events aren't triggered by the cursor
+	 * @param TableID The id of the scoreboard. 0 for the primary one
+	 * @param PageSize The amount of rows fetched with a single request. Between 1 and 100
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Leaderboard Cursor"), Category = "GameJolt|Scoreboard|Cursor")
+	static UGameJoltLeaderboardCursor* CreateLeaderboardCursor(UUEGameJoltAPI* API, int32 TableID, int32 PageSize = 25);
+
+	/**
+	 * Sets the rows currently shown. Loads the pages around them and evicts the ones far away
+	 * @param FirstIndex The first visible row, starting at 0 for the best score
+	 * @param LastIndex The last visible row
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Visible Range"), Category = "GameJolt|Scoreboard|Cursor")
+	void SetVisibleRange(int32 FirstIndex, int32 LastIndex);
+
+	/**
+	 * Gets a row
+	 * @return Whether the row is loaded
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Row"), Category = "GameJolt|Scoreboard|Cursor")
+	bool GetRow(int32 Index, FScoreInfo& Score) const;
+
+	/* Gets the amount of rows to show: all rows once the end was reached, otherwise the rows discovered so far plus a page to scroll into */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Num Rows"), Category = "GameJolt|Scoreboard|Cursor")
+	int32 GetNumRows() const;
+
+	/* Whether the last page has been loaded */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Is End Reached"), Category = "GameJolt|Scoreboard|Cursor")
+	bool IsEndReached() const;
+
+	/* Drops all pages, e.g. after a score was added. Responses still in flight are ignored */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Leaderboard Cursor"), Category = "GameJolt|Scoreboard|Cursor")
+	void Reset();
+
+	/* Gets the estimated memory held by the loaded pages, in bytes */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Get Cached Memory"), Category = "GameJolt|Scoreboard|Cursor")
+	int32 GetCachedMemory() const;
+
+	/* The amount of pages before and after the visible ones which are loaded ahead of time */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Prefetch Pages", ClampMin = "0"), Category = "GameJolt|Scoreboard|Cursor")
+	int32 PrefetchPages;
+
+	/* The memory the loaded pages may take, in bytes. Visible and prefetched pages are never evicted, even beyond the cap */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Cached Memory", ClampMin = "0"), Category = "GameJolt|Scoreboard|Cursor")
+	int32 MaxCachedMemory;
+
+	/* Event which triggers when a page of rows has been loaded */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Scoreboard|Cursor")
+	FOnLeaderboardRowsLoaded OnRowsLoaded;
+
+	/* Event which triggers when the last page has been loaded */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Scoreboard|Cursor")
+	FOnLeaderboardEndReached OnEndReached;
+
+	/* Event which triggers when a page couldn't be loaded */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Scoreboard|Cursor")
+	FOnLeaderboardPageFailed OnPageFailed;
+
+private:
+
+	/* A loaded page */
+	struct FPage
+	{
+		TArray<FScoreInfo> Scores;
+
+		/* Estimated memory of the scores, in bytes */
+		int32 Size;
+	};
+
+	/* Where a page ended. Kept after the page was evicted, so the pages behind it can still be fetched */
+	struct FPageBoundary
+	{
+		/* The sort value of the last score of the page */
+		int32 Sort;
+
+		/* The amount of scores with that sort value at the end of this page and the pages before */
+		int32 NumTied;
+	};
+
+	/* Fetches the missing pages around the visible range and evicts the ones far away */
+	void Update();
+
+	/* Fetches a page whose previous page boundary is known */
+	void FetchPage(int32 PageIndex);
+
+	/* Callback of a page request */
+	void OnPageFetched(const FGameJoltRequest& GameJoltRequest, int32 PageIndex, int32 NumSkipped, uint32 FetchGeneration);
+
+	/* Evicts the pages furthest from the visible ones until the cap is met */
+	void EvictPages();
+
+	/* The instance the pages are fetched with */
+	UPROPERTY()
+	UUEGameJoltAPI* API;
+
+	int32 TableID;
+	int32 PageSize;
+
+	int32 FirstVisibleIndex;
+	int32 LastVisibleIndex;
+
+	/* The loaded pages, by index */
+	TMap<int32, FPage> Pages;
+
+	/* Boundary of every page discovered so far, by index */
+	TArray<FPageBoundary> Boundaries;
+
+	/* Pages being fetched */
+	TSet<int32> LoadingPages;
+
+	/* The total amount of rows. Negative until the end was reached */
+	int32 NumTotalRows;
+
+	/* Whether better scores have lower sort values. Detected from the first page */
+	bool bAscending;
+
+	/* Bumped on reset, so responses of earlier fetches are ignored */
+	uint32 Generation;
+
+	int32 CachedMemory;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/**
+ * Decodes the "response" object of a request straight into the typed structs
+ * Unlike the UUEGameJoltAPI accessors (Get Data Field, Get Object Array Field, ...) no UObjects are created on the way
+ * Every decoder resets and pre-sizes its output array and returns false if the expected field is missing
+ */
+struct GAMEJOLTPLUGIN_API FGameJoltResponseDecoder
+{
+	/* Decodes the "scores" of a scoreboard */
+	static bool DecodeScores(const TSharedPtr<FJsonObject>& Response, TArray<FScoreInfo>& OutScores);
+
+	/* Decodes the "users" of a user fetch */
+	static bool DecodeUsers(const TSharedPtr<FJsonObject>& Response, TArray<FUserInfo>& OutUsers);
+
+	/* Decodes the "trophies" of a trophy fetch */
+	static bool DecodeTrophies(const TSharedPtr<FJsonObject>& Response, TArray<FTrophyInfo>& OutTrophies);
+
+	/* Decodes the "tables" of a scoreboard table fetch */
+	static bool DecodeScoreTables(const TSharedPtr<FJsonObject>& Response, TArray<FScoreTableInfo>& OutTables);
+
+	/* Decodes the "friends" of a friendlist fetch */
+	static bool DecodeFriendlist(const TSharedPtr<FJsonObject>& Response, TArray<int32>& OutFriendIDs);
+
+	/* Decodes the "keys" of a data-store key fetch */
+	static bool DecodeDataKeys(const TSharedPtr<FJsonObject>& Response, TArray<FString>& OutKeys);
+
+	/* Decodes the fields of a server time fetch */
+	static bool DecodeServerTime(const TSharedPtr<FJsonObject>& Response, FDateTime& OutServerTime);
+
+	/* Decodes the "success" field */
+	static bool DecodeSuccess(const TSharedPtr<FJsonObject>& Response);
+
+	/* Decodes a string field. Empty if it is missing */
+	static FString DecodeString(const FJsonObject& Object, const TCHAR* Key);
+
+	/* Decodes an integer field, which the server might send as a string. 0 if it is missing */
+	static int32 DecodeInt(const FJsonObject& Object, const TCHAR* Key);
+};
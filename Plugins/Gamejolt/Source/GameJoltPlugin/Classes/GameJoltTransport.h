@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Called on the game thread once a request completed
+ * @param bWasSuccessful Whether a response was received at all
+ * @param ResponseCode The HTTP status of the response. 0 if none was received
+ * @param Content The content of the response, UTF-8 encoded
+ */
+typedef TFunction<void(bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& Content)> FGameJoltTransportCallback;
+
+/**
+ * Sends signed requests to the GameJolt API, or to something standing in for it
+ * Implementations may be called from any thread and call back on the game thread
+ * They are shared with the session heartbeat thread, so they are held by thread-safe shared pointers
+ */
+class GAMEJOLTPLUGIN_API IGameJoltTransport
+{
+public:
+
+	virtual ~IGameJoltTransport() {}
+
+	/**
+	 * Sends a request
+	 * @param Url The signed URL, including the server
+	 * @param Body The content to post
+	 * @param OnComplete Called on the game thread once the request completed
+	 */
+	virtual void Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete) = 0;
+};
+
+/* Sends requests to the GameJolt servers through the HTTP module. The default transport */
+class GAMEJOLTPLUGIN_API FGameJoltHttpTransport : public IGameJoltTransport
+{
+public:
+
+	virtual void Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete) override;
+};
+
+/**
+ * Delays and fails the requests of another transport, e.g. of a FGameJoltFakeServer
+ * All decisions are drawn from a seeded random stream, so a run can be repeated exactly
+ * Must be created with Create, on the game thread. May be released on any thread, e.g. by the session heartbeat
+ */
+class GAMEJOLTPLUGIN_API FGameJoltFaultInjectingTransport : public IGameJoltTransport, public TSharedFromThis<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Creates a transport injecting faults and registers it with the core ticker
+	 * @param InInner The transport the requests which aren't dropped are sent with
+	 * @param Seed The seed of the random stream
+	 */
+	static TSharedRef<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> Create(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InInner, int32 Seed = 0);
+
+	/**
+	 * Sets the faults to inject
+	 * @param InMinLatency The shortest delay added to every response, in seconds
+	 * @param InMaxLatency The longest delay added to every response, in seconds
+	 * @param InDropRate The share of requests (0-1) which never reach the inner transport and fail without a response
+	 * @param InServerErrorRate The share of requests (0-1) which are answered with a 503 instead of their response
+	 */
+	void SetFaults(float InMinLatency, float InMaxLatency, float InDropRate, float InServerErrorRate);
+
+	virtual void Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete) override;
+
+private:
+
+	FGameJoltFaultInjectingTransport(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InInner, int32 Seed);
+
+	/* A response held back until its latency elapsed */
+	struct FDelayedResponse
+	{
+		double DueTime;
+		bool bWasSuccessful;
+		int32 ResponseCode;
+		TArray<uint8> Content;
+		FGameJoltTransportCallback OnComplete;
+	};
+
+	/* Holds a response back until its latency elapsed */
+	void Delay(double DueTime, bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& Content, FGameJoltTransportCallback OnComplete);
+
+	/* Ticker callback which delivers the responses whose latency elapsed */
+	bool Tick(float DeltaTime);
+
+	TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> Inner;
+
+	/* Guards everything below, requests may be sent from any thread */
+	FCriticalSection Lock;
+
+	FRandomStream Random;
+	float MinLatency;
+	float MaxLatency;
+	float DropRate;
+	float ServerErrorRate;
+
+	TArray<FDelayedResponse> DelayedResponses;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltUserLookup.generated.h"
+
+/* Called once the users of a lookup are known. Users which couldn't be fetched are left out */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUsersLookedUp, const TArray<FUserInfo>&, Users);
+
+/* Called once the users of a single lookup are known. Used by C++ callers which need exactly their users */
+typedef TFunction<void(const TArray<FUserInfo>&)> FGameJoltUsersCallback;
+
+/**
+ * Looks up users for many callers with as few requests as possible, e.g. for every row of a scoreboard
+ * The IDs requested within a collect window are merged, so each user is fetched once however many callers asked for it,
+ * and sent in requests of many IDs each. Fetched users are cached and answer later lookups without a request until they expire
+ * Expired users are still used if they can't be fetched again
+ */
+UCLASS(BlueprintType)
+class GAMEJOLTPLUGIN_API UGameJoltUserLookup : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/**
+	 * Creates a user lookup
+	 * @param API The instance the users are fetched with. Its events aren't triggered by the lookup
+	 * @param CollectWindow Seconds lookups are collected before the users are fetched. 0 collects until the next frame
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create User Lookup"), Category = "GameJolt|User|Lookup")
+	static UGameJoltUserLookup* CreateUserLookup(UUEGameJoltAPI* API, float CollectWindow = 0.f);
+
+	/**
+	 * Looks up users. Triggers OnUsersLookedUp once they are known, never before this returns. Cached users answer with the next flush
+	 * @return False if no IDs were passed
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Look Up Users"), Category = "GameJolt|User|Lookup")
+	bool LookUpUsers(const TArray<int32>& UserIDs);
+
+	/**
+	 * Looks up users and calls back with them, without triggering OnUsersLookedUp
+	 * The users are passed in the order of their IDs. Like with fetched users, the callback is never called before this returns
+	 */
+	void RequestUsers(const TArray<int32>& UserIDs, FGameJoltUsersCallback OnLookedUp);
+
+	/**
+	 * Gets a cached user which hasn't expired yet
+	 * @return False if the user isn't cached or expired
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, meta = (DisplayName = "Find Cached User"), Category = "GameJolt|User|Lookup")
+	bool FindUser(int32 UserID, FUserInfo& User) const;
+
+	/* Fetches the collected users and answers the lookups of cached users right away instead of at the end of the collect window */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Flush User Lookups"), Category = "GameJolt|User|Lookup")
+	void Flush();
+
+	/* Removes all users from the cache */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear User Cache"), Category = "GameJolt|User|Lookup")
+	void ClearCache();
+
+	/* Seconds lookups are collected before the users are fetched. 0 collects until the next frame */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Collect Window", ClampMin = "0"), Category = "GameJolt|User|Lookup")
+	float CollectWindow;
+
+	/* Seconds a fetched user answers lookups before it is fetched again */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Cache Lifetime", ClampMin = "0"), Category = "GameJolt|User|Lookup")
+	float CacheLifetime;
+
+	/* The maximum amount of IDs sent in a single request. Each ID takes up to 11 characters of the URL */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Users Per Request", ClampMin = "1"), Category = "GameJolt|User|Lookup")
+	int32 MaxUsersPerRequest;
+
+	/* Event which triggers when the users of a lookup started with Look Up Users are known */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|User|Lookup")
+	FOnUsersLookedUp OnUsersLookedUp;
+
+	virtual void BeginDestroy() override;
+
+private:
+
+	/* A fetched user */
+	struct FCachedUser
+	{
+		FUserInfo User;
+
+		/* FPlatformTime::Seconds() when the user was fetched */
+		double FetchTime;
+	};
+
+	/* The IDs of a single lookup and its callback */
+	struct FLookup
+	{
+		TArray<int32> UserIDs;
+
+		/* The amount of IDs which are still being fetched */
+		int32 NumPending;
+
+		FGameJoltUsersCallback OnLookedUp;
+	};
+
+	/* Ticker callback which fetches the collected users once the collect window ended */
+	bool OnCollectWindowElapsed(float DeltaTime);
+
+	/* Callback of a user fetch */
+	void OnUsersFetched(const FGameJoltRequest& GameJoltRequest, const TArray<int32>& UserIDs);
+
+	/* Hands a fetched user, or the failure to fetch it, to the lookups waiting for it */
+	void ResolveUser(int32 UserID);
+
+	/* Calls back with the users of a lookup */
+	void FinishLookup(const FLookup& Lookup) const;
+
+	/* Whether a cached user hasn't expired yet */
+	bool IsFresh(const FCachedUser& CachedUser) const;
+
+	/* Removes expired users which no lookup is waiting for */
+	void PruneUsers();
+
+	/* The instance the users are fetched with */
+	UPROPERTY()
+	UUEGameJoltAPI* API;
+
+	/* Fetched users, by ID */
+	TMap<int32, FCachedUser> Users;
+
+	/* Lookups answered by cached users, waiting for the next flush */
+	TArray<TSharedRef<FLookup>> ReadyLookups;
+
+	/* The lookups waiting for a user, by ID */
+	TMap<int32, TArray<TSharedRef<FLookup>>> Waiters;
+
+	/* IDs collected for the next fetch */
+	TSet<int32> Collected;
+
+	/* IDs of the fetches in flight */
+	TSet<int32> Fetching;
+
+	/* Handle of the ticker ending the collect window */
+	FDelegateHandle CollectTickerHandle;
+};
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Interfaces/IHttpRequest.h"
+#include "GameJoltTransport.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Dom/JsonValue.h"
@@ -30,9 +30,11 @@ enum class EGameJoltComponentEnum : uint8
 	GJ_DATASTORE_FETCH	UMETA(DisplayName = "Fetch Data"),
 	GJ_DATASTORE_SET	UMETA(DisplayName = "Set Data"),
 	GJ_DATASTORE_UPDATE	UMETA(DisplayName = "Update Data"),
-	GJ_DATASTORE_REMOVE UMETA(DisplayName = "Fetch Keys"),
+	GJ_DATASTORE_REMOVE UMETA(DisplayName = "Remove Data"),
 	GJ_OTHER			UMETA(DisplayName = "Other"),
-	GJ_TIME				UMETA(DisplayName = "Fetch Server Time")
+	GJ_TIME				UMETA(DisplayName = "Fetch Server Time"),
+	GJ_BATCH			UMETA(DisplayName = "Batch"),
+	GJ_DATASTORE_KEYS	UMETA(DisplayName = "Fetch Keys")
 };
 
 /* Represents the possible selections for "Fetch Trophies" (all, achieved, unachieved) */
@@ -73,6 +75,44 @@ enum class EDataOperation : uint8
 	prepend UMETA(DisplayName = "Prepend")
 };
 
+/* Represents the hash functions the server accepts for request signatures */
+UENUM(BlueprintType)
+enum class EGameJoltSignatureAlgorithm : uint8
+{
+	MD5 UMETA(DisplayName = "MD5"),
+	SHA1 UMETA(DisplayName = "SHA1")
+};
+
+/* Represents the groups of endpoints which share a rate limit */
+UENUM(BlueprintType)
+enum class EGameJoltEndpointClass : uint8
+{
+	Users UMETA(DisplayName = "Users"),
+	Sessions UMETA(DisplayName = "Sessions"),
+	Trophies UMETA(DisplayName = "Trophies"),
+	Scores UMETA(DisplayName = "Scores"),
+	DataStore UMETA(DisplayName = "Data-Store"),
+	Misc UMETA(DisplayName = "Misc")
+};
+
+/* Represents the order queued requests are sent in */
+UENUM(BlueprintType)
+enum class EGameJoltRequestPriority : uint8
+{
+	Critical UMETA(DisplayName = "Critical"),
+	Normal UMETA(DisplayName = "Normal"),
+	Background UMETA(DisplayName = "Background")
+};
+
+/* Represents the states of the circuit breaker of an action */
+UENUM(BlueprintType)
+enum class EGameJoltCircuitState : uint8
+{
+	Closed UMETA(DisplayName = "Closed"),
+	Open UMETA(DisplayName = "Open"),
+	HalfOpen UMETA(DisplayName = "Half-Open")
+};
+
 /* Contains all available information about a user */
 USTRUCT(BlueprintType)
 struct FUserInfo
@@ -163,6 +203,152 @@ struct FScoreTableInfo
 
 };
 
+/* Contains the counters of the response cache */
+USTRUCT(BlueprintType)
+struct FGameJoltCacheStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Requests served from a response within its time to live */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cache Hits")
+		int32 Hits;
+	/* Requests served from an expired response while it was revalidated */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cache Stale Hits")
+		int32 StaleHits;
+	/* Requests which had to go to the server */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cache Misses")
+		int32 Misses;
+	/* Responses removed because they were invalidated by a write or the cache was full */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cache Evictions")
+		int32 Evictions;
+	/* Responses currently cached */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cache Entries")
+		int32 Entries;
+
+	FGameJoltCacheStats()
+	{
+		Hits = 0;
+		StaleHits = 0;
+		Misses = 0;
+		Evictions = 0;
+		Entries = 0;
+	}
+};
+
+/* Contains the token bucket of a group of endpoints */
+USTRUCT(BlueprintType)
+struct FGameJoltRateLimit
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Requests per second the bucket refills with */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Requests Per Second", meta = (ClampMin = "0.01"))
+		float RequestsPerSecond;
+	/* Requests which can be sent at once after the bucket was idle */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Burst", meta = (ClampMin = "1"))
+		int32 Burst;
+
+	FGameJoltRateLimit()
+	{
+		RequestsPerSecond = 5.f;
+		Burst = 10;
+	}
+
+	FGameJoltRateLimit(float InRequestsPerSecond, int32 InBurst)
+	{
+		RequestsPerSecond = InRequestsPerSecond;
+		Burst = InBurst;
+	}
+};
+
+/* Contains the counters of the request scheduler */
+USTRUCT(BlueprintType)
+struct FGameJoltSchedulerStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Requests currently waiting to be sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Queue Depth")
+		int32 QueueDepth;
+	/* The most requests which were waiting at the same time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Peak Queue Depth")
+		int32 PeakQueueDepth;
+	/* Requests which have been sent by the scheduler */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dispatched")
+		int32 Dispatched;
+	/* Requests which had to wait for a token or a free slot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Delayed")
+		int32 Delayed;
+	/* Average seconds a request waited before it was sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Average Wait Time")
+		float AverageWaitTime;
+	/* The longest a request waited before it was sent, in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Max Wait Time")
+		float MaxWaitTime;
+
+	FGameJoltSchedulerStats()
+	{
+		QueueDepth = 0;
+		PeakQueueDepth = 0;
+		Dispatched = 0;
+		Delayed = 0;
+		AverageWaitTime = 0.f;
+		MaxWaitTime = 0.f;
+	}
+};
+
+/* Contains the counters of the retries and the circuit breakers */
+USTRUCT(BlueprintType)
+struct FGameJoltRetryStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Requests which have been sent again after they failed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Retries")
+		int32 Retries;
+	/* Requests currently waiting for their next attempt */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pending Retries")
+		int32 PendingRetries;
+	/* Requests which weren't sent because their circuit was open */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Failed Fast")
+		int32 FailedFast;
+	/* Circuits which are open or half-open */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Open Circuits")
+		int32 OpenCircuits;
+
+	FGameJoltRetryStats()
+	{
+		Retries = 0;
+		PendingRetries = 0;
+		FailedFast = 0;
+		OpenCircuits = 0;
+	}
+};
+
+/* Contains the counters of the write-behind data-store cache */
+USTRUCT(BlueprintType)
+struct FGameJoltDataStoreWriteStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/* Writes which were merged into a write before them instead of being sent on their own */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Merged Writes")
+		int32 Merged;
+	/* Writes which have been sent to the server */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sent Writes")
+		int32 Sent;
+	/* Writes which are held back or being sent */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pending Writes")
+		int32 Pending;
+
+	FGameJoltDataStoreWriteStats()
+	{
+		Merged = 0;
+		Sent = 0;
+		Pending = 0;
+	}
+};
+
 /* Generates a delegate for the OnGetResult event */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGetResult);
 
@@ -203,9 +389,120 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnScoreboardTableFetched, TArray<FS
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnRankFetched, int32, Rank);
 /* Fetch Time */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTimeFetched, struct FDateTime, ServerTime);
+/* Fetch Data Keys */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDataKeysFetched, const TArray<FString>&, Keys);
+/* Circuit Breaker */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCircuitStateChanged, EGameJoltComponentEnum, Action, EGameJoltCircuitState, State);
 
 #pragma endregion
 
+struct FGameJoltRequest;
+class FGameJoltWriteJournal;
+class FGameJoltResponseCache;
+class FGameJoltRequestSigner;
+class FGameJoltSessionHeartbeat;
+class FGameJoltRequestScheduler;
+class FGameJoltCircuitBreaker;
+class FGameJoltLocalLeaderboard;
+class FGameJoltScoreSubmitter;
+class FGameJoltDataStoreCache;
+struct FGameJoltDataWrite;
+
+/* Called once a single request completed. Used by C++ callers which need the result of exactly their request */
+typedef TFunction<void(const FGameJoltRequest&)> FGameJoltRequestCallback;
+
+/**
+ * Context of a single request, carried from SendRequest to OnReady
+ * Every request owns its action, its parsed response and its completion callback,
+ * so any number of requests can be in flight on the same UUEGameJoltAPI instance
+ */
+struct GAMEJOLTPLUGIN_API FGameJoltRequest
+{
+	/* Id of the request, unique per UUEGameJoltAPI instance */
+	uint32 Id;
+
+	/* The action performed by this request. Selects the delegate to broadcast */
+	EGameJoltComponentEnum Action;
+
+	/* The endpoint with its query, e.g. "/scores/?limit=10". Without game_id, user info and signature */
+	FString Endpoint;
+
+	/* The content posted with the request */
+	FString Body;
+
+	/* Whether username and user_token are appended to the endpoint */
+	bool bAppendUserInfo;
+
+	/* The parsed response. Invalid until the request completed */
+	TSharedPtr<FJsonObject> Data;
+
+	/* The "response" object within Data. Invalid if the response couldn't be parsed */
+	TSharedPtr<FJsonObject> Response;
+
+	/* Whether the server could be reached and reported success */
+	bool bSucceeded;
+
+	/* Called after the delegates have been broadcast */
+	FGameJoltRequestCallback OnComplete;
+
+	/* Key of the request's entry in the write journal. Empty if the request isn't journaled */
+	FString JournalKey;
+
+	/* Key of the request's response in the response cache. Empty if the response isn't cached */
+	FString CacheKey;
+
+	/* Whether the response was served from the response cache */
+	bool bFromCache;
+
+	/* Whether no delegates are broadcast for the request, e.g. when it only revalidates a cached response */
+	bool bSilent;
+
+	/* Whether the request only revalidates a stale cached response. It never falls back to the cached response itself */
+	bool bRevalidation;
+
+	/* Whether the request is always sent on its own, never collected into a batch or journaled */
+	bool bDirect;
+
+	/* Whether the response was streamed into Scores or Users. Data is not set then */
+	bool bStreamed;
+
+	/* The scores of a streamed scoreboard response */
+	TArray<FScoreInfo> Scores;
+
+	/* The users of a streamed user response */
+	TArray<FUserInfo> Users;
+
+	/* How often the request has been sent again after it failed */
+	int32 RetryCount;
+
+	/* Size of the received content in bytes. 0 until the request completed, and for sub-requests of a batch */
+	int32 ResponseSize;
+
+	/* The requests sent within this one. Only used by batch requests */
+	TArray<TSharedRef<FGameJoltRequest>> SubRequests;
+
+	/* Key identical reads in flight are merged on. Empty if the request doesn't take part in merging */
+	FString MergeKey;
+
+	/* Identical reads started while this one was in flight. They finish with its response */
+	TArray<TSharedRef<FGameJoltRequest>> MergedRequests;
+
+	FGameJoltRequest()
+		: Id(0)
+		, Action(EGameJoltComponentEnum::GJ_OTHER)
+		, bAppendUserInfo(true)
+		, bSucceeded(false)
+		, bFromCache(false)
+		, bSilent(false)
+		, bRevalidation(false)
+		, bDirect(false)
+		, bStreamed(false)
+		, RetryCount(0)
+		, ResponseSize(0)
+	{
+	}
+};
+
 /**
  * Class to use the GameJoltAPI
  * Is also internally used by an UUEGameJoltAPI instance as a carrier for response data
@@ -218,18 +515,254 @@ class GAMEJOLTPLUGIN_API UUEGameJoltAPI : public UObject
 private:
 
 	/**
-	* Callback for IHttpRequest::OnProcessRequestComplete()
-	* @param Request HTTP request pointer
-	* @param Response Response pointer
-	* @param bWasSuccessful Whether the request was successful or not
+	* Called by the transport once a request completed
+	* @param bWasSuccessful Whether a response was received at all
+	* @param ResponseCode The HTTP status of the response
+	* @param ResponseContent The content of the response, UTF-8 encoded
+	* @param GameJoltRequest The context of the completed request
 	*/
-	void OnReady(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-	
+	void OnReady(bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& ResponseContent, TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Broadcasts the delegates matching the action of a completed request */
+	void DispatchResponse(const FGameJoltRequest& GameJoltRequest);
+
+	/* Checks the response of a request, broadcasts its delegates and calls its callback */
+	void FinishRequest(FGameJoltRequest& GameJoltRequest);
+
+	/* Adds the request to the collected batch or processes it right away */
+	void SubmitRequest(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Hands the request over to the scheduler, or sends it right away if requests aren't throttled */
+	void ProcessRequest(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Signs the request and hands it over to the transport */
+	void SendToTransport(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Sends the requests. The HTTP module unless another transport was set */
+	TSharedPtr<IGameJoltTransport, ESPMode::ThreadSafe> Transport;
+
+	/* Gets the priority of a request. A batch gets the highest priority of its sub-requests */
+	EGameJoltRequestPriority GetRequestPriority(const FGameJoltRequest& GameJoltRequest) const;
+
+	/* Gets the request scheduler, configured with the current limits */
+	FGameJoltRequestScheduler& GetRequestScheduler();
+
+	/* Sends the queued requests which may go out now and schedules the next attempt */
+	void PumpScheduler();
+
+	/* Ticker callback which sends the queued requests once tokens refilled */
+	bool OnSchedulerTick(float DeltaTime);
+
+	/* Queues requests per priority and meters them out per endpoint class */
+	TSharedPtr<FGameJoltRequestScheduler> RequestScheduler;
+
+	/* Handle of the ticker sending the queued requests */
+	FDelegateHandle SchedulerTickerHandle;
+
+	/**
+	 * Builds the signed URL of a request
+	 * @param bAsSubRequest Whether the URL is sent within a batch. Sub-requests are signed without the server
+	 */
+	FString BuildRequestUrl(const FGameJoltRequest& GameJoltRequest, bool bAsSubRequest);
+
+	/* Gets the request signer, configured with the current settings */
+	FGameJoltRequestSigner& GetRequestSigner();
+
+	/* Appends game_id, the user info and signatures. Caches everything constant across requests */
+	TSharedPtr<FGameJoltRequestSigner> RequestSigner;
+
+	/* Splits the response of a batch request into the responses of its sub-requests */
+	void RouteBatchResponse(FGameJoltRequest& BatchRequest);
+
+	/* Ticker callback which sends the collected batch */
+	bool OnBatchWindowElapsed(float DeltaTime);
+
+	/* Requests collected for the next batch */
+	TArray<TSharedRef<FGameJoltRequest>> PendingBatch;
+
+	/* Handle of the ticker sending the collected batch */
+	FDelegateHandle BatchTickerHandle;
+
+	/* Gets the write journal, loading it on first use */
+	FGameJoltWriteJournal& GetWriteJournal();
+
+	/**
+	 * Acknowledges a journaled write the server answered, or keeps it for the next replay
+	 * @return Whether the request is finished. False if it will be replayed
+	 */
+	bool OnJournaledRequestFinished(FGameJoltRequest& GameJoltRequest);
+
+	/* Ticker callback which retries the queued writes */
+	bool OnReplayIntervalElapsed(float DeltaTime);
+
+	/* Writes which haven't been acknowledged by the server yet */
+	TSharedPtr<FGameJoltWriteJournal> WriteJournal;
+
+	/* Contexts of the journaled writes of this session, by journal key */
+	TMap<FString, TSharedRef<FGameJoltRequest>> JournaledRequests;
+
+	/* Key of the write currently replayed. Writes are replayed one after another to keep their order */
+	FString ReplayingWriteKey;
+
+	/* Handle of the ticker retrying the queued writes */
+	FDelegateHandle ReplayTickerHandle;
+
+	/* Gets the response cache, creating it on first use */
+	FGameJoltResponseCache& GetResponseCache();
+
+	/**
+	 * Answers a read request from the response cache and revalidates stale responses
+	 * @return Whether the request was answered from the cache
+	 */
+	bool TryServeFromCache(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Removes the cached responses a successful write made outdated */
+	void InvalidateCachedResponses(const FGameJoltRequest& GameJoltRequest);
+
+	/* Finishes a request which is answered without the server on the next tick */
+	void FinishDeferred(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Ticker callback which finishes the deferred requests */
+	bool OnDeferredRequestsTick(float DeltaTime);
+
+	/* Responses of read requests */
+	TSharedPtr<FGameJoltResponseCache> ResponseCache;
+
+	/* Requests answered without the server, finished on the next tick */
+	TArray<TSharedRef<FGameJoltRequest>> DeferredRequests;
+
+	/* Handle of the ticker finishing the deferred requests */
+	FDelegateHandle DeferredTickerHandle;
+
+	/* Ticker callback which derives the session status from input and window focus */
+	bool OnSessionStatusTick(float DeltaTime);
+
+	/* Gets the local scoreboards, creating them on first use */
+	FGameJoltLocalLeaderboard& GetLocalLeaderboard();
+
+	/* Top scores of every scoreboard kept on disk */
+	TSharedPtr<FGameJoltLocalLeaderboard> LocalLeaderboard;
+
+	/* Gets the score submitter, creating it on first use */
+	FGameJoltScoreSubmitter& GetScoreSubmitter();
+
+	/**
+	 * Sends a score to the server
+	 * With smart submission, the score becomes the personal best of its player until the server rejects it
+	 */
+	bool SendScore(const FString& UserScore, int32 UserScore_Sort, const FString& GuestUser, const FString& extra_data, int32 table_id);
+
+	/* Ticker callback which sends the best score of every burst once the submission window ended */
+	bool OnScoreSubmitWindowElapsed(float DeltaTime);
+
+	/* Personal bests and the scores held back by smart submission */
+	TSharedPtr<FGameJoltScoreSubmitter> ScoreSubmitter;
+
+	/* Handle of the ticker ending the submission window */
+	FDelegateHandle ScoreSubmitTickerHandle;
+
+	/* Gets the write-behind data-store cache, creating it on first use */
+	FGameJoltDataStoreCache& GetDataStoreCache();
+
+	/* Sends a data-store write to the server */
+	TSharedPtr<FGameJoltRequest> SendDataWrite(EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write, FGameJoltRequestCallback OnComplete = nullptr);
+
+	/* Sends a data-store write right away, or holds it back in the write-behind cache */
+	void WriteData(EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write);
+
+	/* Sends the next held write of a key once the one before it completed */
+	void SendNextHeldDataWrite(const FString& EntryKey);
+
+	/* Ticker callback which sends the held data-store writes */
+	bool OnDataStoreFlushIntervalElapsed(float DeltaTime);
+
+	/* Data-store writes held back and merged per key */
+	TSharedPtr<FGameJoltDataStoreCache> DataStoreCache;
+
+	/* Handle of the ticker sending the held data-store writes */
+	FDelegateHandle DataStoreFlushTickerHandle;
+
+	/* Called on the game thread once a ping of the heartbeat completed */
+	void OnHeartbeatPinged(bool bReachedServer, bool bSucceeded);
+
+	/* Closes the session of the running heartbeat before the engine exits */
+	void OnPreExit();
+
+	/* Copies the current request settings to the heartbeat thread */
+	void UpdateHeartbeatSettings();
+
+	/**
+	 * Stops the heartbeat thread and closes its session without any callbacks
+	 * @param bFlush Whether to wait for the close request to be sent
+	 */
+	void ShutdownSessionHeartbeat(bool bFlush);
+
+	/* Pings the open session from its own thread */
+	TSharedPtr<FGameJoltSessionHeartbeat> SessionHeartbeat;
+
+	/* Handle of the ticker updating the session status */
+	FDelegateHandle SessionStatusTickerHandle;
+
+	/* Handle of the FCoreDelegates::OnPreExit binding */
+	FDelegateHandle PreExitHandle;
+
+	/**
+	 * Attaches a read to an identical one in flight, so both share a single call
+	 * @return Whether the request was attached. False if it has to be sent
+	 */
+	bool TryMergeInFlight(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Finishes the reads merged into a completed request with its response */
+	void FinishMergedRequests(FGameJoltRequest& GameJoltRequest);
+
+	/* Reads in flight other reads can be merged into, by merge key */
+	TMap<FString, TSharedRef<FGameJoltRequest>> InFlightReads;
+
+	/* Whether the request may be sent again after it failed */
+	bool ShouldRetry(const FGameJoltRequest& GameJoltRequest);
+
+	/* Sends a failed request again after a capped exponential backoff with jitter */
+	void ScheduleRetry(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Ticker callback which sends a request again */
+	bool OnRetryElapsed(float DeltaTime, TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Gets the circuit breaker, configured with the current settings */
+	FGameJoltCircuitBreaker& GetCircuitBreaker();
+
+	/* Whether the circuit of the request lets it through. Broadcasts the change if it lets a probe through */
+	bool AllowByCircuit(const FGameJoltRequest& GameJoltRequest);
+
+	/* Updates the circuits of a request (or of the sub-requests of a batch) with whether the server answered */
+	void RecordCircuitOutcome(const FGameJoltRequest& GameJoltRequest, bool bReachedServer);
+
+	/* Finishes a request whose circuit is open, with its last cached response if there is one */
+	void FailFast(TSharedRef<FGameJoltRequest> GameJoltRequest);
+
+	/* Opens the circuits of actions which keep failing */
+	TSharedPtr<FGameJoltCircuitBreaker> CircuitBreaker;
+
+	/* Handles of the tickers sending failed requests again, by request id */
+	TMap<uint32, FDelegateHandle> RetryTickerHandles;
+
+	/* Requests which have been sent again */
+	int32 NumRetries;
+
+	/* Requests which failed fast */
+	int32 NumFailedFast;
+
+	/* Requests which have been sent but not answered yet, by id */
+	TMap<uint32, TSharedRef<FGameJoltRequest>> PendingRequests;
+
+	/* The id given to the next request */
+	uint32 NextRequestId;
+
+	/* Gets the "response" object of the response which completed last. Invalid if there is none */
+	TSharedPtr<FJsonObject> GetResponseField() const;
+
 	/* Reset Data*/
 	void Reset();
 
-	void WriteObject(TSharedRef<TJsonWriter<TCHAR>> writer, FString key, FJsonValue* value);
-
 public:
 
 	UObject* contextObject;
@@ -241,6 +774,8 @@ public:
 	/* Allows usage of the World-Property */
 	virtual class UWorld* GetWorld() const override;
 
+	virtual void BeginDestroy() override;
+
 	/* The username of the guest profile */
 	UPROPERTY(BlueprintReadWrite, Category = "GameJolt|User")
 	FString Guest_username;
@@ -249,11 +784,15 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "GameJolt|User")
 	bool bIsLoggedIn;
 
-	/* An enum representing the last request send. Local 'Get' nodes don't count */
+	/**
+	 * An enum representing the last request send. Local 'Get' nodes don't count
+	 * Only informative: every request keeps its own action, so it is not used to dispatch responses
+	 * It is still used as the action of requests started with "Send Request"
+	 */
 	UPROPERTY(BlueprintReadWrite, Category = "GameJolt")
 	EGameJoltComponentEnum LastActionPerformed;
 
-	/* The actual field data */
+	/* The actual field data. Holds the response of the request that completed last */
 	TSharedPtr<FJsonObject> Data;
 
 	/* Contains the actual page content, as a string */
@@ -318,6 +857,13 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Events|Specific")
 	FOnTimeFetched OnTimeFetched;
 
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Events|Specific")
+	FOnDataKeysFetched OnDataKeysFetched;
+
+	/* Event which triggers when the circuit breaker of an action opens, lets a probe through or closes */
+	UPROPERTY(BlueprintAssignable, Category = "GameJolt|Events|Specific")
+	FOnCircuitStateChanged OnCircuitStateChanged;
+
 #pragma endregion
 
 	/* Creates new data from the input string */
@@ -360,6 +906,176 @@ public:
 
 	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "GameJolt API Version"), Category = "GameJolt|Request")
 	FString GJAPI_VERSION;
+
+	/* The hash function used to sign requests */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Signature Algorithm"), Category = "GameJolt|Request")
+	EGameJoltSignatureAlgorithm SignatureAlgorithm;
+
+	/* Whether requests are collected and sent together as a single /batch/ request */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Batch Requests"), Category = "GameJolt|Request|Batch")
+	bool bBatchRequests;
+
+	/* Seconds to collect requests before the batch is sent. 0 sends all requests of the current frame */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Batch Window", ClampMin = "0.0"), Category = "GameJolt|Request|Batch")
+	float BatchWindow;
+
+	/* Whether the server may process the sub-requests of a batch in parallel */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Batch In Parallel"), Category = "GameJolt|Request|Batch")
+	bool bBatchParallel;
+
+	/* Whether the server stops processing a batch at the first failing sub-request */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Batch Break On Error"), Category = "GameJolt|Request|Batch")
+	bool bBatchBreakOnError;
+
+	/**
+	 * Whether scores, trophies and data-store writes are journaled in the Saved directory until the server answered them
+	 * Writes which couldn't be sent are replayed in order once the server can be reached again, also in later sessions
+	 * Replays are at least once, the server can't recognize a write it got before. Data-store updates which may have reached it are dropped instead
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Queue Offline Writes"), Category = "GameJolt|Request|Offline")
+	bool bQueueOfflineWrites;
+
+	/* The maximum amount of queued writes. The oldest ones are dropped beyond that */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Queued Writes", ClampMin = "1"), Category = "GameJolt|Request|Offline")
+	int32 MaxQueuedWrites;
+
+	/* Seconds between two attempts to replay the queued writes while the server can't be reached */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Offline Replay Interval", ClampMin = "1.0"), Category = "GameJolt|Request|Offline")
+	float OfflineReplayInterval;
+
+	/**
+	 * Whether scoreboards and user lists are decoded token by token while they are read, without building a JSON object or keeping the content
+	 * Lowers the peak memory of large responses. The 'Get' nodes don't see streamed responses, use the parameters of the events instead
+	 * Responses which are cached or part of a batch are never streamed
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Stream Large Responses"), Category = "GameJolt|Request")
+	bool bStreamLargeResponses;
+
+	/**
+	 * Whether requests are metered out per endpoint class and sent in the order of their priority
+	 * Critical requests (e.g. login, scores) go ahead of background ones (e.g. friend polling, data-store updates)
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Throttle Requests"), Category = "GameJolt|Request|Throttling")
+	bool bThrottleRequests;
+
+	/* The token bucket of every endpoint class. Classes without an entry aren't limited */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Rate Limits"), Category = "GameJolt|Request|Throttling")
+	TMap<EGameJoltEndpointClass, FGameJoltRateLimit> RateLimits;
+
+	/* The priority of every action. Actions without an entry are normal */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Request Priorities"), Category = "GameJolt|Request|Throttling")
+	TMap<EGameJoltComponentEnum, EGameJoltRequestPriority> RequestPriorities;
+
+	/* The maximum amount of requests in flight at the same time. 0 means unlimited */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Concurrent Requests", ClampMin = "0"), Category = "GameJolt|Request|Throttling")
+	int32 MaxConcurrentRequests;
+
+	/**
+	 * Whether reads which couldn't reach the server (no response, 5xx or 429) are sent again automatically
+	 * Writes aren't retried, use "Queue Offline Writes" for them
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Retry Failed Requests"), Category = "GameJolt|Request|Retry")
+	bool bRetryFailedRequests;
+
+	/* The maximum amount of retries per request */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Retries", ClampMin = "0"), Category = "GameJolt|Request|Retry")
+	int32 MaxRetries;
+
+	/* Seconds before the first retry. Doubles with every further retry */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Retry Base Delay", ClampMin = "0.0"), Category = "GameJolt|Request|Retry")
+	float RetryBaseDelay;
+
+	/* The longest delay before a retry, in seconds. Every delay is shortened by a random jitter of up to half */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Retry Max Delay", ClampMin = "0.0"), Category = "GameJolt|Request|Retry")
+	float RetryMaxDelay;
+
+	/**
+	 * Failed requests of an action in a row after which its circuit opens. 0 disables the circuit breaker
+	 * Requests of an open circuit aren't sent. They are answered with their last cached response if there is one, or fail right away
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Circuit Breaker Threshold", ClampMin = "0"), Category = "GameJolt|Request|Retry")
+	int32 CircuitBreakerThreshold;
+
+	/* Seconds an open circuit fails fast before a single probe request is let through */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Circuit Breaker Cooldown", ClampMin = "0.0"), Category = "GameJolt|Request|Retry")
+	float CircuitBreakerCooldown;
+
+	/**
+	 * Whether a read identical to one in flight (same endpoint, parameters and user) shares its call instead of sending its own
+	 * Every caller still gets its own events and callback
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Merge Identical Requests"), Category = "GameJolt|Request")
+	bool bMergeIdenticalRequests;
+
+	/**
+	 * Whether responses of read requests (scoreboards, tables, trophies, users and server time) are cached in memory
+	 * Writes invalidate the responses they make outdated, e.g. adding a score invalidates the scoreboards of its table
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Cache Responses"), Category = "GameJolt|Request|Cache")
+	bool bCacheResponses;
+
+	/* Seconds a response is served from the cache, per action. Actions without an entry (or 0) aren't cached */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Cache Time To Live"), Category = "GameJolt|Request|Cache")
+	TMap<EGameJoltComponentEnum, float> CacheTimeToLive;
+
+	/* Seconds after the time to live an expired response is still served, while it is fetched again in the background */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Cache Stale Window", ClampMin = "0.0"), Category = "GameJolt|Request|Cache")
+	float CacheStaleWindow;
+
+	/* The maximum amount of cached responses. The least recently used ones are evicted beyond that */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Cached Responses", ClampMin = "1"), Category = "GameJolt|Request|Cache")
+	int32 MaxCachedResponses;
+
+	/* Seconds between two pings of the session heartbeat. GameJolt closes sessions which weren't pinged for 120 seconds */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Session Ping Interval", ClampMin = "1.0", ClampMax = "110.0"), Category = "GameJolt|Sessions")
+	float SessionPingInterval;
+
+	/* Whether the session heartbeat switches between active and idle on its own, based on user input and window focus */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Auto Session Status"), Category = "GameJolt|Sessions")
+	bool bAutoSessionStatus;
+
+	/* Seconds without user input after which the session becomes idle. Losing the window focus makes it idle right away */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Session Idle Timeout", ClampMin = "0.0"), Category = "GameJolt|Sessions")
+	float SessionIdleTimeout;
+
+	/**
+	 * Whether the top scores of every scoreboard are kept on disk, for offline and guest play
+	 * Added scores are recorded right away, fetched scoreboards are merged in
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Keep Local Scoreboards"), Category = "GameJolt|Scoreboard|Local")
+	bool bKeepLocalScoreboards;
+
+	/* The amount of best scores kept on disk per scoreboard */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Max Local Scores", ClampMin = "1"), Category = "GameJolt|Scoreboard|Local")
+	int32 MaxLocalScores;
+
+	/**
+	 * Whether added scores are only sent if they beat the personal best of their player on the table
+	 * Personal bests are learned from the sent scores and the fetched scoreboards during the session
+	 * Add Score still succeeds for scores which aren't sent, but only sent scores trigger the score added event
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Smart Submit Scores"), Category = "GameJolt|Scoreboard|Smart Submit")
+	bool bSmartSubmitScores;
+
+	/* Seconds scores are held back after the first one of a burst. Only the best one per player and table is sent. 0 sends right away */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Score Submit Window", ClampMin = "0.0"), Category = "GameJolt|Scoreboard|Smart Submit")
+	float ScoreSubmitWindow;
+
+	/* The scoreboards whose better scores have lower sort values, e.g. times. 0 for the primary one. All others count higher values as better */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Ascending Score Tables"), Category = "GameJolt|Scoreboard|Smart Submit")
+	TArray<int32> AscendingScoreTables;
+
+	/**
+	 * Whether data-store writes are held back and merged per key before they are sent
+	 * Adds and subtracts are summed, multiplies and divides folded, appends and prepends concatenated and only the last set is kept
+	 * Fetching a key with held writes returns the data after them
+	 */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Write Behind Data-Store"), Category = "GameJolt|Data-Store|Write Behind")
+	bool bWriteBehindDataStore;
+
+	/* Seconds data-store writes are held back after the first one, before all held writes are sent */
+	UPROPERTY(BlueprintReadWrite, meta = (DisplayName = "Data-Store Flush Interval", ClampMin = "0.0"), Category = "GameJolt|Data-Store|Write Behind")
+	float DataStoreFlushInterval;
 	/* End of Properties */
 
 	/* Public Functions */
@@ -379,11 +1095,12 @@ private:
 
 	void AutoLogin(const FString Username, const FString Token);
 
+public:
 
 #pragma region Session
 
 	/**
-	 * Opens a session. You'll have to ping it manually with a timer
+	 * Opens a session. You'll have to ping it manually with a timer, or use "Start Session Heartbeat" instead
 	 * @return True if the request succeded, false if not
 	 **/
 	UFUNCTION(BlueprintCallable, meta = (DislayName = "Open Session"), Category = "GameJolt|Sessions")
@@ -418,6 +1135,33 @@ private:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Session Status"), Category = "GameJolt|Sessions")
 	bool GetSessionStatus();
 
+	/**
+	 * Opens a session and pings it from its own thread until it is stopped
+	 * The pings don't depend on the game thread, so they keep going during level loads and long frames
+	 * The session is closed on its own when the engine exits
+	 * @return Whether the request opening the session could be send
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Start Session Heartbeat"), Category = "GameJolt|Sessions")
+	bool StartSessionHeartbeat();
+
+	/**
+	 * Stops the pings of the session heartbeat
+	 * @param bCloseSession Whether to close the session as well
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Stop Session Heartbeat"), Category = "GameJolt|Sessions")
+	void StopSessionHeartbeat(bool bCloseSession = true);
+
+	/**
+	 * Sets the status sent with the pings of the session heartbeat
+	 * Overwritten on the next update if "Auto Session Status" is set
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Session Heartbeat Status"), Category = "GameJolt|Sessions")
+	void SetSessionHeartbeatStatus(ESessionStatus SessionStatus);
+
+	/* Whether the session heartbeat is running */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Is Session Heartbeat Running"), Category = "GameJolt|Sessions")
+	bool IsSessionHeartbeatRunning() const;
+
 #pragma endregion
 
 	/**
@@ -578,6 +1322,20 @@ private:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Score to Scoreboard"), Category = "GameJolt|Scoreboard")
 	bool AddScore(const FString UserScore, const int32 UserScore_Sort, const FString GuestUser, const FString extra_data, const int32 table_id);
 
+	/**
+	 * Gets the best scores kept on disk, without waiting for the network
+	 * Contains the added scores and the fetched scoreboards, including scores the server hasn't received yet
+	 * @param Table_id The ID of the score table. 0 for the primary one
+	 * @param ScoreLimit The maximum amount of scores. 0 for all kept scores
+	 * @return An array of FScoreInfo structs sorted from best to worst. Empty if local scoreboards aren't kept
+	**/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Local Scoreboard"), Category = "GameJolt|Scoreboard|Local")
+	TArray<FScoreInfo> GetLocalScoreboard(const int32 Table_id, const int32 ScoreLimit);
+
+	/* Sends the scores held back by smart submission right away, e.g. at the end of a run */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Flush Score Submissions"), Category = "GameJolt|Scoreboard|Smart Submit")
+	void FlushScoreSubmissions();
+
 	/**
 	 * Returns a list of high score tables for a game.
 	 * @return True if it the request succeded and false if it failed
@@ -617,6 +1375,8 @@ private:
 
 #pragma region Data-Store
 
+public:
+
 	/**
 	 * Either posts data for a new key or changes data for an existing one.
 	 * @param Type Whether to store the key/value pair for all users (global) or for the current user (user)
@@ -652,6 +1412,22 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void RemoveData(EDataStore Type, const FString Key);
 
+	/**
+	 * Fetches the keys of the data-store
+	 * @param Type Whether to fetch the global keys or the keys stored for the current user
+	 * @param Pattern Only fetch keys matching this pattern, where * matches any text. Leave blank to fetch all keys
+	 * @return True if the request could be send, false if not
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Fetch Data Keys"), Category = "GameJolt|Data-Store")
+	bool FetchDataKeys(EDataStore Type, const FString Pattern);
+
+	/**
+	 * Gets the keys fetched with FetchDataKeys
+	 * @return The keys
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Data Keys"), Category = "GameJolt|Data-Store")
+	TArray<FString> GetDataKeys();
+
 	/**
 	 * Gets the fetched data and converts them to a string or an integer (if possible)
 	 * @param Success Whether the data was found
@@ -661,6 +1437,19 @@ private:
 	UFUNCTION(BlueprintCallable)
 	void GetData(bool& Success, FString& DataAsString, int32& DataAsInt);
 
+	/* Sends the data-store writes held back by the write-behind cache right away */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Flush Data-Store Writes"), Category = "GameJolt|Data-Store|Write Behind")
+	void FlushDataStoreWrites();
+
+	/**
+	 * Gets the merge and flush counters of the write-behind data-store cache
+	 * @return The counters of the write-behind cache
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Data-Store Write Stats"), Category = "GameJolt|Data-Store|Write Behind")
+	FGameJoltDataStoreWriteStats GetDataStoreWriteStats() const;
+
+private:
+
 #pragma endregion
 
 #pragma region Utility
@@ -669,7 +1458,98 @@ private:
 	UFUNCTION(Blueprintcallable, meta = (Displayname = " Send Request"), Category = "GameJolt|Request|Advanced")
 	bool SendRequest(const FString& output, FString url, bool bAppendUserInfo = true);
 
+public:
+
+	/**
+	 * Sends a request with its own context
+	 * The response is dispatched on the passed action, independent of other requests in flight
+	 * @param Action The action performed by the request
+	 * @param Endpoint The endpoint with its query, e.g. "/scores/?limit=10"
+	 * @param bAppendUserInfo Whether to append username and user_token
+	 * @param OnComplete Called once this request completed
+	 * @param Body The content to post
+	 * @param bSilent Whether no delegates are broadcast for the request, only OnComplete is called
+	 * @param bDirect Whether the request is sent on its own, bypassing batching and the offline journal. For large writes whose caller handles failures
+	 * @return The context of the request. Invalid if it couldn't be sent
+	 */
+	TSharedPtr<FGameJoltRequest> StartRequest(EGameJoltComponentEnum Action, const FString& Endpoint, bool bAppendUserInfo = true, FGameJoltRequestCallback OnComplete = nullptr, const FString& Body = FString(), bool bSilent = false, bool bDirect = false);
+
+	/**
+	 * Sets the transport requests are sent with, e.g. a FGameJoltFakeServer to run without network access
+	 * Requests in flight still complete through the transport they were sent with
+	 * @param InTransport The transport to use. Null to go back to the HTTP module
+	 */
+	void SetTransport(TSharedPtr<IGameJoltTransport, ESPMode::ThreadSafe> InTransport);
+
+	/* Gets the transport requests are sent with */
+	TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> GetTransport();
+
+	/**
+	 * Sends all requests collected for the next batch right away
+	 * They are split across several batches if their URLs don't fit into one. Does nothing if no requests were collected
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Flush Batch"), Category = "GameJolt|Request|Batch")
+	void FlushBatch();
+
+	/**
+	 * Sends the queued writes in the order they were made
+	 * Is called automatically once the server can be reached again
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Replay Queued Writes"), Category = "GameJolt|Request|Offline")
+	void ReplayQueuedWrites();
+
+	/**
+	 * Gets the amount of writes which haven't been acknowledged by the server yet
+	 * @return The amount of queued writes
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Queued Write Count"), Category = "GameJolt|Request|Offline")
+	int32 GetQueuedWriteCount();
+
+	/**
+	 * Gets the hit, miss and eviction counters of the response cache
+	 * @return The counters of the response cache
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Cache Stats"), Category = "GameJolt|Request|Cache")
+	FGameJoltCacheStats GetCacheStats();
+
+	/* Removes all cached responses */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Response Cache"), Category = "GameJolt|Request|Cache")
+	void ClearResponseCache();
+
+	/**
+	 * Gets the state of the circuit breaker of an action
+	 * @param Action The action to check
+	 * @return Closed if requests are sent normally
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Circuit State"), Category = "GameJolt|Request|Retry")
+	EGameJoltCircuitState GetCircuitState(EGameJoltComponentEnum Action) const;
+
+	/**
+	 * Gets the retry and circuit breaker counters
+	 * @return The counters of the retries and the circuit breakers
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Retry Stats"), Category = "GameJolt|Request|Retry")
+	FGameJoltRetryStats GetRetryStats() const;
+
+	/**
+	 * Gets the queue depth and wait time counters of the request scheduler
+	 * @return The counters of the request scheduler
+	 */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Scheduler Stats"), Category = "GameJolt|Request|Throttling")
+	FGameJoltSchedulerStats GetSchedulerStats() const;
+
+	/**
+	 * Gets the amount of requests which have been sent but not answered yet
+	 * Requests collected for the next batch, queued by the scheduler or waiting for a retry are included, a batch in flight counts as one
+	 * @return The amount of requests in flight
+	 */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Pending Request Count"), Category = "GameJolt|Request|Advanced")
+	int32 GetPendingRequestCount() const;
+
+private:
+
 	/** Gets nested post data from the object with the specified key
+	 * Compatibility accessor: creates a new UUEGameJoltAPI object per call. The typed 'Get' functions don't rely on it
 	 * @param key The key of the post data value
 	 * @return The value as an UUEGameJoltAPI object reference / pointer
 	*/
@@ -706,6 +1586,7 @@ private:
 
 	/**
 	 * Gets an array fromt the post data
+	 * Compatibility accessor: creates a new UUEGameJoltAPI object per entry. The typed 'Get' functions don't rely on it
 	 * @param key The key of the array
 	 * @return The array assigned to the key
 	 **/
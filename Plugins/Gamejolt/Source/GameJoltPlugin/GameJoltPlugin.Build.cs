@@ -22,6 +22,7 @@ namespace UnrealBuildTool.Rules
                     "CoreUObject",
                     "Engine",
                     "Json",
+                    "SlateCore",
 				}
 				);
 
@@ -33,6 +34,11 @@ namespace UnrealBuildTool.Rules
                     "CoreUObject",
                     "HTTP",
                     "JSON",
+                    "Slate",
+                    "SlateCore",
+                    "ApplicationCore",
+                    "TraceLog",
+                    "ImageWrapper",
 				}
 				);
 		}
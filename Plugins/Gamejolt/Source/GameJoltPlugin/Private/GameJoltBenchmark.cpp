@@ -0,0 +1,426 @@
+#include "GameJoltBenchmark.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "GameJoltPluginModule.h"
+#include "GameJoltFakeServer.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+#include "GameJoltStreamDecoder.h"
+#include "UEGameJoltAPI.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "UObject/UObjectArray.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/* Game id and private key the fake server of the benchmark is set up with */
+#define GJAPI_BENCHMARK_GAME_ID 1
+#define GJAPI_BENCHMARK_PRIVATE_KEY TEXT("benchmark")
+
+/* The amounts of requests kept in flight by the throughput runs */
+static const int32 BenchmarkConcurrencies[] = { 1, 16, 256 };
+
+/* The amounts of scoreboard entries parsed */
+static const int32 BenchmarkParseSizes[] = { 10, 100, 1000 };
+
+/**
+ * Counts the UObjects the client creates while it is registered
+ * Only objects of the plugin's classes, like the field objects of GetObject, and objects within the measured API instance count.
+ * The engine creates objects of its own meanwhile, e.g. on loading threads, which have nothing to do with the requests
+ */
+class FGameJoltObjectCounter : public FUObjectArray::FUObjectCreateListener
+{
+public:
+
+	explicit FGameJoltObjectCounter(const UObject* InAPI)
+		: API(InAPI)
+		, PluginPackage(UUEGameJoltAPI::StaticClass()->GetOutermost())
+		, bRegistered(true)
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+	}
+
+	virtual ~FGameJoltObjectCounter()
+	{
+		OnUObjectArrayShutdown();
+	}
+
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override
+	{
+		// Class and outer are set before an object is added to the array
+		if(Object->GetOuter() == API || Object->GetClass()->GetOutermost() == PluginPackage)
+			NumCreated.Increment();
+	}
+
+	virtual void OnUObjectArrayShutdown() override
+	{
+		if(bRegistered)
+			GUObjectArray.RemoveUObjectCreateListener(this);
+		bRegistered = false;
+	}
+
+	/* UObjects may be created on loading threads as well */
+	FThreadSafeCounter NumCreated;
+
+private:
+
+	const UObject* API;
+	const UPackage* PluginPackage;
+	bool bRegistered;
+};
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+/* Project LLM tag the parsers are measured under */
+static const ELLMTag BenchmarkParseTag = static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + 42);
+#endif
+
+/**
+ * Calls a function under the benchmark's LLM tag and gets the bytes tagged once it calls back, while its buffers are still alive
+ * Only the calling thread's allocations carry the tag. -1 unless LLM was turned on with -llm
+ */
+template<typename FunctionType>
+static int64 MeasureTaggedBytes(FunctionType Function)
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	if(!FLowLevelMemTracker::IsEnabled())
+		return -1;
+
+	static bool bTagRegistered = false;
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+	if(!bTagRegistered)
+	{
+		Tracker.RegisterProjectTag(static_cast<int32>(BenchmarkParseTag), TEXT("GameJoltBenchmarkParse"), NAME_None, NAME_None);
+		bTagRegistered = true;
+	}
+
+	// LLM collects the amounts of all threads when it updates, which happens once per frame otherwise
+	Tracker.UpdateStatsPerFrame();
+	const int64 Before = Tracker.GetTagAmountForTracker(ELLMTracker::Default, BenchmarkParseTag);
+	int64 Sampled = Before;
+	{
+		LLM_SCOPE(BenchmarkParseTag);
+		Function([&]()
+		{
+			Tracker.UpdateStatsPerFrame();
+			Sampled = Tracker.GetTagAmountForTracker(ELLMTracker::Default, BenchmarkParseTag);
+		});
+	}
+	return Sampled - Before;
+#else
+	return -1;
+#endif
+}
+
+static FAutoConsoleCommand GameJoltBenchmarkCommand(
+	TEXT("GameJolt.Benchmark"),
+	TEXT("Measures the GameJolt client against an in-process fake server. Usage: GameJolt.Benchmark [Iterations] [OutputFile]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FGameJoltBenchmark::Start));
+
+TSharedPtr<FGameJoltBenchmark> FGameJoltBenchmark::Active;
+
+/* Gets the amount of requests sent by the throughput run of a concurrency */
+static int32 GetNumRequests(int32 Concurrency)
+{
+	return FMath::Max(Concurrency * 4, 256);
+}
+
+/* Calls a function the passed amount of times and gets the average duration of a call in seconds */
+template<typename FunctionType>
+static double MeasureSeconds(int32 Iterations, FunctionType Function)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	for(int32 i = 0; i < Iterations; i++)
+		Function();
+	return (FPlatformTime::Seconds() - StartTime) / Iterations;
+}
+
+/* Creates a scoreboard response like the server sends it */
+static FString CreateScoreboardResponse(int32 NumScores)
+{
+	FString Content;
+	Content.Reserve(64 + NumScores * 220);
+	Content += TEXT("{\"response\":{\"success\":\"true\",\"scores\":[");
+	for(int32 i = 0; i < NumScores; i++)
+	{
+		if(i > 0)
+			Content += TEXT(',');
+		Content += FString::Printf(TEXT("{\"score\":\"%d Points\",\"sort\":%d,\"extra_data\":\"\",\"user\":\"Player%d\",\"user_id\":%d,\"guest\":\"\",\"stored\":\"1 hour ago\",\"stored_timestamp\":1600000000}"), NumScores - i, NumScores - i, i, i + 1);
+	}
+	Content += TEXT("]}}");
+	return Content;
+}
+
+/* Starts a benchmark unless one is running already */
+void FGameJoltBenchmark::Start(const TArray<FString>& Args)
+{
+	if(Active.IsValid())
+	{
+		UE_LOG(GJAPI, Warning, TEXT("A benchmark is running already"));
+		return;
+	}
+
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+	const FString OutputFile = Args.Num() > 1 ? Args[1] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameJolt"), TEXT("Benchmark.json"));
+
+	Active = MakeShareable(new FGameJoltBenchmark(Iterations, OutputFile));
+	Active->RunSynchronous();
+	Active->SetUpServer();
+	Active->StartNextThroughputRun();
+}
+
+FGameJoltBenchmark::FGameJoltBenchmark(int32 InIterations, const FString& InOutputFile)
+	: Iterations(InIterations)
+	, OutputFile(InOutputFile)
+	, API(nullptr)
+	, RunIndex(-1)
+	, NumSent(0)
+	, NumCompleted(0)
+	, NumFailed(0)
+	, RunStartTime(0.0)
+	, TotalLatency(0.0)
+	, PreviousLogVerbosity(GJAPI.GetVerbosity())
+{
+}
+
+FGameJoltBenchmark::~FGameJoltBenchmark()
+{
+	if(API && UObjectInitialized())
+	{
+		API->SetTransport(nullptr);
+		API->RemoveFromRoot();
+	}
+	GJAPI.SetVerbosity(PreviousLogVerbosity);
+}
+
+/* Runs the benchmarks which don't need the server */
+void FGameJoltBenchmark::RunSynchronous()
+{
+	// Keeps the results alive, so the measured work can't be optimized away
+	int64 Sink = 0;
+
+	const FString UserName = TEXT("Benchmark User");
+	const FString UserToken = TEXT("a1b2c3");
+	// Building and signing take well below a microsecond each, so they are reported in nanoseconds
+	AddResult(TEXT("url_build"), 1000000000.0 * MeasureSeconds(Iterations, [&]()
+	{
+		Sink += FGameJoltQueryBuilder(TEXT("/scores/")).Add(TEXT("limit"), 10).Add(TEXT("table_id"), 1).Add(TEXT("guest"), UserName).Build().Len();
+	}), TEXT("ns"));
+
+	const FString Endpoint = FGameJoltQueryBuilder(TEXT("/scores/")).Add(TEXT("limit"), 10).Add(TEXT("table_id"), 1).Build();
+	for(const EGameJoltSignatureAlgorithm Algorithm : { EGameJoltSignatureAlgorithm::MD5, EGameJoltSignatureAlgorithm::SHA1 })
+	{
+		FGameJoltRequestSigner Signer;
+		Signer.Configure(TEXT("api.gamejolt.com"), TEXT("/api/game/"), TEXT("v1_2"), GJAPI_BENCHMARK_GAME_ID, GJAPI_BENCHMARK_PRIVATE_KEY, Algorithm);
+		AddResult(Algorithm == EGameJoltSignatureAlgorithm::SHA1 ? TEXT("sign_sha1") : TEXT("sign_md5"), 1000000000.0 * MeasureSeconds(Iterations, [&]()
+		{
+			Sink += Signer.BuildUrl(Endpoint, true, &UserName, &UserToken).Len();
+		}), TEXT("ns"));
+	}
+
+	// The allocations of building and signing can only be counted by the allocator, e.g. in a Memory Insights capture (-trace=memory)
+	{
+		FGameJoltRequestSigner Signer;
+		Signer.Configure(TEXT("api.gamejolt.com"), TEXT("/api/game/"), TEXT("v1_2"), GJAPI_BENCHMARK_GAME_ID, GJAPI_BENCHMARK_PRIVATE_KEY, EGameJoltSignatureAlgorithm::MD5);
+		TRACE_BOOKMARK(TEXT("GameJolt.Benchmark build_sign x%d begin"), Iterations);
+		for(int32 i = 0; i < Iterations; i++)
+		{
+			const FString Query = FGameJoltQueryBuilder(TEXT("/scores/")).Add(TEXT("limit"), 10).Add(TEXT("table_id"), 1).Add(TEXT("guest"), UserName).Build();
+			Sink += Signer.BuildUrl(Query, true, &UserName, &UserToken).Len();
+		}
+		TRACE_BOOKMARK(TEXT("GameJolt.Benchmark build_sign end"));
+	}
+
+	bool bMeasuredMemory = false;
+	for(const int32 NumScores : BenchmarkParseSizes)
+	{
+		const FString Content = CreateScoreboardResponse(NumScores);
+		const FTCHARToUTF8 Converted(*Content);
+		const TArray<uint8> ContentUTF8(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		const int32 ParseIterations = FMath::Max(Iterations * 10 / NumScores, 10);
+
+		// Both start from the received bytes, like the API does. OnParsed is called while everything the parse kept is still alive
+		TArray<FScoreInfo> Scores;
+		const auto ParseDom = [&](TFunctionRef<void()> OnParsed)
+		{
+			const FUTF8ToTCHAR ConvertedBack(reinterpret_cast<const ANSICHAR*>(ContentUTF8.GetData()), ContentUTF8.Num());
+			const FString ResponseString(ConvertedBack.Length(), ConvertedBack.Get());
+			TSharedPtr<FJsonObject> Data;
+			const TSharedPtr<FJsonObject>* Response = nullptr;
+			TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseString);
+			if(FJsonSerializer::Deserialize(JsonReader, Data) && Data.IsValid() && Data->TryGetObjectField(TEXT("response"), Response))
+				FGameJoltResponseDecoder::DecodeScores(*Response, Scores);
+			OnParsed();
+			Sink += Scores.Num();
+		};
+		const auto ParseStream = [&](TFunctionRef<void()> OnParsed)
+		{
+			FGameJoltStreamEnvelope Envelope;
+			FGameJoltStreamDecoder::DecodeScores(ContentUTF8, NumScores, Envelope, Scores);
+			OnParsed();
+			Sink += Scores.Num();
+		};
+
+		AddResult(FString::Printf(TEXT("parse_dom_%d"), NumScores), 1000000.0 * MeasureSeconds(ParseIterations, [&]() { ParseDom([]() {}); }), TEXT("us"));
+		AddResult(FString::Printf(TEXT("parse_stream_%d"), NumScores), 1000000.0 * MeasureSeconds(ParseIterations, [&]() { ParseStream([]() {}); }), TEXT("us"));
+
+		// The decoded scores count as well, so both start without them. The stream decoder's token buffers are freed by the time it returns
+		Scores.Empty();
+		const int64 DomBytes = MeasureTaggedBytes(ParseDom);
+		Scores.Empty();
+		const int64 StreamBytes = MeasureTaggedBytes(ParseStream);
+		bMeasuredMemory = DomBytes >= 0 && StreamBytes >= 0;
+		if(bMeasuredMemory)
+		{
+			AddResult(FString::Printf(TEXT("parse_dom_mem_%d"), NumScores), DomBytes, TEXT("bytes"));
+			AddResult(FString::Printf(TEXT("parse_stream_mem_%d"), NumScores), StreamBytes, TEXT("bytes"));
+		}
+	}
+
+	if(!bMeasuredMemory)
+		UE_LOG(GJAPI, Display, TEXT("Run with -llm to measure the memory of the parsers"));
+
+	UE_LOG(GJAPI, Verbose, TEXT("Benchmark checksum %lld"), Sink);
+}
+
+/* Sets up the fake server and the API instance the throughput runs use */
+void FGameJoltBenchmark::SetUpServer()
+{
+	Server = FGameJoltFakeServer::Create(GJAPI_BENCHMARK_GAME_ID, GJAPI_BENCHMARK_PRIVATE_KEY);
+	Server->AddScoreTable(1, TEXT("Benchmark"), true);
+	for(int32 i = 1; i <= 1000; i++)
+		Server->AddGuestScore(1, FString::Printf(TEXT("%d Points"), i), i, FString::Printf(TEXT("Guest%d"), i));
+
+	// Every request has to reach the server
+	API = NewObject<UUEGameJoltAPI>();
+	API->AddToRoot();
+	API->bCacheResponses = false;
+	API->bMergeIdenticalRequests = false;
+	API->bThrottleRequests = false;
+	API->bBatchRequests = false;
+	API->bRetryFailedRequests = false;
+	API->bQueueOfflineWrites = false;
+	API->Init(GJAPI_BENCHMARK_GAME_ID, GJAPI_BENCHMARK_PRIVATE_KEY, false);
+	API->SetTransport(Server);
+
+	GJAPI.SetVerbosity(ELogVerbosity::Warning);
+	ObjectCounter = MakeUnique<FGameJoltObjectCounter>(API);
+}
+
+/* Starts the throughput run of the next concurrency, or finishes the benchmark after the last one */
+void FGameJoltBenchmark::StartNextThroughputRun()
+{
+	RunIndex++;
+	if(RunIndex >= static_cast<int32>(UE_ARRAY_COUNT(BenchmarkConcurrencies)))
+	{
+		// Called from a response of the fake server, which must not be released within its tick
+		TSharedRef<FGameJoltBenchmark> Benchmark = AsShared();
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Benchmark](float DeltaTime)
+		{
+			Benchmark->Finish();
+			return false;
+		}));
+		return;
+	}
+
+	NumSent = 0;
+	NumCompleted = 0;
+	NumFailed = 0;
+	TotalLatency = 0.0;
+	RunStartTime = FPlatformTime::Seconds();
+	for(int32 i = 0; i < BenchmarkConcurrencies[RunIndex]; i++)
+		SendNext();
+}
+
+/* Sends the next request of the current throughput run */
+void FGameJoltBenchmark::SendNext()
+{
+	if(NumSent >= GetNumRequests(BenchmarkConcurrencies[RunIndex]))
+		return;
+
+	// Different pages, so no two requests are the same
+	const FString Endpoint = FGameJoltQueryBuilder(TEXT("/scores/")).Add(TEXT("limit"), 10).Add(TEXT("table_id"), 1).Add(TEXT("worse_than"), 1000 - NumSent % 990).Build();
+	const double SentTime = FPlatformTime::Seconds();
+	TWeakPtr<FGameJoltBenchmark> WeakThis = AsShared();
+	NumSent++;
+
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_SCORES_FETCH, Endpoint, false, [WeakThis, SentTime](const FGameJoltRequest& CompletedRequest)
+	{
+		TSharedPtr<FGameJoltBenchmark> This = WeakThis.Pin();
+		if(This.IsValid())
+			This->OnRequestComplete(CompletedRequest, SentTime);
+	});
+
+	if(!GameJoltRequest.IsValid())
+	{
+		UE_LOG(GJAPI, Error, TEXT("The benchmark couldn't start a request"));
+		OnRequestComplete(FGameJoltRequest(), SentTime);
+	}
+}
+
+/* Callback of every request of a throughput run */
+void FGameJoltBenchmark::OnRequestComplete(const FGameJoltRequest& GameJoltRequest, double SentTime)
+{
+	NumCompleted++;
+	NumFailed += GameJoltRequest.bSucceeded ? 0 : 1;
+	TotalLatency += FPlatformTime::Seconds() - SentTime;
+
+	if(NumCompleted < GetNumRequests(BenchmarkConcurrencies[RunIndex]))
+	{
+		SendNext();
+		return;
+	}
+
+	const int32 Concurrency = BenchmarkConcurrencies[RunIndex];
+	const double Duration = FMath::Max(FPlatformTime::Seconds() - RunStartTime, SMALL_NUMBER);
+	AddResult(FString::Printf(TEXT("throughput_%d"), Concurrency), NumCompleted / Duration, TEXT("requests/s"));
+	AddResult(FString::Printf(TEXT("latency_%d"), Concurrency), TotalLatency * 1000.0 / NumCompleted, TEXT("ms"));
+	AddResult(FString::Printf(TEXT("failed_%d"), Concurrency), NumFailed, TEXT("requests"));
+	StartNextThroughputRun();
+}
+
+/* Logs and writes the results and releases the benchmark */
+void FGameJoltBenchmark::Finish()
+{
+	int32 NumRequests = 0;
+	for(const int32 Concurrency : BenchmarkConcurrencies)
+		NumRequests += GetNumRequests(Concurrency);
+	AddResult(TEXT("uobjects_per_request"), static_cast<double>(ObjectCounter->NumCreated.GetValue()) / NumRequests, TEXT("objects"));
+	ObjectCounter.Reset();
+	GJAPI.SetVerbosity(PreviousLogVerbosity);
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetNumberField(TEXT("iterations"), Iterations);
+	Root->SetArrayField(TEXT("results"), Results);
+
+	FString Content;
+	TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Content);
+	FJsonSerializer::Serialize(Root, JsonWriter);
+	if(FFileHelper::SaveStringToFile(Content, *OutputFile))
+		UE_LOG(GJAPI, Log, TEXT("Benchmark results written to %s"), *OutputFile);
+	else
+		UE_LOG(GJAPI, Error, TEXT("Failed to write the benchmark results to %s"), *OutputFile);
+
+	Active.Reset();
+}
+
+/* Adds a result */
+void FGameJoltBenchmark::AddResult(const FString& Name, double Value, const TCHAR* Unit)
+{
+	UE_LOG(GJAPI, Display, TEXT("%s: %.3f %s"), *Name, Value, Unit);
+
+	TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+	Result->SetStringField(TEXT("name"), Name);
+	Result->SetNumberField(TEXT("value"), Value);
+	Result->SetStringField(TEXT("unit"), Unit);
+	Results.Add(MakeShared<FJsonValueObject>(Result));
+}
+
+#endif
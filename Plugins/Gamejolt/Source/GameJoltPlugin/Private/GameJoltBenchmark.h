@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+class FJsonObject;
+class FGameJoltFakeServer;
+class UUEGameJoltAPI;
+struct FGameJoltRequest;
+
+/**
+ * Measures the client against a FGameJoltFakeServer, started with the console command "GameJolt.Benchmark [Iterations] [OutputFile]"
+ * Covers URL building, signing, time and memory (with -llm) of parsing 10/100/1000 scoreboard entries,
+ * UObjects created per request and request throughput at 1, 16 and 256 requests in flight
+ * The results are logged and written as JSON, to Saved/GameJolt/Benchmark.json unless another file is passed
+ */
+class FGameJoltBenchmark : public TSharedFromThis<FGameJoltBenchmark>
+{
+public:
+
+	/* Starts a benchmark unless one is running already */
+	static void Start(const TArray<FString>& Args);
+
+	~FGameJoltBenchmark();
+
+private:
+
+	FGameJoltBenchmark(int32 InIterations, const FString& InOutputFile);
+
+	/* Runs the benchmarks which don't need the server */
+	void RunSynchronous();
+
+	/* Sets up the fake server and the API instance the throughput runs use */
+	void SetUpServer();
+
+	/* Starts the throughput run of the next concurrency, or finishes the benchmark after the last one */
+	void StartNextThroughputRun();
+
+	/* Sends the next request of the current throughput run */
+	void SendNext();
+
+	/* Callback of every request of a throughput run */
+	void OnRequestComplete(const FGameJoltRequest& GameJoltRequest, double SentTime);
+
+	/* Logs and writes the results and releases the benchmark */
+	void Finish();
+
+	/* Adds a result */
+	void AddResult(const FString& Name, double Value, const TCHAR* Unit);
+
+	int32 Iterations;
+	FString OutputFile;
+
+	TArray<TSharedPtr<class FJsonValue>> Results;
+
+	TSharedPtr<FGameJoltFakeServer, ESPMode::ThreadSafe> Server;
+	UUEGameJoltAPI* API;
+
+	/* Index of the current throughput run in the concurrencies */
+	int32 RunIndex;
+	int32 NumSent;
+	int32 NumCompleted;
+	int32 NumFailed;
+	double RunStartTime;
+	double TotalLatency;
+
+	/* Verbosity of the GJAPI log before the throughput runs, which would log every URL otherwise */
+	ELogVerbosity::Type PreviousLogVerbosity;
+
+	/* Counts the UObjects the client creates while the throughput runs are in progress */
+	TUniquePtr<class FGameJoltObjectCounter> ObjectCounter;
+
+	/* The benchmark in progress. Keeps it alive until it finished */
+	static TSharedPtr<FGameJoltBenchmark> Active;
+};
+
+#endif
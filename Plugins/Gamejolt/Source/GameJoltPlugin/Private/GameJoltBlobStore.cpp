@@ -0,0 +1,776 @@
+#include "GameJoltBlobStore.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+#include "GameJoltDeltaStore.h"
+#include "Misc/Base64.h"
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+/* A single request's worth of a blob */
+struct FGameJoltBlobPiece
+{
+	/* The data-store key of the piece */
+	FString Key;
+
+	/* The encoded, compressed bytes. Filled in when they are downloaded */
+	FString Data;
+
+	/* The hash of a content-defined chunk. Empty for the chunks of a version */
+	FString Hash;
+
+	/* The uncompressed size of a content-defined chunk */
+	int32 RawSize;
+
+	/* How often the piece has been sent again */
+	int32 RetryCount;
+
+	FGameJoltBlobPiece()
+		: RawSize(0)
+		, RetryCount(0)
+	{
+	}
+};
+
+/* A blob being saved or loaded */
+struct UGameJoltBlobStore::FTransfer
+{
+	bool bSave;
+
+	/* The version the blob is stored under */
+	FString Version;
+
+	/* The delta store scope of the blob, taken when the transfer started */
+	FString Scope;
+
+	/* The pieces to transfer: the chunks of the version first, followed by the content-defined chunks of a delta sync */
+	TArray<FGameJoltBlobPiece> Pieces;
+
+	/* Indices of the pieces still to transfer */
+	TArray<int32> Queue;
+
+	int32 NumInFlight;
+	int32 NumDone;
+
+	/* The amount of chunks of the version */
+	int32 NumChunks;
+
+	/* Size of the uncompressed content of the version */
+	int32 RawSize;
+
+	/* Checksum of the compressed content of the version */
+	uint32 Crc;
+
+	/* Whether the manifest of the version to replace has been fetched. Only used by saves */
+	bool bOldManifestFetched;
+
+	/* The version to replace and its amount of chunks. Empty if there was none */
+	FString OldVersion;
+	int32 OldNumChunks;
+
+	/* Whether the version holds the list of content-defined chunks of the blob */
+	bool bDelta;
+
+	/* Whether the content-defined chunks are known. Loads get them from the version */
+	bool bIndexLoaded;
+
+	/* The content-defined chunks of the blob, in order */
+	TArray<FGameJoltContentChunk> ContentChunks;
+
+	/* The uncompressed content-defined chunks at hand, by hash */
+	TMap<FString, TArray<uint8>> Content;
+
+	/* The chunks the server held when the blob was last synced on this device. Only used by saves, cleared if the server holds another version */
+	FString SyncedVersion;
+	TArray<FGameJoltContentChunk> SyncedChunks;
+
+	FTransfer()
+		: bSave(false)
+		, NumInFlight(0)
+		, NumDone(0)
+		, NumChunks(0)
+		, RawSize(0)
+		, Crc(0)
+		, bOldManifestFetched(false)
+		, OldNumChunks(0)
+		, bDelta(false)
+		, bIndexLoaded(false)
+	{
+	}
+};
+
+/* Encodes bytes as base64 which needs no escaping in a query string */
+static FString EncodeChunk(const uint8* Data, int32 Size)
+{
+	FString Encoded = FBase64::Encode(Data, Size);
+	Encoded.ReplaceCharInline(TEXT('+'), TEXT('-'));
+	Encoded.ReplaceCharInline(TEXT('/'), TEXT('_'));
+	Encoded.RemoveFromEnd(TEXT("=="));
+	Encoded.RemoveFromEnd(TEXT("="));
+	return Encoded;
+}
+
+/* Decodes a chunk and appends it to the bytes decoded so far */
+static bool DecodeChunk(FString Encoded, TArray<uint8>& OutData)
+{
+	Encoded.ReplaceCharInline(TEXT('-'), TEXT('+'));
+	Encoded.ReplaceCharInline(TEXT('_'), TEXT('/'));
+	while(Encoded.Len() % 4 != 0)
+		Encoded.AppendChar(TEXT('='));
+
+	TArray<uint8> Decoded;
+	if(!FBase64::Decode(Encoded, Decoded))
+		return false;
+	OutData.Append(Decoded);
+	return true;
+}
+
+/* Compresses bytes with zlib */
+static bool CompressBytes(const uint8* Data, int32 Size, TArray<uint8>& OutCompressed)
+{
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Size);
+	OutCompressed.SetNumUninitialized(CompressedSize);
+	if(!FCompression::CompressMemory(NAME_Zlib, OutCompressed.GetData(), CompressedSize, Data, Size))
+		return false;
+	OutCompressed.SetNum(CompressedSize, false);
+	return true;
+}
+
+/* Constructor */
+UGameJoltBlobStore::UGameJoltBlobStore(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	MaxChunkSize = 4096;
+	MaxParallelTransfers = 4;
+	bDeltaSync = false;
+	ChunkRetries = 2;
+	API = nullptr;
+	Type = EDataStore::Global;
+}
+
+/* Creates a blob store */
+UGameJoltBlobStore* UGameJoltBlobStore::CreateBlobStore(UUEGameJoltAPI* API, EDataStore Type)
+{
+	if(!API)
+	{
+		UE_LOG(GJAPI, Error, TEXT("A blob store needs an API instance to transfer its chunks with"));
+		return nullptr;
+	}
+
+	UGameJoltBlobStore* BlobStore = NewObject<UGameJoltBlobStore>(API);
+	BlobStore->API = API;
+	BlobStore->Type = Type;
+	return BlobStore;
+}
+
+/* Compresses a blob and uploads it */
+bool UGameJoltBlobStore::SaveBlob(const FString& Name, const TArray<uint8>& Data)
+{
+	if(!API || Name.IsEmpty() || Transfers.Contains(Name))
+		return false;
+
+	const TSharedRef<FTransfer> Transfer = MakeShared<FTransfer>();
+	Transfer->bSave = true;
+	Transfer->Version = FGuid::NewGuid().ToString(EGuidFormats::Digits).Left(12);
+	Transfer->Scope = GetDeltaScope();
+	Transfer->bDelta = bDeltaSync;
+
+	if(bDeltaSync)
+	{
+		FGameJoltDeltaStore::Split(Data, MaxChunkSize, Transfer->ContentChunks);
+		Transfer->bIndexLoaded = true;
+
+		int32 Offset = 0;
+		for(const FGameJoltContentChunk& Chunk : Transfer->ContentChunks)
+		{
+			if(!Transfer->Content.Contains(Chunk.Hash))
+				Transfer->Content.Add(Chunk.Hash, TArray<uint8>(Data.GetData() + Offset, Chunk.Size));
+			Offset += Chunk.Size;
+		}
+
+		// The version only holds the list of chunks
+		TArray<uint8> Index;
+		FGameJoltDeltaStore::SerializeIndex(Transfer->ContentChunks, Index);
+		if(!AddVersionPieces(Name, *Transfer, Index))
+			return false;
+
+		// Chunks the server held after the last sync on this device are skipped right away. Should the manifest show another version, they are added once it arrived
+		GetDeltaStore().GetServerIndex(Transfer->Scope, Name, Transfer->SyncedVersion, Transfer->SyncedChunks);
+		TSet<FString> HeldHashes;
+		for(const FGameJoltContentChunk& Chunk : Transfer->SyncedChunks)
+			HeldHashes.Add(Chunk.Hash);
+		if(!AddContentUploads(Name, *Transfer, HeldHashes))
+			return false;
+	}
+	else if(!AddVersionPieces(Name, *Transfer, Data))
+	{
+		return false;
+	}
+
+	// The manifest of the version to replace is fetched alongside the upload, so its chunks can be removed after the commit
+	const FString Version = Transfer->Version;
+	TWeakObjectPtr<UGameJoltBlobStore> WeakThis(this);
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_FETCH,
+		FGameJoltQueryBuilder(TEXT("/data-store/")).Add(TEXT("key"), Name).Build(), Type == EDataStore::User,
+		[WeakThis, Name, Version](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnManifestFetched(CompletedRequest, Name, Version);
+		}, FString(), true);
+
+	if(!GameJoltRequest.IsValid())
+		return false;
+
+	Transfers.Add(Name, Transfer);
+	PumpChunks(Name);
+	return true;
+}
+
+/* Downloads a blob and decompresses it */
+bool UGameJoltBlobStore::LoadBlob(const FString& Name)
+{
+	if(!API || Name.IsEmpty() || Transfers.Contains(Name))
+		return false;
+
+	// A load gets its version from the manifest, so it is matched by an empty one until then
+	TWeakObjectPtr<UGameJoltBlobStore> WeakThis(this);
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_FETCH,
+		FGameJoltQueryBuilder(TEXT("/data-store/")).Add(TEXT("key"), Name).Build(), Type == EDataStore::User,
+		[WeakThis, Name](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnManifestFetched(CompletedRequest, Name, FString());
+		}, FString(), true);
+
+	if(!GameJoltRequest.IsValid())
+		return false;
+
+	const TSharedRef<FTransfer> Transfer = MakeShared<FTransfer>();
+	Transfer->Scope = GetDeltaScope();
+	Transfers.Add(Name, Transfer);
+	return true;
+}
+
+/* Whether a blob is being saved or loaded */
+bool UGameJoltBlobStore::IsTransferring(const FString& Name) const
+{
+	return Transfers.Contains(Name);
+}
+
+/* Adds the compressed content of a version as pieces */
+bool UGameJoltBlobStore::AddVersionPieces(const FString& Name, FTransfer& Transfer, const TArray<uint8>& Data)
+{
+	TArray<uint8> Compressed;
+	if(!CompressBytes(Data.GetData(), Data.Num(), Compressed))
+	{
+		UE_LOG(GJAPI, Error, TEXT("Blob %s couldn't be compressed"), *Name);
+		return false;
+	}
+
+	Transfer.RawSize = Data.Num();
+	Transfer.Crc = FCrc::MemCrc32(Compressed.GetData(), Compressed.Num());
+
+	const int32 ChunkSize = FMath::Max(MaxChunkSize, 256);
+	for(int32 Offset = 0; Offset < Compressed.Num(); Offset += ChunkSize)
+	{
+		FGameJoltBlobPiece& Piece = Transfer.Pieces.AddDefaulted_GetRef();
+		Piece.Key = GetChunkKey(Name, Transfer.Version, Transfer.NumChunks++);
+		Piece.Data = EncodeChunk(Compressed.GetData() + Offset, FMath::Min(ChunkSize, Compressed.Num() - Offset));
+		Transfer.Queue.Add(Transfer.Pieces.Num() - 1);
+	}
+	return true;
+}
+
+/* Adds the content-defined chunks of a save which the server doesn't hold as pieces */
+bool UGameJoltBlobStore::AddContentUploads(const FString& Name, FTransfer& Transfer, const TSet<FString>& HeldHashes)
+{
+	TSet<FString> AddedHashes;
+	for(const FGameJoltBlobPiece& Piece : Transfer.Pieces)
+	{
+		if(!Piece.Hash.IsEmpty())
+			AddedHashes.Add(Piece.Hash);
+	}
+
+	for(const TPair<FString, TArray<uint8>>& Pair : Transfer.Content)
+	{
+		if(HeldHashes.Contains(Pair.Key) || AddedHashes.Contains(Pair.Key))
+			continue;
+
+		TArray<uint8> Compressed;
+		if(!CompressBytes(Pair.Value.GetData(), Pair.Value.Num(), Compressed))
+		{
+			UE_LOG(GJAPI, Error, TEXT("A chunk of blob %s couldn't be compressed"), *Name);
+			return false;
+		}
+
+		FGameJoltBlobPiece& Piece = Transfer.Pieces.AddDefaulted_GetRef();
+		Piece.Key = GetContentKey(Name, Pair.Key);
+		Piece.Data = EncodeChunk(Compressed.GetData(), Compressed.Num());
+		Piece.Hash = Pair.Key;
+		Piece.RawSize = Pair.Value.Num();
+		Transfer.Queue.Add(Transfer.Pieces.Num() - 1);
+	}
+	return true;
+}
+
+/* Adds the content-defined chunks of a load which aren't kept on disk as pieces */
+void UGameJoltBlobStore::AddContentDownloads(const FString& Name, FTransfer& Transfer)
+{
+	TSet<FString> AddedHashes;
+	for(const FGameJoltContentChunk& Chunk : Transfer.ContentChunks)
+	{
+		if(Transfer.Content.Contains(Chunk.Hash) || AddedHashes.Contains(Chunk.Hash))
+			continue;
+
+		TArray<uint8> Data;
+		if(GetDeltaStore().LoadChunk(Transfer.Scope, Name, Chunk, Data))
+		{
+			Transfer.Content.Add(Chunk.Hash, MoveTemp(Data));
+			continue;
+		}
+
+		AddedHashes.Add(Chunk.Hash);
+		FGameJoltBlobPiece& Piece = Transfer.Pieces.AddDefaulted_GetRef();
+		Piece.Key = GetContentKey(Name, Chunk.Hash);
+		Piece.Hash = Chunk.Hash;
+		Piece.RawSize = Chunk.Size;
+		Transfer.Queue.Add(Transfer.Pieces.Num() - 1);
+	}
+}
+
+/* Callback of a manifest fetch */
+void UGameJoltBlobStore::OnManifestFetched(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version)
+{
+	FTransfer* Transfer = FindTransfer(Name, Version);
+	if(!Transfer)
+		return;
+
+	FString ManifestVersion;
+	int32 NumChunks = 0;
+	int32 RawSize = 0;
+	uint32 Crc = 0;
+	bool bDelta = false;
+	bool bManifestValid = false;
+	if(GameJoltRequest.bSucceeded && GameJoltRequest.Response.IsValid())
+	{
+		TSharedPtr<FJsonObject> Manifest;
+		const TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(FGameJoltResponseDecoder::DecodeString(*GameJoltRequest.Response, TEXT("data")));
+		bManifestValid = FJsonSerializer::Deserialize(Reader, Manifest) && Manifest.IsValid()
+			&& Manifest->TryGetStringField(TEXT("version"), ManifestVersion) && Manifest->TryGetNumberField(TEXT("chunks"), NumChunks)
+			&& Manifest->TryGetNumberField(TEXT("size"), RawSize) && Manifest->TryGetNumberField(TEXT("crc"), Crc)
+			&& !ManifestVersion.IsEmpty() && NumChunks >= 0 && RawSize >= 0;
+		if(bManifestValid)
+			Manifest->TryGetBoolField(TEXT("delta"), bDelta);
+	}
+
+	if(Transfer->bSave)
+	{
+		// Without a readable manifest there is nothing to clean up. Chunks it might have referenced are left behind
+		Transfer->bOldManifestFetched = true;
+		if(bManifestValid)
+		{
+			Transfer->OldVersion = ManifestVersion;
+			Transfer->OldNumChunks = NumChunks;
+		}
+
+		// Another device saved since the last sync, or the blob is gone. The chunks skipped because of the last sync may have been removed
+		if(Transfer->bDelta && (!bManifestValid || ManifestVersion != Transfer->SyncedVersion))
+		{
+			Transfer->SyncedVersion.Reset();
+			Transfer->SyncedChunks.Reset();
+			if(!AddContentUploads(Name, *Transfer, TSet<FString>()))
+			{
+				FailTransfer(Name);
+				return;
+			}
+			PumpChunks(Name);
+		}
+		TryCommit(Name);
+		return;
+	}
+
+	if(!bManifestValid)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Blob %s has no readable manifest"), *Name);
+		FailTransfer(Name);
+		return;
+	}
+
+	Transfer->Version = ManifestVersion;
+	Transfer->bDelta = bDelta;
+
+	// The chunk list of the version is known from the last sync, so only chunks which went missing on disk are fetched
+	FString SyncedVersion;
+	TArray<FGameJoltContentChunk> SyncedChunks;
+	if(bDelta && GetDeltaStore().GetServerIndex(Transfer->Scope, Name, SyncedVersion, SyncedChunks) && SyncedVersion == ManifestVersion)
+	{
+		Transfer->ContentChunks = MoveTemp(SyncedChunks);
+		Transfer->bIndexLoaded = true;
+		AddContentDownloads(Name, *Transfer);
+		if(Transfer->Pieces.Num() == 0)
+			FinishLoad(Name);
+		else
+			PumpChunks(Name);
+		return;
+	}
+
+	Transfer->RawSize = RawSize;
+	Transfer->Crc = Crc;
+	Transfer->NumChunks = NumChunks;
+	for(int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+	{
+		Transfer->Pieces.AddDefaulted_GetRef().Key = GetChunkKey(Name, ManifestVersion, ChunkIndex);
+		Transfer->Queue.Add(ChunkIndex);
+	}
+
+	if(NumChunks == 0)
+		FinishLoad(Name);
+	else
+		PumpChunks(Name);
+}
+
+/* Transfers the next pieces until the limit of transfers in flight is reached */
+void UGameJoltBlobStore::PumpChunks(const FString& Name)
+{
+	const TSharedRef<FTransfer>* Found = Transfers.Find(Name);
+	if(!Found)
+		return;
+
+	const TSharedRef<FTransfer> Transfer = *Found;
+	const FString Version = Transfer->Version;
+	TWeakObjectPtr<UGameJoltBlobStore> WeakThis(this);
+	while(Transfer->NumInFlight < FMath::Max(MaxParallelTransfers, 1) && Transfer->Queue.Num() > 0)
+	{
+		const int32 PieceIndex = Transfer->Queue.Pop(false);
+		const FGameJoltBlobPiece& Piece = Transfer->Pieces[PieceIndex];
+		Transfer->NumInFlight++;
+
+		FGameJoltRequestCallback OnComplete = [WeakThis, Name, Version, PieceIndex](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnChunkTransferred(CompletedRequest, Name, Version, PieceIndex);
+		};
+
+		// Pieces are sent straight away, never held back by the write-behind cache.
+		// Written pieces are neither batched, as their URLs are long, nor journaled, as a failed transfer is started over as a whole
+		TSharedPtr<FGameJoltRequest> GameJoltRequest;
+		if(Transfer->bSave)
+		{
+			FGameJoltQueryBuilder Query(TEXT("/data-store/set/"), 48 + Piece.Key.Len() * 3 + Piece.Data.Len());
+			Query.Add(TEXT("key"), Piece.Key).Add(TEXT("data"), Piece.Data);
+			GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_SET, Query.Build(), Type == EDataStore::User, MoveTemp(OnComplete), FString(), true, true);
+		}
+		else
+		{
+			GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_FETCH,
+				FGameJoltQueryBuilder(TEXT("/data-store/")).Add(TEXT("key"), Piece.Key).Build(), Type == EDataStore::User, MoveTemp(OnComplete), FString(), true);
+		}
+
+		// A request answered locally may complete right away and end the transfer, which is why it was counted before it was sent
+		if(FindTransfer(Name, Version) != &Transfer.Get())
+			return;
+
+		if(!GameJoltRequest.IsValid())
+		{
+			FailTransfer(Name);
+			return;
+		}
+	}
+}
+
+/* Callback of a piece transfer */
+void UGameJoltBlobStore::OnChunkTransferred(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version, int32 PieceIndex)
+{
+	FTransfer* Transfer = FindTransfer(Name, Version);
+	if(!Transfer)
+		return;
+
+	FGameJoltBlobPiece& Piece = Transfer->Pieces[PieceIndex];
+	Transfer->NumInFlight--;
+	if(!GameJoltRequest.bSucceeded || (!Transfer->bSave && !GameJoltRequest.Response.IsValid()))
+	{
+		if(Piece.RetryCount++ >= ChunkRetries)
+		{
+			UE_LOG(GJAPI, Warning, TEXT("%s of blob %s couldn't be transferred"), *Piece.Key, *Name);
+			FailTransfer(Name);
+			return;
+		}
+		Transfer->Queue.Add(PieceIndex);
+	}
+	else
+	{
+		if(!Transfer->bSave)
+			Piece.Data = FGameJoltResponseDecoder::DecodeString(*GameJoltRequest.Response, TEXT("data"));
+
+		// Content-defined chunks are checked right away, the chunks of a version once they are joined
+		if(!Transfer->bSave && !Piece.Hash.IsEmpty())
+		{
+			TArray<uint8> Compressed;
+			TArray<uint8> Data;
+			Data.SetNumUninitialized(Piece.RawSize);
+			if(!DecodeChunk(Piece.Data, Compressed) || !FCompression::UncompressMemory(NAME_Zlib, Data.GetData(), Data.Num(), Compressed.GetData(), Compressed.Num())
+				|| FGameJoltDeltaStore::HashChunk(Data.GetData(), Data.Num()) != Piece.Hash)
+			{
+				UE_LOG(GJAPI, Warning, TEXT("%s of blob %s doesn't match its hash"), *Piece.Key, *Name);
+				FailTransfer(Name);
+				return;
+			}
+			Transfer->Content.Add(Piece.Hash, MoveTemp(Data));
+			Piece.Data.Reset();
+		}
+		Transfer->NumDone++;
+	}
+
+	if(Transfer->NumDone < Transfer->Pieces.Num())
+	{
+		PumpChunks(Name);
+		return;
+	}
+
+	if(Transfer->bSave)
+		TryCommit(Name);
+	else
+		FinishLoad(Name);
+}
+
+/* Switches the manifest to the new version once all pieces have been uploaded */
+void UGameJoltBlobStore::TryCommit(const FString& Name)
+{
+	const TSharedRef<FTransfer>* Found = Transfers.Find(Name);
+	if(!Found)
+		return;
+
+	const FTransfer& Transfer = Found->Get();
+	if(!Transfer.bOldManifestFetched || Transfer.NumDone < Transfer.Pieces.Num())
+		return;
+
+	FString Manifest;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Manifest);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("version"), Transfer.Version);
+	Writer->WriteValue(TEXT("chunks"), Transfer.NumChunks);
+	Writer->WriteValue(TEXT("size"), Transfer.RawSize);
+	Writer->WriteValue(TEXT("crc"), (int64)Transfer.Crc);
+	if(Transfer.bDelta)
+		Writer->WriteValue(TEXT("delta"), true);
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	const FString Version = Transfer.Version;
+	TWeakObjectPtr<UGameJoltBlobStore> WeakThis(this);
+	FGameJoltQueryBuilder Query(TEXT("/data-store/set/"), 48 + Name.Len() * 3 + Manifest.Len() * 3);
+	Query.Add(TEXT("key"), Name).Add(TEXT("data"), Manifest);
+
+	// A journaled manifest could be replayed later on its own, pointing at pieces which were never written
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_SET, Query.Build(), Type == EDataStore::User,
+		[WeakThis, Name, Version](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnCommitted(CompletedRequest, Name, Version);
+		}, FString(), true, true);
+
+	if(!GameJoltRequest.IsValid() && FindTransfer(Name, Version))
+		FailTransfer(Name);
+}
+
+/* Callback of the manifest update */
+void UGameJoltBlobStore::OnCommitted(const FGameJoltRequest& GameJoltRequest, const FString& Name, const FString& Version)
+{
+	FTransfer* Transfer = FindTransfer(Name, Version);
+	if(!Transfer)
+		return;
+
+	if(!GameJoltRequest.bSucceeded)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("The manifest of blob %s couldn't be updated"), *Name);
+		FailTransfer(Name);
+		return;
+	}
+
+	// Loads started from now on read the new version, so the old one can go
+	if(!Transfer->OldVersion.IsEmpty() && Transfer->OldVersion != Version)
+		RemoveChunks(Name, Transfer->OldVersion, Transfer->OldNumChunks);
+
+	if(Transfer->bDelta)
+	{
+		// The content-defined chunks of the replaced version are only known if it is the one last synced on this device
+		TSet<FString> Hashes;
+		for(const FGameJoltContentChunk& Chunk : Transfer->ContentChunks)
+			Hashes.Add(Chunk.Hash);
+		for(const FGameJoltContentChunk& Chunk : Transfer->SyncedChunks)
+		{
+			bool bAlreadyInSet = false;
+			Hashes.Add(Chunk.Hash, &bAlreadyInSet);
+			if(!bAlreadyInSet)
+				RemoveKey(GetContentKey(Name, Chunk.Hash));
+		}
+
+		for(const TPair<FString, TArray<uint8>>& Pair : Transfer->Content)
+			GetDeltaStore().StoreChunk(Transfer->Scope, Name, Pair.Key, Pair.Value.GetData(), Pair.Value.Num());
+		GetDeltaStore().SetServerIndex(Transfer->Scope, Name, Version, Transfer->ContentChunks);
+	}
+
+	Transfers.Remove(Name);
+	OnBlobSaved.Broadcast(Name, true);
+}
+
+/* Joins and decompresses the downloaded chunks of the version, then fetches the content-defined chunks it lists */
+void UGameJoltBlobStore::FinishLoad(const FString& Name)
+{
+	const TSharedRef<FTransfer>* Found = Transfers.Find(Name);
+	if(!Found)
+		return;
+
+	const TSharedRef<FTransfer> Transfer = *Found;
+	if(!Transfer->bIndexLoaded)
+	{
+		TArray<uint8> Compressed;
+		bool bLoaded = true;
+		for(int32 ChunkIndex = 0; ChunkIndex < Transfer->NumChunks && bLoaded; ChunkIndex++)
+			bLoaded = DecodeChunk(Transfer->Pieces[ChunkIndex].Data, Compressed);
+
+		TArray<uint8> Data;
+		if(bLoaded && FCrc::MemCrc32(Compressed.GetData(), Compressed.Num()) != Transfer->Crc)
+		{
+			UE_LOG(GJAPI, Warning, TEXT("Blob %s doesn't match its checksum"), *Name);
+			bLoaded = false;
+		}
+		else if(bLoaded)
+		{
+			Data.SetNumUninitialized(Transfer->RawSize);
+			bLoaded = FCompression::UncompressMemory(NAME_Zlib, Data.GetData(), Data.Num(), Compressed.GetData(), Compressed.Num());
+			if(!bLoaded)
+				UE_LOG(GJAPI, Warning, TEXT("Blob %s couldn't be decompressed"), *Name);
+		}
+
+		if(!bLoaded)
+		{
+			FailTransfer(Name);
+			return;
+		}
+
+		if(!Transfer->bDelta)
+		{
+			Transfers.Remove(Name);
+			OnBlobLoaded.Broadcast(Name, true, Data);
+			return;
+		}
+
+		if(!FGameJoltDeltaStore::DeserializeIndex(Data, Transfer->ContentChunks))
+		{
+			UE_LOG(GJAPI, Warning, TEXT("Blob %s has an invalid chunk list"), *Name);
+			FailTransfer(Name);
+			return;
+		}
+		Transfer->bIndexLoaded = true;
+
+		const int32 NumPieces = Transfer->Pieces.Num();
+		AddContentDownloads(Name, *Transfer);
+		if(Transfer->Pieces.Num() > NumPieces)
+		{
+			PumpChunks(Name);
+			return;
+		}
+	}
+
+	int32 Size = 0;
+	for(const FGameJoltContentChunk& Chunk : Transfer->ContentChunks)
+		Size += Chunk.Size;
+
+	TArray<uint8> Data;
+	Data.Reserve(Size);
+	for(const FGameJoltContentChunk& Chunk : Transfer->ContentChunks)
+		Data.Append(Transfer->Content.FindChecked(Chunk.Hash));
+
+	// Only the downloaded chunks are new on disk
+	for(const FGameJoltBlobPiece& Piece : Transfer->Pieces)
+	{
+		if(!Piece.Hash.IsEmpty())
+		{
+			const TArray<uint8>& Content = Transfer->Content.FindChecked(Piece.Hash);
+			GetDeltaStore().StoreChunk(Transfer->Scope, Name, Piece.Hash, Content.GetData(), Content.Num());
+		}
+	}
+	GetDeltaStore().SetServerIndex(Transfer->Scope, Name, Transfer->Version, Transfer->ContentChunks);
+
+	Transfers.Remove(Name);
+	OnBlobLoaded.Broadcast(Name, true, Data);
+}
+
+/* Fails a transfer and removes the chunks a failed save uploaded */
+void UGameJoltBlobStore::FailTransfer(const FString& Name)
+{
+	const TSharedRef<FTransfer>* Found = Transfers.Find(Name);
+	if(!Found)
+		return;
+
+	const TSharedRef<FTransfer> Transfer = *Found;
+	Transfers.Remove(Name);
+
+	// The manifest still points to the old version, so the chunks of the new one aren't referenced by anything
+	// Uploaded content-defined chunks are kept, as the old version may list them as well
+	if(Transfer->bSave)
+	{
+		RemoveChunks(Name, Transfer->Version, Transfer->NumChunks);
+		OnBlobSaved.Broadcast(Name, false);
+	}
+	else
+	{
+		OnBlobLoaded.Broadcast(Name, false, TArray<uint8>());
+	}
+}
+
+/* Removes the chunks of a version, without waiting for the server */
+void UGameJoltBlobStore::RemoveChunks(const FString& Name, const FString& Version, int32 NumChunks)
+{
+	for(int32 ChunkIndex = 0; ChunkIndex < NumChunks; ChunkIndex++)
+		RemoveKey(GetChunkKey(Name, Version, ChunkIndex));
+}
+
+/* Removes a key, without waiting for the server */
+void UGameJoltBlobStore::RemoveKey(const FString& Key)
+{
+	API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_REMOVE,
+		FGameJoltQueryBuilder(TEXT("/data-store/remove/")).Add(TEXT("key"), Key).Build(), Type == EDataStore::User, nullptr, FString(), true);
+}
+
+/* Gets the transfer of a blob, if it is still the one of the specified version */
+UGameJoltBlobStore::FTransfer* UGameJoltBlobStore::FindTransfer(const FString& Name, const FString& Version)
+{
+	TSharedRef<FTransfer>* Transfer = Transfers.Find(Name);
+	if(!Transfer || (*Transfer)->Version != Version)
+		return nullptr;
+	return &Transfer->Get();
+}
+
+/* Gets the key of a chunk of a version */
+FString UGameJoltBlobStore::GetChunkKey(const FString& Name, const FString& Version, int32 ChunkIndex)
+{
+	return FString::Printf(TEXT("%s.chunk.%s.%d"), *Name, *Version, ChunkIndex);
+}
+
+/* Gets the key of a content-defined chunk */
+FString UGameJoltBlobStore::GetContentKey(const FString& Name, const FString& Hash)
+{
+	return FString::Printf(TEXT("%s.content.%s"), *Name, *Hash);
+}
+
+/* Gets the directory scope of the delta store */
+FString UGameJoltBlobStore::GetDeltaScope() const
+{
+	if(Type == EDataStore::User && API)
+		return TEXT("User_") + API->UserName.ToLower();
+	return TEXT("Global");
+}
+
+/* Gets the local side of delta syncs, creating it on first use */
+FGameJoltDeltaStore& UGameJoltBlobStore::GetDeltaStore()
+{
+	if(!DeltaStore.IsValid())
+		DeltaStore = MakeShared<FGameJoltDeltaStore>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameJolt"), TEXT("Blobs")));
+	return *DeltaStore;
+}
@@ -0,0 +1,67 @@
+#include "GameJoltCircuitBreaker.h"
+#include "HAL/PlatformTime.h"
+
+FGameJoltCircuitBreaker::FGameJoltCircuitBreaker()
+	: FailureThreshold(5)
+	, Cooldown(30.f)
+{
+}
+
+/* Updates the threshold and the cooldown */
+void FGameJoltCircuitBreaker::Configure(int32 InFailureThreshold, float InCooldown)
+{
+	FailureThreshold = FMath::Max(InFailureThreshold, 1);
+	Cooldown = FMath::Max(InCooldown, 0.f);
+}
+
+/* Whether a request of the action may be sent */
+bool FGameJoltCircuitBreaker::AllowRequest(EGameJoltComponentEnum Action)
+{
+	FCircuit* Circuit = Circuits.Find(Action);
+	if(!Circuit || Circuit->State == EGameJoltCircuitState::Closed)
+		return true;
+
+	// Only the probe goes out while the circuit is half-open
+	if(Circuit->State == EGameJoltCircuitState::HalfOpen)
+		return false;
+
+	if(FPlatformTime::Seconds() - Circuit->OpenedTime < Cooldown)
+		return false;
+
+	Circuit->State = EGameJoltCircuitState::HalfOpen;
+	return true;
+}
+
+/* Closes the circuit of the action */
+void FGameJoltCircuitBreaker::RecordSuccess(EGameJoltComponentEnum Action)
+{
+	Circuits.Remove(Action);
+}
+
+/* Counts a failed request */
+void FGameJoltCircuitBreaker::RecordFailure(EGameJoltComponentEnum Action)
+{
+	FCircuit& Circuit = Circuits.FindOrAdd(Action);
+	Circuit.ConsecutiveFailures++;
+	if(Circuit.State == EGameJoltCircuitState::HalfOpen || Circuit.ConsecutiveFailures >= FailureThreshold)
+	{
+		Circuit.State = EGameJoltCircuitState::Open;
+		Circuit.OpenedTime = FPlatformTime::Seconds();
+	}
+}
+
+/* Gets the state of the circuit of an action */
+EGameJoltCircuitState FGameJoltCircuitBreaker::GetState(EGameJoltComponentEnum Action) const
+{
+	const FCircuit* Circuit = Circuits.Find(Action);
+	return Circuit ? Circuit->State : EGameJoltCircuitState::Closed;
+}
+
+/* Gets the amount of circuits which aren't closed */
+int32 FGameJoltCircuitBreaker::NumOpen() const
+{
+	int32 NumOpenCircuits = 0;
+	for(const TPair<EGameJoltComponentEnum, FCircuit>& Pair : Circuits)
+		NumOpenCircuits += Pair.Value.State != EGameJoltCircuitState::Closed ? 1 : 0;
+	return NumOpenCircuits;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/**
+ * One circuit per action. A circuit opens after a run of failed requests and makes further requests fail fast
+ * Once the cooldown elapsed a single probe is let through. Its outcome closes the circuit or opens it again
+ */
+class FGameJoltCircuitBreaker
+{
+public:
+
+	FGameJoltCircuitBreaker();
+
+	/**
+	 * @param InFailureThreshold Failed requests in a row which open a circuit
+	 * @param InCooldown Seconds an open circuit fails fast before it lets a probe through
+	 */
+	void Configure(int32 InFailureThreshold, float InCooldown);
+
+	/* Whether a request of the action may be sent. Lets the probe of a circuit whose cooldown elapsed through */
+	bool AllowRequest(EGameJoltComponentEnum Action);
+
+	/* Closes the circuit of the action, the server answered */
+	void RecordSuccess(EGameJoltComponentEnum Action);
+
+	/* Counts a failed request. Opens the circuit at the threshold, or right away if it was the probe */
+	void RecordFailure(EGameJoltComponentEnum Action);
+
+	/* Gets the state of the circuit of an action */
+	EGameJoltCircuitState GetState(EGameJoltComponentEnum Action) const;
+
+	/* Gets the amount of circuits which aren't closed */
+	int32 NumOpen() const;
+
+private:
+
+	struct FCircuit
+	{
+		EGameJoltCircuitState State;
+		int32 ConsecutiveFailures;
+
+		/* FPlatformTime::Seconds() when the circuit opened */
+		double OpenedTime;
+
+		FCircuit()
+			: State(EGameJoltCircuitState::Closed)
+			, ConsecutiveFailures(0)
+			, OpenedTime(0.0)
+		{
+		}
+	};
+
+	TMap<EGameJoltComponentEnum, FCircuit> Circuits;
+
+	int32 FailureThreshold;
+	float Cooldown;
+};
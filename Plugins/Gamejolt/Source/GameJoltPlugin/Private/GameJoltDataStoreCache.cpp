@@ -0,0 +1,303 @@
+#include "GameJoltDataStoreCache.h"
+
+/* Parses a whole number the way the server accepts it for numeric operations */
+static bool ParseInteger(const FString& Value, int64& OutValue)
+{
+	if(Value.IsEmpty() || !Value.IsNumeric() || Value.Contains(TEXT(".")))
+		return false;
+	OutValue = FCString::Atoi64(*Value);
+	return true;
+}
+
+/* Multiplies two numbers. Returns false if the product would overflow */
+static bool MultiplyChecked(int64 A, int64 B, int64& OutProduct)
+{
+	if(A != 0 && (FMath::Abs(B) > MAX_int64 / FMath::Abs(A) || A == MIN_int64 || B == MIN_int64))
+		return false;
+	OutProduct = A * B;
+	return true;
+}
+
+FGameJoltDataStoreCache::FGameJoltDataStoreCache()
+	: Merged(0)
+	, Sent(0)
+{
+}
+
+/* Gets the key of an entry */
+FString FGameJoltDataStoreCache::GetEntryKey(EDataStore Type, const FString& UserName, const FString& Key)
+{
+	if(Type == EDataStore::User)
+		return TEXT("user:") + UserName.ToLower() + TEXT("|") + Key;
+	return TEXT("global|") + Key;
+}
+
+/* Holds a write back, merging it with the held writes of its key */
+bool FGameJoltDataStoreCache::Add(const FString& EntryKey, EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write)
+{
+	FEntry& Entry = Entries.FindOrAdd(EntryKey);
+	Entry.Type = Type;
+	Entry.Key = Key;
+
+	// Sets and removes make every held write before them pointless
+	if(Write.Kind != EGameJoltDataWriteKind::Update && Entry.Held.Num() > 0)
+	{
+		Merged += Entry.Held.Num();
+		Entry.Held.Reset();
+		Entry.Held.Add(Write);
+		return true;
+	}
+
+	if(Entry.Held.Num() > 0 && Merge(Entry.Held.Last(), Write))
+	{
+		Merged++;
+		return true;
+	}
+
+	Entry.Held.Add(Write);
+	return false;
+}
+
+/* Whether a key has writes which are held back or being sent */
+bool FGameJoltDataStoreCache::HasWrites(const FString& EntryKey) const
+{
+	const FEntry* Entry = Entries.Find(EntryKey);
+	return Entry && (Entry->Held.Num() > 0 || Entry->Sending.Num() > 0);
+}
+
+/* Gets the data of a key after its writes */
+bool FGameJoltDataStoreCache::GetKnownData(const FString& EntryKey, bool& bOutExists, FString& OutData) const
+{
+	const FEntry* Entry = Entries.Find(EntryKey);
+	if(!Entry)
+		return false;
+
+	bool bKnown = false;
+	for(const TArray<FGameJoltDataWrite>* Writes : { &Entry->Sending, &Entry->Held })
+	{
+		for(const FGameJoltDataWrite& Write : *Writes)
+		{
+			switch(Write.Kind)
+			{
+				case EGameJoltDataWriteKind::Set:
+					bKnown = true;
+					bOutExists = true;
+					OutData = Write.Value;
+					break;
+				case EGameJoltDataWriteKind::Remove:
+					bKnown = true;
+					bOutExists = false;
+					OutData.Reset();
+					break;
+				case EGameJoltDataWriteKind::Update:
+					// Updates of missing keys or with invalid values fail and leave the data as it is
+					if(bKnown && bOutExists)
+						Apply(OutData, Write);
+					break;
+			}
+		}
+	}
+	return bKnown;
+}
+
+/* Gets the keys whose held writes can be sent */
+TArray<FString> FGameJoltDataStoreCache::GetFlushableKeys() const
+{
+	TArray<FString> Keys;
+	for(const TPair<FString, FEntry>& Pair : Entries)
+	{
+		if(Pair.Value.Held.Num() > 0 && Pair.Value.Sending.Num() == 0)
+			Keys.Add(Pair.Key);
+	}
+	return Keys;
+}
+
+/* Starts sending the held writes of a key */
+bool FGameJoltDataStoreCache::BeginSending(const FString& EntryKey)
+{
+	FEntry* Entry = Entries.Find(EntryKey);
+	if(!Entry || Entry->Held.Num() == 0 || Entry->Sending.Num() > 0)
+		return false;
+
+	Entry->Sending = MoveTemp(Entry->Held);
+	Entry->Held.Reset();
+	return true;
+}
+
+/* Gets the next write of a key to send */
+const FGameJoltDataWrite* FGameJoltDataStoreCache::GetNextToSend(const FString& EntryKey, EDataStore& OutType, FString& OutKey) const
+{
+	const FEntry* Entry = Entries.Find(EntryKey);
+	if(!Entry || Entry->Sending.Num() == 0)
+		return nullptr;
+
+	OutType = Entry->Type;
+	OutKey = Entry->Key;
+	return &Entry->Sending[0];
+}
+
+/* Removes the first write being sent, once it completed or was dropped */
+void FGameJoltDataStoreCache::OnSent(const FString& EntryKey)
+{
+	FEntry* Entry = Entries.Find(EntryKey);
+	if(Entry && Entry->Sending.Num() > 0)
+		Entry->Sending.RemoveAt(0, 1, false);
+}
+
+/* Adds a function which is called once all writes of a key have been sent */
+void FGameJoltDataStoreCache::AddWaiter(const FString& EntryKey, TFunction<void()> Waiter)
+{
+	Entries.FindOrAdd(EntryKey).Waiters.Add(MoveTemp(Waiter));
+}
+
+/* Whether a function waits for the writes of a key */
+bool FGameJoltDataStoreCache::HasWaiters(const FString& EntryKey) const
+{
+	const FEntry* Entry = Entries.Find(EntryKey);
+	return Entry && Entry->Waiters.Num() > 0;
+}
+
+/* Removes the functions waiting for a key whose writes have been sent */
+TArray<TFunction<void()>> FGameJoltDataStoreCache::TakeWaiters(const FString& EntryKey)
+{
+	TArray<TFunction<void()>> Waiters;
+	if(FEntry* Entry = Entries.Find(EntryKey))
+	{
+		if(Entry->Sending.Num() == 0 && Entry->Held.Num() == 0)
+			Waiters = MoveTemp(Entry->Waiters);
+	}
+	RemoveIfDone(EntryKey);
+	return Waiters;
+}
+
+/* Gets the amount of writes which are held back or being sent */
+int32 FGameJoltDataStoreCache::NumWrites() const
+{
+	int32 NumWrites = 0;
+	for(const TPair<FString, FEntry>& Pair : Entries)
+		NumWrites += Pair.Value.Held.Num() + Pair.Value.Sending.Num();
+	return NumWrites;
+}
+
+/* Merges a write into the write before it */
+bool FGameJoltDataStoreCache::Merge(FGameJoltDataWrite& Previous, const FGameJoltDataWrite& Write)
+{
+	if(Previous.Kind == EGameJoltDataWriteKind::Remove)
+		return false;
+
+	// The data of a set is known, so the update is applied to it right away
+	if(Previous.Kind == EGameJoltDataWriteKind::Set)
+		return Apply(Previous.Value, Write);
+
+	int64 PreviousValue = 0;
+	int64 Value = 0;
+	const bool bNumeric = ParseInteger(Previous.Value, PreviousValue) && ParseInteger(Write.Value, Value);
+	switch(Previous.Operation)
+	{
+		case EDataOperation::add:
+		case EDataOperation::substract:
+		{
+			if(!bNumeric || (Write.Operation != EDataOperation::add && Write.Operation != EDataOperation::substract))
+				return false;
+
+			// Summed up as a single signed offset, sent as whichever of both operations keeps the value positive
+			const int64 Offset = (Previous.Operation == EDataOperation::add ? PreviousValue : -PreviousValue) + (Write.Operation == EDataOperation::add ? Value : -Value);
+			Previous.Operation = Offset < 0 ? EDataOperation::substract : EDataOperation::add;
+			Previous.Value = FString::Printf(TEXT("%lld"), FMath::Abs(Offset));
+			return true;
+		}
+		case EDataOperation::multiply:
+		{
+			int64 Product = 0;
+			if(!bNumeric)
+				return false;
+			if(Write.Operation == EDataOperation::multiply && MultiplyChecked(PreviousValue, Value, Product))
+			{
+				Previous.Value = FString::Printf(TEXT("%lld"), Product);
+				return true;
+			}
+			// Dividing a product by one of its factors leaves the other factor, without any rounding
+			if(Write.Operation == EDataOperation::divide && Value != 0 && PreviousValue % Value == 0)
+			{
+				Previous.Value = FString::Printf(TEXT("%lld"), PreviousValue / Value);
+				return true;
+			}
+			return false;
+		}
+		case EDataOperation::divide:
+		{
+			// Whole number divisions truncate the same way in one step as in two
+			int64 Divisor = 0;
+			if(!bNumeric || Write.Operation != EDataOperation::divide || Value == 0 || !MultiplyChecked(PreviousValue, Value, Divisor))
+				return false;
+			Previous.Value = FString::Printf(TEXT("%lld"), Divisor);
+			return true;
+		}
+		case EDataOperation::append:
+			if(Write.Operation != EDataOperation::append)
+				return false;
+			Previous.Value += Write.Value;
+			return true;
+		case EDataOperation::prepend:
+			if(Write.Operation != EDataOperation::prepend)
+				return false;
+			Previous.Value = Write.Value + Previous.Value;
+			return true;
+	}
+	return false;
+}
+
+/* Applies an update to data the way the server does */
+bool FGameJoltDataStoreCache::Apply(FString& Data, const FGameJoltDataWrite& Write)
+{
+	if(Write.Kind != EGameJoltDataWriteKind::Update)
+		return false;
+
+	if(Write.Operation == EDataOperation::append)
+	{
+		Data += Write.Value;
+		return true;
+	}
+	if(Write.Operation == EDataOperation::prepend)
+	{
+		Data = Write.Value + Data;
+		return true;
+	}
+
+	int64 Current = 0;
+	int64 Value = 0;
+	if(!ParseInteger(Data, Current) || !ParseInteger(Write.Value, Value))
+		return false;
+
+	int64 Result = 0;
+	switch(Write.Operation)
+	{
+		case EDataOperation::add:
+			Result = Current + Value;
+			break;
+		case EDataOperation::substract:
+			Result = Current - Value;
+			break;
+		case EDataOperation::multiply:
+			if(!MultiplyChecked(Current, Value, Result))
+				return false;
+			break;
+		case EDataOperation::divide:
+			if(Value == 0)
+				return false;
+			Result = Current / Value;
+			break;
+		default:
+			return false;
+	}
+	Data = FString::Printf(TEXT("%lld"), Result);
+	return true;
+}
+
+/* Removes an entry without any writes or waiters */
+void FGameJoltDataStoreCache::RemoveIfDone(const FString& EntryKey)
+{
+	const FEntry* Entry = Entries.Find(EntryKey);
+	if(Entry && Entry->Held.Num() == 0 && Entry->Sending.Num() == 0 && Entry->Waiters.Num() == 0)
+		Entries.Remove(EntryKey);
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/* The kinds of data-store writes */
+enum class EGameJoltDataWriteKind : uint8
+{
+	Set,
+	Update,
+	Remove
+};
+
+/* A single data-store write which hasn't been sent yet */
+struct FGameJoltDataWrite
+{
+	EGameJoltDataWriteKind Kind;
+
+	/* The operation of an update */
+	EDataOperation Operation;
+
+	/* The data of a set, or the value of an update */
+	FString Value;
+
+	FGameJoltDataWrite()
+		: Kind(EGameJoltDataWriteKind::Set)
+		, Operation(EDataOperation::add)
+	{
+	}
+};
+
+/**
+ * Write-behind cache of data-store writes
+ * Writes are held per key and merged with the write before them: adds and subtracts are summed, multiplies and divides folded,
+ * appends and prepends concatenated, and a set or remove replaces everything before it. Updates after a set are applied to its data
+ * Held writes of a key are sent one after another, so the server applies them in order
+ */
+class FGameJoltDataStoreCache
+{
+public:
+
+	FGameJoltDataStoreCache();
+
+	/* Gets the key of an entry. User data is kept apart per user */
+	static FString GetEntryKey(EDataStore Type, const FString& UserName, const FString& Key);
+
+	/**
+	 * Holds a write back, merging it with the held writes of its key
+	 * @return Whether the write was merged, so it won't be sent on its own
+	 */
+	bool Add(const FString& EntryKey, EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write);
+
+	/* Whether a key has writes which are held back or being sent */
+	bool HasWrites(const FString& EntryKey) const;
+
+	/**
+	 * Gets the data of a key after its writes, if it doesn't depend on the data on the server
+	 * @param bOutExists Whether the key exists after its writes
+	 * @return Whether the data is known. False if the writes start with an update
+	 */
+	bool GetKnownData(const FString& EntryKey, bool& bOutExists, FString& OutData) const;
+
+	/* Gets the keys whose held writes can be sent, because none of their writes are being sent */
+	TArray<FString> GetFlushableKeys() const;
+
+	/**
+	 * Starts sending the held writes of a key
+	 * @return False if there aren't any or the key's writes are being sent already
+	 */
+	bool BeginSending(const FString& EntryKey);
+
+	/**
+	 * Gets the next write of a key to send
+	 * @return Null if all writes of the key have been sent
+	 */
+	const FGameJoltDataWrite* GetNextToSend(const FString& EntryKey, EDataStore& OutType, FString& OutKey) const;
+
+	/* Removes the first write being sent, once it completed or was dropped */
+	void OnSent(const FString& EntryKey);
+
+	/* Adds a function which is called once all writes of a key, including the held ones, have been sent */
+	void AddWaiter(const FString& EntryKey, TFunction<void()> Waiter);
+
+	/* Whether a function waits for the writes of a key */
+	bool HasWaiters(const FString& EntryKey) const;
+
+	/* Removes the functions waiting for a key whose writes have been sent */
+	TArray<TFunction<void()>> TakeWaiters(const FString& EntryKey);
+
+	/* Gets the amount of writes which are held back or being sent */
+	int32 NumWrites() const;
+
+	/* The amount of writes merged into a write before them */
+	int32 Merged;
+
+	/* The amount of writes sent to the server */
+	int32 Sent;
+
+private:
+
+	/* The writes of a single key */
+	struct FEntry
+	{
+		EDataStore Type;
+		FString Key;
+
+		/* Writes held back, merged as far as possible */
+		TArray<FGameJoltDataWrite> Held;
+
+		/* Writes being sent, in order */
+		TArray<FGameJoltDataWrite> Sending;
+
+		/* Functions called once all writes have been sent */
+		TArray<TFunction<void()>> Waiters;
+	};
+
+	/**
+	 * Merges a write into the write before it
+	 * @return Whether the write could be merged
+	 */
+	static bool Merge(FGameJoltDataWrite& Previous, const FGameJoltDataWrite& Write);
+
+	/**
+	 * Applies an update to data the way the server does
+	 * @return Whether the server would succeed
+	 */
+	static bool Apply(FString& Data, const FGameJoltDataWrite& Write);
+
+	/* Removes an entry without any writes or waiters */
+	void RemoveIfDone(const FString& EntryKey);
+
+	TMap<FString, FEntry> Entries;
+};
@@ -0,0 +1,182 @@
+#include "GameJoltDataStoreMirror.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+
+/* Constructor */
+UGameJoltDataStoreMirror::UGameJoltDataStoreMirror(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	MaxParallelFetches = 4;
+	API = nullptr;
+	Type = EDataStore::Global;
+	NextKeyIndex = 0;
+	NumFetching = 0;
+	NumFailed = 0;
+	bSyncing = false;
+}
+
+/* Creates a mirror of the keys under a prefix */
+UGameJoltDataStoreMirror* UGameJoltDataStoreMirror::CreateDataStoreMirror(UUEGameJoltAPI* API, EDataStore Type, const FString& Prefix, int32 MaxParallelFetches)
+{
+	if(!API)
+	{
+		UE_LOG(GJAPI, Error, TEXT("A data-store mirror needs an API instance to fetch its data with"));
+		return nullptr;
+	}
+
+	UGameJoltDataStoreMirror* Mirror = NewObject<UGameJoltDataStoreMirror>(API);
+	Mirror->API = API;
+	Mirror->Type = Type;
+	Mirror->Prefix = Prefix;
+	Mirror->MaxParallelFetches = FMath::Max(MaxParallelFetches, 1);
+	return Mirror;
+}
+
+/* Fetches all keys under the prefix and their data */
+bool UGameJoltDataStoreMirror::Sync()
+{
+	if(!API || bSyncing)
+		return false;
+
+	// The server matches the pattern against the whole key, * matches any text
+	FGameJoltQueryBuilder Query(TEXT("/data-store/get-keys/"));
+	if(!Prefix.IsEmpty())
+		Query.Add(TEXT("pattern"), Prefix + TEXT("*"));
+
+	TWeakObjectPtr<UGameJoltDataStoreMirror> WeakThis(this);
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_KEYS, Query.Build(), Type == EDataStore::User,
+		[WeakThis](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnKeysFetched(CompletedRequest);
+		}, FString(), true);
+
+	if(!GameJoltRequest.IsValid())
+		return false;
+
+	bSyncing = true;
+	SyncKeys.Reset();
+	NextKeyIndex = 0;
+	NumFailed = 0;
+	WrittenKeys.Reset();
+	return true;
+}
+
+/* Gets the mirrored data of a key */
+bool UGameJoltDataStoreMirror::GetData(const FString& Key, FString& Data) const
+{
+	const FString* Value = Values.Find(Key);
+	if(!Value)
+		return false;
+	Data = *Value;
+	return true;
+}
+
+/* Gets all mirrored keys */
+TArray<FString> UGameJoltDataStoreMirror::GetKeys() const
+{
+	TArray<FString> Keys;
+	Values.GenerateKeyArray(Keys);
+	return Keys;
+}
+
+/* Sets the data of a key in the mirror and on the server */
+void UGameJoltDataStoreMirror::SetData(const FString& Key, const FString& Data)
+{
+	Values.Add(Key, Data);
+	if(bSyncing)
+		WrittenKeys.Add(Key);
+	if(API)
+		API->SetData(Type, Key, Data);
+}
+
+/* Removes a key from the mirror and the server */
+void UGameJoltDataStoreMirror::RemoveData(const FString& Key)
+{
+	Values.Remove(Key);
+	if(bSyncing)
+		WrittenKeys.Add(Key);
+	if(API)
+		API->RemoveData(Type, Key);
+}
+
+/* Whether a sync is running */
+bool UGameJoltDataStoreMirror::IsSyncing() const
+{
+	return bSyncing;
+}
+
+/* Callback of the key fetch */
+void UGameJoltDataStoreMirror::OnKeysFetched(const FGameJoltRequest& GameJoltRequest)
+{
+	if(!GameJoltRequest.bSucceeded || !FGameJoltResponseDecoder::DecodeDataKeys(GameJoltRequest.Response, SyncKeys))
+	{
+		bSyncing = false;
+		OnSyncFailed.Broadcast(0);
+		return;
+	}
+
+	// Keys removed on the server are gone from the mirror as well, unless they were written since
+	const TSet<FString> ServerKeys(SyncKeys);
+	for(auto It = Values.CreateIterator(); It; ++It)
+	{
+		if(!ServerKeys.Contains(It.Key()) && !WrittenKeys.Contains(It.Key()))
+			It.RemoveCurrent();
+	}
+
+	FetchNextKeys();
+	if(NumFetching == 0)
+		FinishSync();
+}
+
+/* Fetches the data of the next keys until the limit of requests in flight is reached */
+void UGameJoltDataStoreMirror::FetchNextKeys()
+{
+	TWeakObjectPtr<UGameJoltDataStoreMirror> WeakThis(this);
+	while(NumFetching < MaxParallelFetches && NextKeyIndex < SyncKeys.Num())
+	{
+		const FString Key = SyncKeys[NextKeyIndex++];
+		if(WrittenKeys.Contains(Key))
+			continue;
+
+		const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_FETCH,
+			FGameJoltQueryBuilder(TEXT("/data-store/")).Add(TEXT("key"), Key).Build(), Type == EDataStore::User,
+			[WeakThis, Key](const FGameJoltRequest& CompletedRequest)
+			{
+				if(WeakThis.IsValid())
+					WeakThis->OnDataFetched(CompletedRequest, Key);
+			}, FString(), true);
+
+		if(GameJoltRequest.IsValid())
+			NumFetching++;
+		else
+			NumFailed++;
+	}
+}
+
+/* Callback of a data fetch */
+void UGameJoltDataStoreMirror::OnDataFetched(const FGameJoltRequest& GameJoltRequest, const FString& Key)
+{
+	NumFetching--;
+	if(!GameJoltRequest.bSucceeded || !GameJoltRequest.Response.IsValid())
+		NumFailed++;
+	else if(!WrittenKeys.Contains(Key))
+		Values.Add(Key, FGameJoltResponseDecoder::DecodeString(*GameJoltRequest.Response, TEXT("data")));
+
+	FetchNextKeys();
+	if(NumFetching == 0 && NextKeyIndex >= SyncKeys.Num())
+		FinishSync();
+}
+
+/* Broadcasts the result of the sync once all fetches completed */
+void UGameJoltDataStoreMirror::FinishSync()
+{
+	bSyncing = false;
+	WrittenKeys.Reset();
+	SyncKeys.Reset();
+
+	if(NumFailed > 0)
+		OnSyncFailed.Broadcast(NumFailed);
+	else
+		OnSynced.Broadcast(Values.Num());
+}
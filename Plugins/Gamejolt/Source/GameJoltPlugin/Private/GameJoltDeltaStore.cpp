@@ -0,0 +1,236 @@
+#include "GameJoltDeltaStore.h"
+#include "GameJoltPluginModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/* "GJCI", the first bytes of every uploaded chunk list */
+static const uint32 DeltaIndexMagic = 0x49434A47;
+
+/* "GJDI", the first bytes of every local chunk list */
+static const uint32 DeltaServerIndexMagic = 0x49444A47;
+
+/* The version of both formats. Chunk lists of other versions are discarded */
+static const uint8 DeltaIndexVersion = 1;
+
+/* Random values the rolling hash adds per byte. Generated from a fixed seed, so every device places the same boundaries */
+struct FGearTable
+{
+	uint64 Values[256];
+
+	FGearTable()
+	{
+		uint64 State = 0x4A6F6C7447616D65ull;
+		for(uint64& Value : Values)
+		{
+			// SplitMix64
+			State += 0x9E3779B97F4A7C15ull;
+			uint64 Mixed = State;
+			Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+			Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBull;
+			Value = Mixed ^ (Mixed >> 31);
+		}
+	}
+};
+
+FGameJoltDeltaStore::FGameJoltDeltaStore(const FString& InDirectory)
+	: Directory(InDirectory)
+{
+}
+
+/* Splits data into content-defined chunks */
+void FGameJoltDeltaStore::Split(const TArray<uint8>& Data, int32 MaxChunkSize, TArray<FGameJoltContentChunk>& OutChunks)
+{
+	static const FGearTable Gear;
+
+	// A boundary is found about every MinSize bytes past the minimum, so chunks are half the maximum on average
+	const int32 MaxSize = FMath::Max(MaxChunkSize, 256);
+	const int32 MinSize = MaxSize / 4;
+	const uint32 MaskBits = FMath::FloorLog2(MinSize);
+
+	OutChunks.Reset();
+	int32 Start = 0;
+	while(Start < Data.Num())
+	{
+		const int32 End = FMath::Min(Start + MaxSize, Data.Num());
+		int32 Cut = End;
+
+		// Every byte is shifted out of the hash after 64 more, so hashing starts shortly before the minimum size
+		uint64 Hash = 0;
+		for(int32 i = FMath::Max(Start, Start + MinSize - 64); i < End; i++)
+		{
+			Hash = (Hash << 1) + Gear.Values[Data[i]];
+			if(i >= Start + MinSize && (Hash >> (64 - MaskBits)) == 0)
+			{
+				Cut = i + 1;
+				break;
+			}
+		}
+
+		FGameJoltContentChunk& Chunk = OutChunks.AddDefaulted_GetRef();
+		Chunk.Hash = HashChunk(Data.GetData() + Start, Cut - Start);
+		Chunk.Size = Cut - Start;
+		Start = Cut;
+	}
+}
+
+/* Hashes the bytes of a chunk */
+FString FGameJoltDeltaStore::HashChunk(const uint8* Data, int32 Size)
+{
+	// 64 bits of a SHA-1 keep the keys short, collisions within a single blob are out of reach
+	uint8 Hash[20];
+	FSHA1::HashBuffer(Data, Size, Hash);
+	return BytesToHex(Hash, 8);
+}
+
+/* Serializes a chunk list in the format it is uploaded in */
+void FGameJoltDeltaStore::SerializeIndex(const TArray<FGameJoltContentChunk>& Chunks, TArray<uint8>& OutBytes)
+{
+	FMemoryWriter Writer(OutBytes);
+	uint32 Magic = DeltaIndexMagic;
+	uint8 Version = DeltaIndexVersion;
+	TArray<FGameJoltContentChunk> IndexChunks = Chunks;
+	Writer << Magic << Version;
+	SerializeChunks(Writer, IndexChunks);
+}
+
+/* Reads an uploaded chunk list */
+bool FGameJoltDeltaStore::DeserializeIndex(const TArray<uint8>& Bytes, TArray<FGameJoltContentChunk>& OutChunks)
+{
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	Reader << Magic << Version;
+	if(Reader.IsError() || Magic != DeltaIndexMagic || Version != DeltaIndexVersion)
+		return false;
+
+	SerializeChunks(Reader, OutChunks);
+	return !Reader.IsError();
+}
+
+/* Gets the chunk list the server held after the last delta save or load of a blob */
+bool FGameJoltDeltaStore::GetServerIndex(const FString& Scope, const FString& Name, FString& OutVersion, TArray<FGameJoltContentChunk>& OutChunks) const
+{
+	TArray<uint8> Bytes;
+	const FString Filename = FPaths::Combine(GetBlobDirectory(Scope, Name), TEXT("Index.gjdi"));
+	if(!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	Reader << Magic << Version;
+	if(!Reader.IsError() && Magic == DeltaServerIndexMagic && Version == DeltaIndexVersion)
+	{
+		Reader << OutVersion;
+		SerializeChunks(Reader, OutChunks);
+		if(!Reader.IsError())
+			return true;
+	}
+
+	UE_LOG(GJAPI, Warning, TEXT("Discarding the invalid chunk list %s"), *Filename);
+	OutVersion.Reset();
+	OutChunks.Reset();
+	return false;
+}
+
+/* Records the chunk list the server holds now */
+void FGameJoltDeltaStore::SetServerIndex(const FString& Scope, const FString& Name, const FString& Version, const TArray<FGameJoltContentChunk>& Chunks)
+{
+	const FString BlobDirectory = GetBlobDirectory(Scope, Name);
+
+	FString PreviousVersion;
+	TArray<FGameJoltContentChunk> PreviousChunks;
+	GetServerIndex(Scope, Name, PreviousVersion, PreviousChunks);
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = DeltaServerIndexMagic;
+	uint8 FormatVersion = DeltaIndexVersion;
+	FString BlobVersion = Version;
+	TArray<FGameJoltContentChunk> IndexChunks = Chunks;
+	Writer << Magic << FormatVersion << BlobVersion;
+	SerializeChunks(Writer, IndexChunks);
+
+	// Written next to the chunk list first, so a crash can't leave a torn file behind
+	const FString Filename = FPaths::Combine(BlobDirectory, TEXT("Index.gjdi"));
+	const FString TempFilename = Filename + TEXT(".tmp");
+	if(!FFileHelper::SaveArrayToFile(Bytes, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true))
+	{
+		UE_LOG(GJAPI, Error, TEXT("Failed to write the chunk list %s"), *Filename);
+		return;
+	}
+
+	TSet<FString> Hashes;
+	for(const FGameJoltContentChunk& Chunk : Chunks)
+		Hashes.Add(Chunk.Hash);
+	for(const FGameJoltContentChunk& Chunk : PreviousChunks)
+	{
+		if(!Hashes.Contains(Chunk.Hash))
+			IFileManager::Get().Delete(*FPaths::Combine(BlobDirectory, Chunk.Hash + TEXT(".chunk")), false, false, true);
+	}
+}
+
+/* Reads a kept chunk */
+bool FGameJoltDeltaStore::LoadChunk(const FString& Scope, const FString& Name, const FGameJoltContentChunk& Chunk, TArray<uint8>& OutData) const
+{
+	const FString Filename = FPaths::Combine(GetBlobDirectory(Scope, Name), Chunk.Hash + TEXT(".chunk"));
+	if(!FFileHelper::LoadFileToArray(OutData, *Filename, FILEREAD_Silent))
+		return false;
+
+	if(OutData.Num() != Chunk.Size || HashChunk(OutData.GetData(), OutData.Num()) != Chunk.Hash)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Discarding the damaged chunk %s"), *Filename);
+		IFileManager::Get().Delete(*Filename, false, false, true);
+		OutData.Reset();
+		return false;
+	}
+	return true;
+}
+
+/* Keeps a chunk on disk */
+void FGameJoltDeltaStore::StoreChunk(const FString& Scope, const FString& Name, const FString& Hash, const uint8* Data, int32 Size) const
+{
+	const FString Filename = FPaths::Combine(GetBlobDirectory(Scope, Name), Hash + TEXT(".chunk"));
+	if(IFileManager::Get().FileExists(*Filename))
+		return;
+
+	// Chunks are named by their content, so a torn file is caught by its hash when it is read
+	if(!FFileHelper::SaveArrayToFile(TArrayView<const uint8>(Data, Size), *Filename))
+		UE_LOG(GJAPI, Error, TEXT("Failed to write the chunk %s"), *Filename);
+}
+
+/* Serializes a chunk list */
+void FGameJoltDeltaStore::SerializeChunks(FArchive& Ar, TArray<FGameJoltContentChunk>& Chunks)
+{
+	int32 NumChunks = Chunks.Num();
+	Ar << NumChunks;
+	if(Ar.IsLoading())
+	{
+		if(NumChunks < 0 || NumChunks > Ar.TotalSize())
+		{
+			Ar.SetError();
+			return;
+		}
+		Chunks.SetNum(NumChunks);
+	}
+
+	for(FGameJoltContentChunk& Chunk : Chunks)
+	{
+		Ar << Chunk.Hash << Chunk.Size;
+		if(Ar.IsLoading() && (Chunk.Hash.IsEmpty() || Chunk.Size <= 0))
+		{
+			Ar.SetError();
+			return;
+		}
+	}
+}
+
+/* Gets the directory of a blob's chunk list and chunks */
+FString FGameJoltDeltaStore::GetBlobDirectory(const FString& Scope, const FString& Name) const
+{
+	return FPaths::Combine(Directory, FPaths::MakeValidFileName(Scope), FPaths::MakeValidFileName(Name));
+}
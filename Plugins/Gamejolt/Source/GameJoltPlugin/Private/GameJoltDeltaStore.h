@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* A content-defined chunk of a blob */
+struct FGameJoltContentChunk
+{
+	/* Hash of the chunk's bytes. Chunks with the same content share it, and with it their key on the server */
+	FString Hash;
+
+	/* Size of the chunk in bytes */
+	int32 Size;
+
+	FGameJoltContentChunk()
+		: Size(0)
+	{
+	}
+};
+
+/**
+ * Local side of delta-synced blobs
+ * Blobs are split into content-defined chunks: a boundary is placed wherever a rolling hash of the last bytes matches a mask,
+ * so an edit only changes the chunks around it and every chunk after it keeps its boundaries and hash
+ * The chunk list the server holds is remembered per blob, and the chunks are kept on disk, so saves only upload chunks the server doesn't hold
+ * and loads only fetch chunks which aren't kept locally
+ */
+class FGameJoltDeltaStore
+{
+public:
+
+	/* @param InDirectory The directory the chunk lists and chunks are stored in */
+	explicit FGameJoltDeltaStore(const FString& InDirectory);
+
+	/**
+	 * Splits data into content-defined chunks
+	 * @param MaxChunkSize No chunk is larger. Chunks are about half as large on average
+	 */
+	static void Split(const TArray<uint8>& Data, int32 MaxChunkSize, TArray<FGameJoltContentChunk>& OutChunks);
+
+	/* Hashes the bytes of a chunk */
+	static FString HashChunk(const uint8* Data, int32 Size);
+
+	/* Serializes a chunk list in the format it is uploaded in */
+	static void SerializeIndex(const TArray<FGameJoltContentChunk>& Chunks, TArray<uint8>& OutBytes);
+
+	/* Reads an uploaded chunk list. Returns false if it is invalid */
+	static bool DeserializeIndex(const TArray<uint8>& Bytes, TArray<FGameJoltContentChunk>& OutChunks);
+
+	/**
+	 * Gets the chunk list the server held after the last delta save or load of a blob on this device
+	 * @param Scope Keeps the blobs of different users apart
+	 * @return False if the blob hasn't been synced on this device yet
+	 */
+	bool GetServerIndex(const FString& Scope, const FString& Name, FString& OutVersion, TArray<FGameJoltContentChunk>& OutChunks) const;
+
+	/* Records the chunk list the server holds now. Kept chunks which are no longer part of the blob are removed */
+	void SetServerIndex(const FString& Scope, const FString& Name, const FString& Version, const TArray<FGameJoltContentChunk>& Chunks);
+
+	/* Reads a kept chunk. Returns false if it is missing or doesn't match its hash */
+	bool LoadChunk(const FString& Scope, const FString& Name, const FGameJoltContentChunk& Chunk, TArray<uint8>& OutData) const;
+
+	/* Keeps a chunk on disk, unless it is kept already */
+	void StoreChunk(const FString& Scope, const FString& Name, const FString& Hash, const uint8* Data, int32 Size) const;
+
+private:
+
+	/* Serializes a chunk list */
+	static void SerializeChunks(FArchive& Ar, TArray<FGameJoltContentChunk>& Chunks);
+
+	/* Gets the directory of a blob's chunk list and chunks */
+	FString GetBlobDirectory(const FString& Scope, const FString& Name) const;
+
+	FString Directory;
+};
@@ -0,0 +1,662 @@
+#include "GameJoltFakeServer.h"
+#include "GameJoltRequestBuilder.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeLock.h"
+
+/* Gets a decoded parameter. Empty if it isn't set */
+static FString GetParameter(const TMultiMap<FString, FString>& Parameters, const TCHAR* Key)
+{
+	const FString* Value = Parameters.Find(Key);
+	return Value ? *Value : FString();
+}
+
+/* Creates the response of a request the server rejected */
+static TSharedRef<FJsonObject> MakeFailure(const FString& Message)
+{
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("success"), TEXT("false"));
+	Response->SetStringField(TEXT("message"), Message);
+	return Response;
+}
+
+/* Creates the response of a successful request */
+static TSharedRef<FJsonObject> MakeSuccess()
+{
+	TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+	Response->SetStringField(TEXT("success"), TEXT("true"));
+	return Response;
+}
+
+/* Gets the current time as a unix timestamp */
+static int64 GetUnixNow()
+{
+	return FDateTime::UtcNow().ToUnixTimestamp();
+}
+
+FGameJoltFakeServer::FGameJoltFakeServer(int32 InGameID, const FString& InPrivateKey, const FString& InUrlPrefix)
+	: GameID(InGameID)
+	, PrivateKey(InPrivateKey)
+	, UrlPrefix(InUrlPrefix)
+	, NumRequests(0)
+{
+}
+
+/* Creates a fake server and registers it with the core ticker */
+TSharedRef<FGameJoltFakeServer, ESPMode::ThreadSafe> FGameJoltFakeServer::Create(int32 InGameID, const FString& InPrivateKey, const FString& InUrlPrefix)
+{
+	check(IsInGameThread());
+	TSharedRef<FGameJoltFakeServer, ESPMode::ThreadSafe> Server = MakeShareable(new FGameJoltFakeServer(InGameID, InPrivateKey, InUrlPrefix));
+
+	// The ticker only holds a weak pointer and removes itself on the game thread once the server is gone, wherever it was released
+	TWeakPtr<FGameJoltFakeServer, ESPMode::ThreadSafe> WeakServer = Server;
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakServer](float DeltaTime)
+	{
+		TSharedPtr<FGameJoltFakeServer, ESPMode::ThreadSafe> Pinned = WeakServer.Pin();
+		return Pinned.IsValid() && Pinned->Tick(DeltaTime);
+	}));
+	return Server;
+}
+
+/* Adds a user who can log in */
+int32 FGameJoltFakeServer::AddUser(const FString& UserName, const FString& UserToken)
+{
+	FFakeUser& User = Users.AddDefaulted_GetRef();
+	User.Id = Users.Num();
+	User.Name = UserName;
+	User.Token = UserToken;
+	User.SignedUp = GetUnixNow();
+	User.LastLoggedIn = User.SignedUp;
+	User.bSessionOpen = false;
+	return User.Id;
+}
+
+/* Makes two users friends of each other */
+void FGameJoltFakeServer::AddFriends(int32 UserID, int32 FriendID)
+{
+	if(!Users.IsValidIndex(UserID - 1) || !Users.IsValidIndex(FriendID - 1))
+		return;
+	Users[UserID - 1].FriendIDs.AddUnique(FriendID);
+	Users[FriendID - 1].FriendIDs.AddUnique(UserID);
+}
+
+/* Adds a trophy which can be achieved */
+void FGameJoltFakeServer::AddTrophy(int32 TrophyID, const FString& Title, const FString& Difficulty)
+{
+	FFakeTrophy& Trophy = Trophies.AddDefaulted_GetRef();
+	Trophy.Id = TrophyID;
+	Trophy.Title = Title;
+	Trophy.Difficulty = Difficulty;
+}
+
+/* Adds a scoreboard */
+void FGameJoltFakeServer::AddScoreTable(int32 TableID, const FString& Name, bool bPrimary)
+{
+	if(bPrimary)
+	{
+		for(FFakeTable& Table : Tables)
+			Table.bPrimary = false;
+	}
+
+	FFakeTable& Table = Tables.AddDefaulted_GetRef();
+	Table.Id = TableID;
+	Table.Name = Name;
+	Table.bPrimary = bPrimary || Tables.Num() == 1;
+}
+
+/* Adds a score of a guest to a scoreboard */
+void FGameJoltFakeServer::AddGuestScore(int32 TableID, const FString& Score, int32 Sort, const FString& Guest)
+{
+	FFakeTable* Table = Tables.FindByPredicate([TableID](const FFakeTable& Candidate) { return Candidate.Id == TableID; });
+	if(!Table)
+		return;
+
+	FFakeScore NewScore;
+	NewScore.Score = Score;
+	NewScore.Sort = Sort;
+	NewScore.UserID = 0;
+	NewScore.Guest = Guest;
+	NewScore.Stored = GetUnixNow();
+	InsertScore(*Table, NewScore);
+}
+
+/* Adds a score of a user to a scoreboard */
+void FGameJoltFakeServer::AddUserScore(int32 TableID, const FString& Score, int32 Sort, int32 UserID)
+{
+	FFakeTable* Table = Tables.FindByPredicate([TableID](const FFakeTable& Candidate) { return Candidate.Id == TableID; });
+	if(!Table || !Users.IsValidIndex(UserID - 1))
+		return;
+
+	FFakeScore NewScore;
+	NewScore.Score = Score;
+	NewScore.Sort = Sort;
+	NewScore.UserID = UserID;
+	NewScore.UserName = Users[UserID - 1].Name;
+	NewScore.Stored = GetUnixNow();
+	InsertScore(*Table, NewScore);
+}
+
+/* Inserts a score behind all scores which are at least as good */
+FGameJoltFakeServer::FFakeScore& FGameJoltFakeServer::InsertScore(FFakeTable& Table, const FFakeScore& Score)
+{
+	int32 Index = 0;
+	while(Index < Table.Scores.Num() && Table.Scores[Index].Sort >= Score.Sort)
+		Index++;
+	Table.Scores.Insert(Score, Index);
+	return Table.Scores[Index];
+}
+
+/* Gets the amount of requests received */
+int32 FGameJoltFakeServer::GetNumRequests() const
+{
+	return NumRequests;
+}
+
+/* Queues a request, it is answered on the next tick */
+void FGameJoltFakeServer::Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete)
+{
+	FScopeLock ScopeLock(&QueueLock);
+	FQueuedRequest& Request = QueuedRequests.AddDefaulted_GetRef();
+	Request.Url = Url;
+	Request.OnComplete = MoveTemp(OnComplete);
+}
+
+/* Answers the queued requests */
+bool FGameJoltFakeServer::Tick(float DeltaTime)
+{
+	TArray<FQueuedRequest> Requests;
+	{
+		FScopeLock ScopeLock(&QueueLock);
+		Requests = MoveTemp(QueuedRequests);
+		QueuedRequests.Reset();
+	}
+
+	for(FQueuedRequest& Request : Requests)
+	{
+		const FString Response = HandleUrl(Request.Url);
+		if(!Request.OnComplete)
+			continue;
+
+		FTCHARToUTF8 Converted(*Response);
+		TArray<uint8> Content(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		Request.OnComplete(true, 200, Content);
+	}
+	return true;
+}
+
+/* Handles a request and serializes the response */
+FString FGameJoltFakeServer::HandleUrl(const FString& Url)
+{
+	NumRequests++;
+
+	FString Path;
+	TMultiMap<FString, FString> Parameters;
+	TSharedPtr<FJsonObject> Response = ParseUrl(Url, true, Path, Parameters);
+	if(!Response.IsValid())
+		Response = Path == TEXT("/batch/") ? HandleBatch(Parameters) : HandleEndpoint(Path, Parameters);
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetObjectField(TEXT("response"), Response);
+
+	FString Content;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Content);
+	FJsonSerializer::Serialize(Root, JsonWriter);
+	return Content;
+}
+
+/* Checks the game id and signature of a URL and splits it into its path and decoded parameters */
+TSharedPtr<FJsonObject> FGameJoltFakeServer::ParseUrl(const FString& Url, bool bWithPrefix, FString& OutPath, TMultiMap<FString, FString>& OutParameters) const
+{
+	if(bWithPrefix && !Url.StartsWith(UrlPrefix, ESearchCase::CaseSensitive))
+		return MakeFailure(TEXT("Unknown API version or server."));
+
+	// The signature covers everything before it, the server included
+	const int32 SignatureStart = Url.Find(TEXT("&signature="), ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if(SignatureStart == INDEX_NONE)
+		return MakeFailure(TEXT("You must enter the signature for the request."));
+
+	const FString Signature = Url.Mid(SignatureStart + 11);
+	FGameJoltRequestSigner Signer;
+	Signer.Configure(FString(), FString(), FString(), GameID, PrivateKey, Signature.Len() == 40 ? EGameJoltSignatureAlgorithm::SHA1 : EGameJoltSignatureAlgorithm::MD5);
+	FString Expected = Url.Left(SignatureStart);
+	Signer.AppendSignature(Expected);
+	if(!Expected.Equals(Url, ESearchCase::IgnoreCase))
+		return MakeFailure(TEXT("The signature you entered for the request is invalid."));
+
+	const FString Signed = Url.Left(SignatureStart);
+	const FString Relative = bWithPrefix ? Signed.RightChop(UrlPrefix.Len()) : Signed;
+	FString Query;
+	if(!Relative.Split(TEXT("?"), &OutPath, &Query))
+		OutPath = Relative;
+	if(!OutPath.EndsWith(TEXT("/")))
+		OutPath += TEXT("/");
+
+	TArray<FString> Pairs;
+	Query.ParseIntoArray(Pairs, TEXT("&"));
+	for(const FString& Pair : Pairs)
+	{
+		FString Key;
+		FString Value;
+		if(!Pair.Split(TEXT("="), &Key, &Value))
+			Key = Pair;
+		OutParameters.Add(FGameJoltQueryBuilder::Decode(Key), FGameJoltQueryBuilder::Decode(Value));
+	}
+
+	if(FCString::Atoi(*GetParameter(OutParameters, TEXT("game_id"))) != GameID)
+		return MakeFailure(TEXT("The game ID you passed in does not point to a valid game."));
+	return nullptr;
+}
+
+/* Handles the sub-requests of a batch */
+TSharedRef<FJsonObject> FGameJoltFakeServer::HandleBatch(const TMultiMap<FString, FString>& Parameters)
+{
+	TArray<FString> SubRequests;
+	Parameters.MultiFind(TEXT("requests[]"), SubRequests, true);
+	if(SubRequests.Num() == 0)
+		return MakeFailure(TEXT("You must pass in the requests."));
+	if(SubRequests.Num() > 50)
+		return MakeFailure(TEXT("The maximum number of sub requests in a batch is 50."));
+
+	const bool bBreakOnError = GetParameter(Parameters, TEXT("break_on_error")) == TEXT("true");
+	TArray<TSharedPtr<FJsonValue>> Responses;
+	for(const FString& SubRequest : SubRequests)
+	{
+		NumRequests++;
+
+		FString Path;
+		TMultiMap<FString, FString> SubParameters;
+		TSharedPtr<FJsonObject> Response = ParseUrl(SubRequest, false, Path, SubParameters);
+		if(!Response.IsValid())
+			Response = Path == TEXT("/batch/") ? MakeFailure(TEXT("Batches can't be nested.")) : HandleEndpoint(Path, SubParameters);
+		Responses.Add(MakeShared<FJsonValueObject>(Response));
+
+		if(bBreakOnError && Response->GetStringField(TEXT("success")) != TEXT("true"))
+			break;
+	}
+
+	TSharedRef<FJsonObject> Response = MakeSuccess();
+	Response->SetArrayField(TEXT("responses"), Responses);
+	return Response;
+}
+
+/* Finds the user the username and user_token parameters belong to */
+FGameJoltFakeServer::FFakeUser* FGameJoltFakeServer::FindAuthenticatedUser(const TMultiMap<FString, FString>& Parameters)
+{
+	const FString UserName = GetParameter(Parameters, TEXT("username"));
+	const FString UserToken = GetParameter(Parameters, TEXT("user_token"));
+	for(FFakeUser& User : Users)
+	{
+		if(User.Name.Equals(UserName, ESearchCase::IgnoreCase) && User.Token.Equals(UserToken, ESearchCase::IgnoreCase))
+			return &User;
+	}
+	return nullptr;
+}
+
+/* Finds the scoreboard of the table_id parameter, or the primary one */
+FGameJoltFakeServer::FFakeTable* FGameJoltFakeServer::FindTable(const TMultiMap<FString, FString>& Parameters)
+{
+	const FString TableID = GetParameter(Parameters, TEXT("table_id"));
+	for(FFakeTable& Table : Tables)
+	{
+		if(TableID.IsEmpty() ? Table.bPrimary : Table.Id == FCString::Atoi(*TableID))
+			return &Table;
+	}
+	return nullptr;
+}
+
+/* Handles a request within the "response" envelope */
+TSharedRef<FJsonObject> FGameJoltFakeServer::HandleEndpoint(const FString& Path, const TMultiMap<FString, FString>& Parameters)
+{
+	const int64 Now = GetUnixNow();
+
+	if(Path == TEXT("/time/"))
+	{
+		const FDateTime Time = FDateTime::FromUnixTimestamp(Now);
+		TSharedRef<FJsonObject> Response = MakeSuccess();
+		Response->SetNumberField(TEXT("timestamp"), Now);
+		Response->SetStringField(TEXT("timezone"), TEXT("UTC"));
+		Response->SetNumberField(TEXT("year"), Time.GetYear());
+		Response->SetNumberField(TEXT("month"), Time.GetMonth());
+		Response->SetNumberField(TEXT("day"), Time.GetDay());
+		Response->SetNumberField(TEXT("hour"), Time.GetHour());
+		Response->SetNumberField(TEXT("minute"), Time.GetMinute());
+		Response->SetNumberField(TEXT("second"), Time.GetSecond());
+		return Response;
+	}
+
+	if(Path == TEXT("/users/"))
+	{
+		const FString UserName = GetParameter(Parameters, TEXT("username"));
+		TArray<FString> UserIDs;
+		GetParameter(Parameters, TEXT("user_id")).ParseIntoArray(UserIDs, TEXT(","));
+		if(UserName.IsEmpty() && UserIDs.Num() == 0)
+			return MakeFailure(TEXT("You must enter a username or user_id."));
+
+		TArray<TSharedPtr<FJsonValue>> UserValues;
+		for(const FFakeUser& User : Users)
+		{
+			if(UserName.IsEmpty() ? !UserIDs.Contains(FString::FromInt(User.Id)) : !User.Name.Equals(UserName, ESearchCase::IgnoreCase))
+				continue;
+
+			TSharedRef<FJsonObject> UserObject = MakeShared<FJsonObject>();
+			UserObject->SetNumberField(TEXT("id"), User.Id);
+			UserObject->SetStringField(TEXT("type"), TEXT("User"));
+			UserObject->SetStringField(TEXT("username"), User.Name);
+			UserObject->SetStringField(TEXT("avatar_url"), FString::Printf(TEXT("https://m.gjcdn.net/user-avatar/60/%d.png"), User.Id));
+			UserObject->SetStringField(TEXT("signed_up"), FString::Printf(TEXT("%lld"), User.SignedUp));
+			UserObject->SetNumberField(TEXT("signed_up_timestamp"), User.SignedUp);
+			UserObject->SetStringField(TEXT("last_logged_in"), FString::Printf(TEXT("%lld"), User.LastLoggedIn));
+			UserObject->SetNumberField(TEXT("last_logged_in_timestamp"), User.LastLoggedIn);
+			UserObject->SetStringField(TEXT("status"), TEXT("Active"));
+			UserValues.Add(MakeShared<FJsonValueObject>(UserObject));
+		}
+		if(UserValues.Num() == 0)
+			return MakeFailure(TEXT("No such user could be found."));
+
+		TSharedRef<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("users"), UserValues);
+		return Response;
+	}
+
+	// The global data-store and the scoreboards of guests don't need a user
+	FFakeUser* User = FindAuthenticatedUser(Parameters);
+	const bool bHasUser = !GetParameter(Parameters, TEXT("username")).IsEmpty();
+	if(bHasUser && !User)
+		return MakeFailure(TEXT("No such user with the credentials passed in could be found."));
+
+	if(Path == TEXT("/users/auth/"))
+	{
+		if(!User)
+			return MakeFailure(TEXT("No such user with the credentials passed in could be found."));
+		User->LastLoggedIn = Now;
+		return MakeSuccess();
+	}
+
+	if(Path.StartsWith(TEXT("/data-store/")))
+	{
+		TMap<FString, FString>& Store = User ? User->Data : GlobalData;
+		const FString Key = GetParameter(Parameters, TEXT("key"));
+
+		if(Path == TEXT("/data-store/get-keys/"))
+		{
+			const FString Pattern = GetParameter(Parameters, TEXT("pattern"));
+			TArray<TSharedPtr<FJsonValue>> Keys;
+			for(const TPair<FString, FString>& Pair : Store)
+			{
+				if(!Pattern.IsEmpty() && !Pair.Key.MatchesWildcard(Pattern, ESearchCase::CaseSensitive))
+					continue;
+				TSharedRef<FJsonObject> KeyObject = MakeShared<FJsonObject>();
+				KeyObject->SetStringField(TEXT("key"), Pair.Key);
+				Keys.Add(MakeShared<FJsonValueObject>(KeyObject));
+			}
+			TSharedRef<FJsonObject> Response = MakeSuccess();
+			Response->SetArrayField(TEXT("keys"), Keys);
+			return Response;
+		}
+
+		if(Key.IsEmpty())
+			return MakeFailure(TEXT("You must enter a key with the request."));
+
+		if(Path == TEXT("/data-store/set/"))
+		{
+			if(!Parameters.Contains(TEXT("data")))
+				return MakeFailure(TEXT("You must enter data with the request."));
+			Store.Add(Key, GetParameter(Parameters, TEXT("data")));
+			return MakeSuccess();
+		}
+
+		FString* Data = Store.Find(Key);
+		if(!Data)
+			return MakeFailure(TEXT("There is no item with the key passed in."));
+
+		if(Path == TEXT("/data-store/"))
+		{
+			TSharedRef<FJsonObject> Response = MakeSuccess();
+			Response->SetStringField(TEXT("data"), *Data);
+			return Response;
+		}
+
+		if(Path == TEXT("/data-store/remove/"))
+		{
+			Store.Remove(Key);
+			return MakeSuccess();
+		}
+
+		if(Path == TEXT("/data-store/update/"))
+		{
+			const FString Operation = GetParameter(Parameters, TEXT("operation"));
+			const FString Value = GetParameter(Parameters, TEXT("value"));
+			if(Operation == TEXT("append"))
+			{
+				*Data += Value;
+			}
+			else if(Operation == TEXT("prepend"))
+			{
+				*Data = Value + *Data;
+			}
+			else
+			{
+				if(!Data->IsNumeric() || !Value.IsNumeric())
+					return MakeFailure(TEXT("Value comes in as a non-numeric, and the operation requires numeric values."));
+
+				const int64 Current = FCString::Atoi64(**Data);
+				const int64 Operand = FCString::Atoi64(*Value);
+				int64 Result;
+				if(Operation == TEXT("add"))
+					Result = Current + Operand;
+				else if(Operation == TEXT("subtract"))
+					Result = Current - Operand;
+				else if(Operation == TEXT("multiply"))
+					Result = Current * Operand;
+				else if(Operation == TEXT("divide") && Operand != 0)
+					Result = Current / Operand;
+				else
+					return MakeFailure(TEXT("The operation passed in is invalid."));
+				*Data = FString::Printf(TEXT("%lld"), Result);
+			}
+
+			TSharedRef<FJsonObject> Response = MakeSuccess();
+			Response->SetStringField(TEXT("data"), *Data);
+			return Response;
+		}
+	}
+
+	if(Path == TEXT("/scores/tables/"))
+	{
+		TArray<TSharedPtr<FJsonValue>> TableValues;
+		for(const FFakeTable& Table : Tables)
+		{
+			TSharedRef<FJsonObject> TableObject = MakeShared<FJsonObject>();
+			TableObject->SetNumberField(TEXT("id"), Table.Id);
+			TableObject->SetStringField(TEXT("name"), Table.Name);
+			TableObject->SetStringField(TEXT("description"), FString());
+			TableObject->SetStringField(TEXT("primary"), Table.bPrimary ? TEXT("1") : TEXT("0"));
+			TableValues.Add(MakeShared<FJsonValueObject>(TableObject));
+		}
+		TSharedRef<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("tables"), TableValues);
+		return Response;
+	}
+
+	if(Path.StartsWith(TEXT("/scores/")))
+	{
+		FFakeTable* Table = FindTable(Parameters);
+		if(!Table)
+			return MakeFailure(TEXT("The high score table ID you passed in does not point to a valid table."));
+
+		if(Path == TEXT("/scores/add/"))
+		{
+			const FString Guest = GetParameter(Parameters, TEXT("guest"));
+			if(!Parameters.Contains(TEXT("score")) || !Parameters.Contains(TEXT("sort")))
+				return MakeFailure(TEXT("You must enter a score and a sort value."));
+			if(!User && Guest.IsEmpty())
+				return MakeFailure(TEXT("You must enter a user or a guest name."));
+
+			FFakeScore Score;
+			Score.Score = GetParameter(Parameters, TEXT("score"));
+			Score.Sort = FCString::Atoi(*GetParameter(Parameters, TEXT("sort")));
+			Score.ExtraData = GetParameter(Parameters, TEXT("extra_data"));
+			Score.UserID = User ? User->Id : 0;
+			Score.UserName = User ? User->Name : FString();
+			Score.Guest = User ? FString() : Guest;
+			Score.Stored = Now;
+
+			InsertScore(*Table, Score);
+			return MakeSuccess();
+		}
+
+		if(Path == TEXT("/scores/get-rank/"))
+		{
+			if(!Parameters.Contains(TEXT("sort")))
+				return MakeFailure(TEXT("You must enter a sort value."));
+			const int32 Sort = FCString::Atoi(*GetParameter(Parameters, TEXT("sort")));
+			int32 Rank = 1;
+			while(Rank <= Table->Scores.Num() && Table->Scores[Rank - 1].Sort > Sort)
+				Rank++;
+
+			TSharedRef<FJsonObject> Response = MakeSuccess();
+			Response->SetNumberField(TEXT("rank"), Rank);
+			return Response;
+		}
+
+		if(Path == TEXT("/scores/"))
+		{
+			const FString Guest = GetParameter(Parameters, TEXT("guest"));
+			const FString Limit = GetParameter(Parameters, TEXT("limit"));
+			const FString BetterThan = GetParameter(Parameters, TEXT("better_than"));
+			const FString WorseThan = GetParameter(Parameters, TEXT("worse_than"));
+			const int32 MaxScores = Limit.IsEmpty() ? 10 : FMath::Clamp(FCString::Atoi(*Limit), 1, 100);
+
+			TArray<TSharedPtr<FJsonValue>> ScoreValues;
+			for(const FFakeScore& Score : Table->Scores)
+			{
+				if(ScoreValues.Num() >= MaxScores)
+					break;
+				if((User && Score.UserID != User->Id) || (!Guest.IsEmpty() && Score.Guest != Guest))
+					continue;
+				if((!BetterThan.IsEmpty() && Score.Sort <= FCString::Atoi(*BetterThan)) || (!WorseThan.IsEmpty() && Score.Sort >= FCString::Atoi(*WorseThan)))
+					continue;
+
+				TSharedRef<FJsonObject> ScoreObject = MakeShared<FJsonObject>();
+				ScoreObject->SetStringField(TEXT("score"), Score.Score);
+				ScoreObject->SetNumberField(TEXT("sort"), Score.Sort);
+				ScoreObject->SetStringField(TEXT("extra_data"), Score.ExtraData);
+				ScoreObject->SetStringField(TEXT("user"), Score.UserName);
+				if(Score.UserID > 0)
+					ScoreObject->SetNumberField(TEXT("user_id"), Score.UserID);
+				else
+					ScoreObject->SetStringField(TEXT("user_id"), FString());
+				ScoreObject->SetStringField(TEXT("guest"), Score.Guest);
+				ScoreObject->SetStringField(TEXT("stored"), FString::Printf(TEXT("%lld"), Score.Stored));
+				ScoreObject->SetNumberField(TEXT("stored_timestamp"), Score.Stored);
+				ScoreValues.Add(MakeShared<FJsonValueObject>(ScoreObject));
+			}
+
+			TSharedRef<FJsonObject> Response = MakeSuccess();
+			Response->SetArrayField(TEXT("scores"), ScoreValues);
+			return Response;
+		}
+	}
+
+	// Everything below belongs to a user
+	if(!User)
+		return MakeFailure(TEXT("You must enter a username and user_token."));
+
+	if(Path == TEXT("/friends/"))
+	{
+		TArray<TSharedPtr<FJsonValue>> FriendValues;
+		for(const int32 FriendID : User->FriendIDs)
+		{
+			TSharedRef<FJsonObject> FriendObject = MakeShared<FJsonObject>();
+			FriendObject->SetNumberField(TEXT("friend_id"), FriendID);
+			FriendValues.Add(MakeShared<FJsonValueObject>(FriendObject));
+		}
+		TSharedRef<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("friends"), FriendValues);
+		return Response;
+	}
+
+	if(Path == TEXT("/sessions/open/"))
+	{
+		User->bSessionOpen = true;
+		User->SessionStatus = TEXT("active");
+		return MakeSuccess();
+	}
+
+	if(Path == TEXT("/sessions/ping/"))
+	{
+		const FString Status = GetParameter(Parameters, TEXT("status"));
+		if(!User->bSessionOpen)
+			return MakeFailure(TEXT("Could not find an open session. You must open a new one."));
+		if(!Status.IsEmpty() && Status != TEXT("active") && Status != TEXT("idle"))
+			return MakeFailure(TEXT("The status passed in is invalid."));
+		if(!Status.IsEmpty())
+			User->SessionStatus = Status;
+		return MakeSuccess();
+	}
+
+	if(Path == TEXT("/sessions/check/"))
+		return User->bSessionOpen ? MakeSuccess() : MakeFailure(TEXT("No open session."));
+
+	if(Path == TEXT("/sessions/close/"))
+	{
+		if(!User->bSessionOpen)
+			return MakeFailure(TEXT("Could not find an open session."));
+		User->bSessionOpen = false;
+		return MakeSuccess();
+	}
+
+	if(Path == TEXT("/trophies/"))
+	{
+		const FString Achieved = GetParameter(Parameters, TEXT("achieved"));
+		TArray<FString> TrophyIDs;
+		GetParameter(Parameters, TEXT("trophy_id")).ParseIntoArray(TrophyIDs, TEXT(","));
+
+		TArray<TSharedPtr<FJsonValue>> TrophyValues;
+		for(const FFakeTrophy& Trophy : Trophies)
+		{
+			const int64* AchievedTime = User->AchievedTrophies.Find(Trophy.Id);
+			if(TrophyIDs.Num() > 0 && !TrophyIDs.Contains(FString::FromInt(Trophy.Id)))
+				continue;
+			if((Achieved == TEXT("true") && !AchievedTime) || (Achieved == TEXT("false") && AchievedTime))
+				continue;
+
+			TSharedRef<FJsonObject> TrophyObject = MakeShared<FJsonObject>();
+			TrophyObject->SetNumberField(TEXT("id"), Trophy.Id);
+			TrophyObject->SetStringField(TEXT("title"), Trophy.Title);
+			TrophyObject->SetStringField(TEXT("difficulty"), Trophy.Difficulty);
+			TrophyObject->SetStringField(TEXT("description"), FString());
+			TrophyObject->SetStringField(TEXT("image_url"), FString::Printf(TEXT("https://m.gjcdn.net/trophy-thumbnail/%d.png"), Trophy.Id));
+			TrophyObject->SetStringField(TEXT("achieved"), AchievedTime ? FString::Printf(TEXT("%lld"), *AchievedTime) : TEXT("false"));
+			TrophyValues.Add(MakeShared<FJsonValueObject>(TrophyObject));
+		}
+
+		TSharedRef<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("trophies"), TrophyValues);
+		return Response;
+	}
+
+	if(Path == TEXT("/trophies/add-achieved/") || Path == TEXT("/trophies/remove-achieved/"))
+	{
+		const int32 TrophyID = FCString::Atoi(*GetParameter(Parameters, TEXT("trophy_id")));
+		if(!Trophies.ContainsByPredicate([TrophyID](const FFakeTrophy& Trophy) { return Trophy.Id == TrophyID; }))
+			return MakeFailure(TEXT("Incorrect trophy ID."));
+
+		if(Path == TEXT("/trophies/add-achieved/"))
+		{
+			if(User->AchievedTrophies.Contains(TrophyID))
+				return MakeFailure(TEXT("The user already has this trophy."));
+			User->AchievedTrophies.Add(TrophyID, Now);
+			return MakeSuccess();
+		}
+
+		if(User->AchievedTrophies.Remove(TrophyID) == 0)
+			return MakeFailure(TEXT("The user does not have this trophy."));
+		return MakeSuccess();
+	}
+
+	return MakeFailure(FString::Printf(TEXT("Unknown endpoint %s"), *Path));
+}
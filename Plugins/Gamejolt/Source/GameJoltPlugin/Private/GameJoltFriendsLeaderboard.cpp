@@ -0,0 +1,366 @@
+#include "GameJoltFriendsLeaderboard.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+#include "HAL/PlatformTime.h"
+
+/* Constructor */
+UGameJoltFriendsLeaderboard::UGameJoltFriendsLeaderboard(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	FriendListLifetime = 300.f;
+	MaxPages = 10;
+	API = nullptr;
+	TableID = 0;
+	FriendsFetchTime = 0.0;
+	NumPagesFetched = 0;
+	LastPageSort = 0;
+	LastPageNumTied = 0;
+	bAscending = false;
+	bLoading = false;
+	bFetchingFriends = false;
+	bFetchingOwnScore = false;
+	bFetchingPage = false;
+	bEndReached = false;
+	Generation = 0;
+}
+
+/* Creates a friends leaderboard */
+UGameJoltFriendsLeaderboard* UGameJoltFriendsLeaderboard::CreateFriendsLeaderboard(UUEGameJoltAPI* API, int32 TableID, int32 MaxPages)
+{
+	if(!API)
+	{
+		UE_LOG(GJAPI, Error, TEXT("A friends leaderboard needs an API instance to fetch its scores with"));
+		return nullptr;
+	}
+
+	UGameJoltFriendsLeaderboard* Leaderboard = NewObject<UGameJoltFriendsLeaderboard>(API);
+	Leaderboard->API = API;
+	Leaderboard->TableID = FMath::Max(TableID, 0);
+	Leaderboard->MaxPages = FMath::Max(MaxPages, 1);
+	return Leaderboard;
+}
+
+/* Fetches the scores of the current user and their friends */
+bool UGameJoltFriendsLeaderboard::Load()
+{
+	if(!API || bLoading)
+		return false;
+
+	if(!API->bIsLoggedIn)
+	{
+		UE_LOG(GJAPI, Error, TEXT("User is not logged in"));
+		return false;
+	}
+
+	Generation++;
+	PageScores.Reset();
+	OwnScore = FScoreInfo();
+	NumPagesFetched = 0;
+	LastPageSort = 0;
+	LastPageNumTied = 0;
+	bAscending = false;
+	bEndReached = false;
+	bLoading = true;
+
+	TWeakObjectPtr<UGameJoltFriendsLeaderboard> WeakThis(this);
+	const uint32 LoadGeneration = Generation;
+
+	// The friend list, the current user's best score and the first page don't depend on each other, so they are all sent right away
+	const bool bHasFriends = FriendsUserName == API->UserName;
+	if(!bHasFriends || FPlatformTime::Seconds() - FriendsFetchTime >= FriendListLifetime)
+	{
+		const FString FetchUserName = API->UserName;
+		bFetchingFriends = true;
+		const TSharedPtr<FGameJoltRequest> FriendsRequest = API->StartRequest(EGameJoltComponentEnum::GJ_USER_FRIENDLIST, TEXT("/friends/?"), true,
+			[WeakThis, FetchUserName, LoadGeneration](const FGameJoltRequest& CompletedRequest)
+			{
+				if(WeakThis.IsValid())
+					WeakThis->OnFriendsFetched(CompletedRequest, FetchUserName, LoadGeneration);
+			}, FString(), true);
+
+		if(!FriendsRequest.IsValid())
+		{
+			bFetchingFriends = false;
+			if(!bHasFriends)
+			{
+				UE_LOG(GJAPI, Error, TEXT("Could not fetch friendlist."));
+				bLoading = false;
+				return false;
+			}
+		}
+	}
+
+	FGameJoltQueryBuilder OwnQuery(TEXT("/scores/"));
+	OwnQuery.Add(TEXT("limit"), 1);
+	if(TableID > 0)
+		OwnQuery.Add(TEXT("table_id"), TableID);
+
+	bFetchingOwnScore = true;
+	const TSharedPtr<FGameJoltRequest> OwnRequest = API->StartRequest(EGameJoltComponentEnum::GJ_SCORES_FETCH, OwnQuery.Build(), true,
+		[WeakThis, LoadGeneration](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnOwnScoreFetched(CompletedRequest, LoadGeneration);
+		}, FString(), true);
+
+	// The current user's score is found on the pages as well if it is good enough
+	if(!OwnRequest.IsValid())
+		bFetchingOwnScore = false;
+
+	if(!FetchPage())
+	{
+		UE_LOG(GJAPI, Error, TEXT("Could not fetch scoreboard."));
+		Generation++;
+		bLoading = false;
+		bFetchingFriends = false;
+		bFetchingOwnScore = false;
+		return false;
+	}
+	return true;
+}
+
+/* Gets the scores of the last load */
+TArray<FScoreInfo> UGameJoltFriendsLeaderboard::GetScores() const
+{
+	return Scores;
+}
+
+/* Gets the IDs of the cached friends */
+TArray<int32> UGameJoltFriendsLeaderboard::GetFriendIDs() const
+{
+	return FriendIDs.Array();
+}
+
+/* Whether a load is running */
+bool UGameJoltFriendsLeaderboard::IsLoading() const
+{
+	return bLoading;
+}
+
+/* Drops the cached friend list */
+void UGameJoltFriendsLeaderboard::ClearFriends()
+{
+	FriendIDs.Reset();
+	FriendsUserName.Reset();
+	FriendsFetchTime = 0.0;
+}
+
+/* Callback of the friend list fetch */
+void UGameJoltFriendsLeaderboard::OnFriendsFetched(const FGameJoltRequest& GameJoltRequest, const FString& FetchUserName, uint32 LoadGeneration)
+{
+	if(LoadGeneration != Generation)
+		return;
+	bFetchingFriends = false;
+
+	if(GameJoltRequest.bSucceeded)
+	{
+		// A user without friends gets an empty or no list
+		TArray<int32> FetchedIDs;
+		FGameJoltResponseDecoder::DecodeFriendlist(GameJoltRequest.Response, FetchedIDs);
+		FriendIDs = TSet<int32>(FetchedIDs);
+		FriendsUserName = FetchUserName;
+		FriendsFetchTime = FPlatformTime::Seconds();
+	}
+	else if(FriendsUserName == FetchUserName)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Could not fetch friendlist. Using the cached one"));
+	}
+	else
+	{
+		UE_LOG(GJAPI, Error, TEXT("Could not fetch friendlist."));
+		FailLoad();
+		return;
+	}
+
+	Advance();
+}
+
+/* Callback of the current user's score fetch */
+void UGameJoltFriendsLeaderboard::OnOwnScoreFetched(const FGameJoltRequest& GameJoltRequest, uint32 LoadGeneration)
+{
+	if(LoadGeneration != Generation)
+		return;
+	bFetchingOwnScore = false;
+
+	if(GameJoltRequest.bSucceeded)
+	{
+		TArray<FScoreInfo> OwnScores;
+		if(GameJoltRequest.bStreamed)
+			OwnScores = GameJoltRequest.Scores;
+		else
+			FGameJoltResponseDecoder::DecodeScores(GameJoltRequest.Response, OwnScores);
+		if(OwnScores.Num() > 0)
+			OwnScore = OwnScores[0];
+	}
+
+	Advance();
+}
+
+/* Fetches the next page of the scoreboard */
+bool UGameJoltFriendsLeaderboard::FetchPage()
+{
+	int32 NumSkipped = 0;
+	FGameJoltQueryBuilder Query(TEXT("/scores/"));
+	Query.Add(TEXT("limit"), GJAPI_MAX_SCORE_LIMIT);
+	if(TableID > 0)
+		Query.Add(TEXT("table_id"), TableID);
+	if(NumPagesFetched > 0)
+	{
+		// Include the scores tied with the end of the previous page and skip the ones fetched already
+		// worse_than excludes its own value, so it is moved by one towards the better scores
+		if(LastPageNumTied < GJAPI_MAX_SCORE_LIMIT)
+		{
+			NumSkipped = LastPageNumTied;
+			Query.Add(TEXT("worse_than"), bAscending ? LastPageSort - 1 : LastPageSort + 1);
+		}
+		else
+		{
+			UE_LOG(GJAPI, Warning, TEXT("More scores are tied at %d than a page can skip. The remaining ones are left out"), LastPageSort);
+			Query.Add(TEXT("worse_than"), LastPageSort);
+		}
+	}
+
+	// The global scores, without triggering the events of the API instance
+	TWeakObjectPtr<UGameJoltFriendsLeaderboard> WeakThis(this);
+	const uint32 LoadGeneration = Generation;
+	bFetchingPage = true;
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_SCORES_FETCH, Query.Build(), false,
+		[WeakThis, NumSkipped, LoadGeneration](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnPageFetched(CompletedRequest, NumSkipped, LoadGeneration);
+		}, FString(), true);
+
+	if(!GameJoltRequest.IsValid())
+	{
+		bFetchingPage = false;
+		return false;
+	}
+	return true;
+}
+
+/* Callback of a page request */
+void UGameJoltFriendsLeaderboard::OnPageFetched(const FGameJoltRequest& GameJoltRequest, int32 NumSkipped, uint32 LoadGeneration)
+{
+	if(LoadGeneration != Generation)
+		return;
+	bFetchingPage = false;
+
+	if(!GameJoltRequest.bSucceeded)
+	{
+		if(NumPagesFetched == 0)
+		{
+			UE_LOG(GJAPI, Error, TEXT("Could not fetch scoreboard."));
+			FailLoad();
+			return;
+		}
+
+		// The friends found so far are shown rather than none
+		UE_LOG(GJAPI, Warning, TEXT("Could not fetch page %d of the scoreboard. Friends with worse scores are left out"), NumPagesFetched);
+		bEndReached = true;
+		Advance();
+		return;
+	}
+
+	TArray<FScoreInfo> PageRows;
+	if(GameJoltRequest.bStreamed)
+		PageRows = GameJoltRequest.Scores;
+	else
+		FGameJoltResponseDecoder::DecodeScores(GameJoltRequest.Response, PageRows);
+
+	const bool bLastPage = PageRows.Num() < GJAPI_MAX_SCORE_LIMIT;
+	PageRows.RemoveAt(0, FMath::Min(NumSkipped, PageRows.Num()));
+	if(NumPagesFetched == 0 && PageRows.Num() > 1)
+		bAscending = PageRows[0].ScoreSort < PageRows.Last().ScoreSort;
+
+	if(bLastPage || PageRows.Num() == 0)
+	{
+		bEndReached = true;
+	}
+	else
+	{
+		const int32 Sort = PageRows.Last().ScoreSort;
+		int32 NumTied = 0;
+		for(int32 i = PageRows.Num() - 1; i >= 0 && PageRows[i].ScoreSort == Sort; i--)
+			NumTied++;
+
+		// The tie might have started on an earlier page
+		if(NumTied == PageRows.Num() && NumPagesFetched > 0 && LastPageSort == Sort)
+			NumTied += LastPageNumTied;
+
+		LastPageSort = Sort;
+		LastPageNumTied = NumTied;
+	}
+
+	NumPagesFetched++;
+	PageScores.Append(MoveTemp(PageRows));
+	Advance();
+}
+
+/* Fetches the next page or finishes the load, once the responses it depends on arrived */
+void UGameJoltFriendsLeaderboard::Advance()
+{
+	// Whether another page is needed is only known once the friends are
+	if(!bLoading || bFetchingFriends || bFetchingPage)
+		return;
+
+	if(!bEndReached && NumPagesFetched < MaxPages)
+	{
+		TSet<int32> MissingIDs = FriendIDs;
+		for(const FScoreInfo& Score : PageScores)
+			MissingIDs.Remove(Score.UserID);
+
+		if(MissingIDs.Num() > 0)
+		{
+			if(FetchPage())
+				return;
+			UE_LOG(GJAPI, Warning, TEXT("Could not fetch page %d of the scoreboard. Friends with worse scores are left out"), NumPagesFetched);
+		}
+	}
+
+	if(!bFetchingOwnScore)
+		FinishLoad();
+}
+
+/* Merges the fetched scores and broadcasts them */
+void UGameJoltFriendsLeaderboard::FinishLoad()
+{
+	// The pages are ordered best first, so the first score of every user is their best one
+	const int32 OwnUserID = OwnScore.UserID;
+	TSet<int32> AddedIDs;
+	Scores.Reset();
+	for(FScoreInfo& Score : PageScores)
+	{
+		if(Score.UserID > 0 && (Score.UserID == OwnUserID || FriendIDs.Contains(Score.UserID)) && !AddedIDs.Contains(Score.UserID))
+		{
+			AddedIDs.Add(Score.UserID);
+			Scores.Add(MoveTemp(Score));
+		}
+	}
+
+	// The current user's best score is placed by its sort value if it is beyond the fetched pages
+	if(OwnUserID > 0 && !AddedIDs.Contains(OwnUserID))
+	{
+		int32 Index = 0;
+		while(Index < Scores.Num() && (bAscending ? Scores[Index].ScoreSort <= OwnScore.ScoreSort : Scores[Index].ScoreSort >= OwnScore.ScoreSort))
+			Index++;
+		Scores.Insert(OwnScore, Index);
+	}
+
+	PageScores.Reset();
+	bLoading = false;
+	OnLoaded.Broadcast(Scores);
+}
+
+/* Ends the running load and broadcasts the failure */
+void UGameJoltFriendsLeaderboard::FailLoad()
+{
+	// Responses still in flight belong to the failed load
+	Generation++;
+	PageScores.Reset();
+	bLoading = false;
+	bFetchingFriends = false;
+	bFetchingOwnScore = false;
+	bFetchingPage = false;
+	OnFailed.Broadcast();
+}
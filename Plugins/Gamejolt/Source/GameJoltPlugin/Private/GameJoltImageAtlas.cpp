@@ -0,0 +1,239 @@
+#include "GameJoltImageAtlas.h"
+#include "GameJoltImageLoader.h"
+#include "GameJoltPluginModule.h"
+#include "Engine/Texture2D.h"
+#include "UObject/Package.h"
+
+/* Constructor */
+UGameJoltImageAtlas::UGameJoltImageAtlas(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	PageSize = 1024;
+	Padding = 2;
+}
+
+/* Creates an image atlas */
+UGameJoltImageAtlas* UGameJoltImageAtlas::CreateImageAtlas(int32 PageSize, int32 Padding)
+{
+	UGameJoltImageAtlas* ImageAtlas = NewObject<UGameJoltImageAtlas>(GetTransientPackage());
+	ImageAtlas->PageSize = FMath::Clamp(PageSize, 64, 8192);
+	ImageAtlas->Padding = FMath::Clamp(Padding, 0, ImageAtlas->PageSize / 8);
+	return ImageAtlas;
+}
+
+/* Loads an image and packs it into the atlas */
+bool UGameJoltImageAtlas::AddImage(const FString& URL)
+{
+	if(URL.IsEmpty())
+		return false;
+
+	if(Regions.Contains(URL))
+	{
+		OnImageAdded.Broadcast(URL, true);
+		return true;
+	}
+
+	if(Pending.Contains(URL))
+		return true;
+
+	Pending.Add(URL);
+	TWeakObjectPtr<UGameJoltImageAtlas> WeakThis(this);
+	UGameJoltImageLoader::GetImageLoader()->RequestImagePixels(URL, [WeakThis, URL](UTexture2D* Texture, const TArray<uint8>* Pixels, int32 Width, int32 Height)
+	{
+		if(WeakThis.IsValid())
+			WeakThis->OnImageLoaded(URL, Pixels, Width, Height);
+	});
+	return true;
+}
+
+/* Packs the avatar of a user into the atlas */
+bool UGameJoltImageAtlas::AddAvatar(const FUserInfo& User)
+{
+	return AddImage(User.User_AvatarURL);
+}
+
+/* Packs the image of a trophy into the atlas */
+bool UGameJoltImageAtlas::AddTrophyImage(const FTrophyInfo& Trophy)
+{
+	return AddImage(Trophy.image_url);
+}
+
+/* Packs the images of trophies into the atlas */
+int32 UGameJoltImageAtlas::AddTrophyImages(const TArray<FTrophyInfo>& Trophies)
+{
+	int32 NumAdded = 0;
+	for(const FTrophyInfo& Trophy : Trophies)
+	{
+		if(AddTrophyImage(Trophy))
+			NumAdded++;
+	}
+	return NumAdded;
+}
+
+/* Gets a brush drawing a packed image */
+bool UGameJoltImageAtlas::GetBrush(const FString& URL, FSlateBrush& OutBrush) const
+{
+	UTexture2D* Texture = nullptr;
+	FVector2D MinUV, MaxUV;
+	if(!GetRegion(URL, Texture, MinUV, MaxUV))
+		return false;
+
+	const FRegion& Region = Regions.FindChecked(URL);
+	OutBrush = FSlateBrush();
+	OutBrush.SetResourceObject(Texture);
+	OutBrush.ImageSize = FVector2D(Region.Rect.Size());
+	OutBrush.SetUVRegion(FBox2D(MinUV, MaxUV));
+	return true;
+}
+
+/* Gets where a packed image is placed */
+bool UGameJoltImageAtlas::GetRegion(const FString& URL, UTexture2D*& OutTexture, FVector2D& OutMinUV, FVector2D& OutMaxUV) const
+{
+	const FRegion* Region = Regions.Find(URL);
+	if(!Region)
+		return false;
+
+	OutTexture = Pages[Region->Page];
+	OutMinUV = FVector2D(Region->Rect.Min) / PageSize;
+	OutMaxUV = FVector2D(Region->Rect.Max) / PageSize;
+	return true;
+}
+
+/* Packs a loaded image into the atlas */
+void UGameJoltImageAtlas::OnImageLoaded(const FString& URL, const TArray<uint8>* Pixels, int32 Width, int32 Height)
+{
+	Pending.Remove(URL);
+
+	if(!Pixels || Width <= 0 || Height <= 0 || Pixels->Num() < Width * Height * 4)
+	{
+		OnImageAdded.Broadcast(URL, false);
+		return;
+	}
+
+	const int32 PaddedWidth = Width + Padding * 2;
+	const int32 PaddedHeight = Height + Padding * 2;
+	if(PaddedWidth > PageSize || PaddedHeight > PageSize)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("The image %s is too large for an atlas page of %d pixels"), *URL, PageSize);
+		OnImageAdded.Broadcast(URL, false);
+		return;
+	}
+
+	const uint8* Source = Pixels->GetData();
+
+	// Border pixels repeat the nearest edge pixel. Freed by the render thread once uploaded
+	uint8* Padded = static_cast<uint8*>(FMemory::Malloc(PaddedWidth * PaddedHeight * 4));
+	for(int32 y = 0; y < PaddedHeight; y++)
+	{
+		const int32 SourceY = FMath::Clamp(y - Padding, 0, Height - 1);
+		for(int32 x = 0; x < PaddedWidth; x++)
+		{
+			const int32 SourceX = FMath::Clamp(x - Padding, 0, Width - 1);
+			FMemory::Memcpy(Padded + (y * PaddedWidth + x) * 4, Source + (SourceY * Width + SourceX) * 4, 4);
+		}
+	}
+
+	int32 Page = 0;
+	FIntPoint Position;
+	if(!Allocate(PaddedWidth, PaddedHeight, Page, Position))
+	{
+		FMemory::Free(Padded);
+		OnImageAdded.Broadcast(URL, false);
+		return;
+	}
+
+	// The CPU copy holds the whole page, as the texture's own data can't be read back in cooked builds
+	uint8* PageData = PagePixels[Page].GetData();
+	for(int32 y = 0; y < PaddedHeight; y++)
+		FMemory::Memcpy(PageData + ((Position.Y + y) * PageSize + Position.X) * 4, Padded + y * PaddedWidth * 4, PaddedWidth * 4);
+
+	// Only the new image is uploaded to the GPU
+	FUpdateTextureRegion2D* UpdateRegion = new FUpdateTextureRegion2D(Position.X, Position.Y, 0, 0, PaddedWidth, PaddedHeight);
+	Pages[Page]->UpdateTextureRegions(0, 1, UpdateRegion, PaddedWidth * 4, 4, Padded, [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	{
+		FMemory::Free(SrcData);
+		delete Regions;
+	});
+
+	FRegion& Region = Regions.Add(URL);
+	Region.Page = Page;
+	Region.Rect = FIntRect(Position.X + Padding, Position.Y + Padding, Position.X + Padding + Width, Position.Y + Padding + Height);
+	OnImageAdded.Broadcast(URL, true);
+}
+
+/* Finds a place for an image, starting a new page if none has room left */
+bool UGameJoltImageAtlas::Allocate(int32 Width, int32 Height, int32& OutPage, FIntPoint& OutPosition)
+{
+	for(int32 i = 0; i < Layouts.Num(); i++)
+	{
+		if(AllocateOnPage(Layouts[i], Width, Height, OutPosition))
+		{
+			OutPage = i;
+			return true;
+		}
+	}
+
+	UTexture2D* Page = CreatePage();
+	if(!Page)
+	{
+		UE_LOG(GJAPI, Error, TEXT("Failed to create an atlas page"));
+		return false;
+	}
+
+	Pages.Add(Page);
+	PagePixels.AddDefaulted_GetRef().SetNumZeroed(PageSize * PageSize * 4);
+	FPageLayout& Layout = Layouts.AddDefaulted_GetRef();
+	Layout.NextY = 0;
+	OutPage = Layouts.Num() - 1;
+	return AllocateOnPage(Layout, Width, Height, OutPosition);
+}
+
+/* Finds a place for an image on a page */
+bool UGameJoltImageAtlas::AllocateOnPage(FPageLayout& Layout, int32 Width, int32 Height, FIntPoint& OutPosition) const
+{
+	// The shelf wasting the least height wins
+	FShelf* BestShelf = nullptr;
+	for(FShelf& Shelf : Layout.Shelves)
+	{
+		if(Shelf.Height >= Height && Shelf.X + Width <= PageSize && (!BestShelf || Shelf.Height < BestShelf->Height))
+			BestShelf = &Shelf;
+	}
+
+	// A much taller shelf is only used once there is no room for a new one
+	const bool bCanAddShelf = Layout.NextY + Height <= PageSize;
+	if(!BestShelf || (BestShelf->Height > Height * 2 && bCanAddShelf))
+	{
+		if(!bCanAddShelf)
+			return false;
+
+		BestShelf = &Layout.Shelves.AddDefaulted_GetRef();
+		BestShelf->Y = Layout.NextY;
+		BestShelf->Height = Height;
+		BestShelf->X = 0;
+		Layout.NextY += Height;
+	}
+
+	OutPosition = FIntPoint(BestShelf->X, BestShelf->Y);
+	BestShelf->X += Width;
+	return true;
+}
+
+/* Creates a texture for a new page */
+UTexture2D* UGameJoltImageAtlas::CreatePage() const
+{
+	UTexture2D* Page = UTexture2D::CreateTransient(PageSize, PageSize, PF_B8G8R8A8);
+	if(!Page)
+		return nullptr;
+
+	// Only filled once, images are uploaded into their regions afterwards
+	FTexture2DMipMap& Mip = Page->PlatformData->Mips[0];
+	void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+	if(MipData)
+		FMemory::Memzero(MipData, PageSize * PageSize * 4);
+	Mip.BulkData.Unlock();
+	if(!MipData)
+		return nullptr;
+
+	Page->NeverStream = true;
+	Page->UpdateResource();
+	return Page;
+}
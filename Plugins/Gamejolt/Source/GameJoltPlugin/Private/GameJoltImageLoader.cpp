@@ -0,0 +1,475 @@
+#include "GameJoltImageLoader.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltStats.h"
+#include "Engine/Texture2D.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Async/Async.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "UObject/Package.h"
+
+/* An image decoded on a worker thread, waiting for its texture */
+struct FGameJoltDecodedImage
+{
+	int32 Width;
+	int32 Height;
+
+	/* 8 bit BGRA pixels */
+	TArray<uint8> Pixels;
+
+	FGameJoltDecodedImage()
+		: Width(0)
+		, Height(0)
+	{
+	}
+};
+
+/* Seconds an unreferenced file is kept, so files written while the disk cache is pruned survive */
+static const double UnreferencedImageGracePeriod = 3600.0;
+
+/* Hashes bytes to name the files of the disk cache */
+static FString HashBytes(const uint8* Data, int32 Size)
+{
+	uint8 Hash[20];
+	FSHA1::HashBuffer(Data, Size, Hash);
+	return BytesToHex(Hash, 20);
+}
+
+/* Gets the file which names the content of a URL */
+static FString GetReferenceFilename(const FString& Directory, const FString& URL)
+{
+	const FTCHARToUTF8 Utf8(*URL);
+	return FPaths::Combine(Directory, HashBytes((const uint8*)Utf8.Get(), Utf8.Length()) + TEXT(".ref"));
+}
+
+/* Gets the age of a file in seconds */
+static double GetFileAge(const FString& Filename)
+{
+	return (FDateTime::UtcNow() - IFileManager::Get().GetTimeStamp(*Filename)).GetTotalSeconds();
+}
+
+/**
+ * Reads the file kept for a URL. Runs on a worker thread
+ * @param bOutExpired Whether the file is older than its lifetime
+ * @return False if no intact file is kept
+ */
+static bool ReadKeptImage(const FString& Directory, const FString& URL, double Lifetime, TArray<uint8>& OutFile, bool& bOutExpired)
+{
+	const FString ReferenceFilename = GetReferenceFilename(Directory, URL);
+	FString ContentHash;
+	if(!FFileHelper::LoadFileToString(ContentHash, *ReferenceFilename))
+		return false;
+
+	ContentHash.TrimStartAndEndInline();
+	const FString ContentFilename = FPaths::Combine(Directory, ContentHash + TEXT(".img"));
+	if(!FFileHelper::LoadFileToArray(OutFile, *ContentFilename, FILEREAD_Silent))
+		return false;
+
+	if(HashBytes(OutFile.GetData(), OutFile.Num()) != ContentHash)
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Discarding the damaged image %s"), *ContentFilename);
+		IFileManager::Get().Delete(*ContentFilename, false, false, true);
+		OutFile.Reset();
+		return false;
+	}
+
+	// Rewritten with every download, so its age is the age of the file
+	bOutExpired = GetFileAge(ReferenceFilename) > Lifetime;
+	return true;
+}
+
+/* Keeps the downloaded file of a URL on disk. Runs on a worker thread */
+static void KeepImage(const FString& Directory, const FString& URL, const TArray<uint8>& File)
+{
+	const FString ContentHash = HashBytes(File.GetData(), File.Num());
+	const FString ContentFilename = FPaths::Combine(Directory, ContentHash + TEXT(".img"));
+	if(!IFileManager::Get().FileExists(*ContentFilename))
+	{
+		// Written next to the file first, so a crash can't leave a torn file behind. Unique per writer, as other URLs may share the content
+		const FString TempFilename = ContentFilename + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+		if(!FFileHelper::SaveArrayToFile(File, *TempFilename) || !IFileManager::Get().Move(*ContentFilename, *TempFilename, true))
+		{
+			UE_LOG(GJAPI, Error, TEXT("Failed to write the image %s"), *ContentFilename);
+			IFileManager::Get().Delete(*TempFilename, false, false, true);
+			return;
+		}
+	}
+
+	if(!FFileHelper::SaveStringToFile(ContentHash, *GetReferenceFilename(Directory, URL)))
+		UE_LOG(GJAPI, Error, TEXT("Failed to write the image reference of %s"), *URL);
+}
+
+/* Removes references expired for longer than their lifetime, and the files no reference names. Runs on a worker thread */
+static void PruneKeptImages(const FString& Directory, double Lifetime)
+{
+	TArray<FString> ReferenceFiles;
+	IFileManager::Get().FindFiles(ReferenceFiles, *FPaths::Combine(Directory, TEXT("*.ref")), true, false);
+
+	TSet<FString> Referenced;
+	for(const FString& ReferenceFile : ReferenceFiles)
+	{
+		const FString ReferenceFilename = FPaths::Combine(Directory, ReferenceFile);
+		FString ContentHash;
+		if(GetFileAge(ReferenceFilename) > Lifetime * 2.0 || !FFileHelper::LoadFileToString(ContentHash, *ReferenceFilename))
+			IFileManager::Get().Delete(*ReferenceFilename, false, false, true);
+		else
+			Referenced.Add(ContentHash.TrimStartAndEnd());
+	}
+
+	TArray<FString> ContentFiles;
+	IFileManager::Get().FindFiles(ContentFiles, *FPaths::Combine(Directory, TEXT("*.img")), true, false);
+	for(const FString& ContentFile : ContentFiles)
+	{
+		const FString ContentFilename = FPaths::Combine(Directory, ContentFile);
+		if(!Referenced.Contains(FPaths::GetBaseFilename(ContentFile)) && GetFileAge(ContentFilename) > UnreferencedImageGracePeriod)
+			IFileManager::Get().Delete(*ContentFilename, false, false, true);
+	}
+}
+
+/* Decodes a PNG or JPG file into BGRA pixels. Runs on a worker thread */
+static bool DecodeImage(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& File, FGameJoltDecodedImage& OutImage)
+{
+	const EImageFormat Format = ImageWrapperModule.DetectImageFormat(File.GetData(), File.Num());
+	if(Format == EImageFormat::Invalid)
+		return false;
+
+	const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(Format);
+	const TArray<uint8>* Pixels = nullptr;
+	if(!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(File.GetData(), File.Num()) || !ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, Pixels) || !Pixels)
+		return false;
+
+	OutImage.Width = ImageWrapper->GetWidth();
+	OutImage.Height = ImageWrapper->GetHeight();
+	OutImage.Pixels = *Pixels;
+	return OutImage.Width > 0 && OutImage.Height > 0 && OutImage.Pixels.Num() == OutImage.Width * OutImage.Height * 4;
+}
+
+/* The image loader shared by the whole game */
+static TWeakObjectPtr<UGameJoltImageLoader> SharedImageLoader;
+
+/* Constructor */
+UGameJoltImageLoader::UGameJoltImageLoader(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	MaxParallelLoads = 4;
+	MaxMemoryBytes = 32 * 1024 * 1024;
+	bUseDiskCache = true;
+	DiskCacheLifetime = 7.f * 24.f * 60.f * 60.f;
+	MemoryBytes = 0;
+	NumLoading = 0;
+	bDiskCachePruned = false;
+	DiskDirectory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameJolt"), TEXT("Images"));
+	ImageWrapperModule = nullptr;
+}
+
+/* Gets the image loader shared by the whole game */
+UGameJoltImageLoader* UGameJoltImageLoader::GetImageLoader()
+{
+	if(!SharedImageLoader.IsValid())
+	{
+		UGameJoltImageLoader* ImageLoader = NewObject<UGameJoltImageLoader>(GetTransientPackage());
+		ImageLoader->AddToRoot();
+		SharedImageLoader = ImageLoader;
+	}
+	return SharedImageLoader.Get();
+}
+
+/* Loads an image */
+bool UGameJoltImageLoader::LoadImage(const FString& URL)
+{
+	if(URL.IsEmpty())
+		return false;
+
+	TWeakObjectPtr<UGameJoltImageLoader> WeakThis(this);
+	RequestImage(URL, [WeakThis, URL](UTexture2D* Texture)
+	{
+		if(WeakThis.IsValid())
+			WeakThis->OnImageLoaded.Broadcast(URL, Texture);
+	});
+	return true;
+}
+
+/* Loads the avatar of a user */
+bool UGameJoltImageLoader::LoadAvatar(const FUserInfo& User)
+{
+	return LoadImage(User.User_AvatarURL);
+}
+
+/* Loads the image of a trophy */
+bool UGameJoltImageLoader::LoadTrophyImage(const FTrophyInfo& Trophy)
+{
+	return LoadImage(Trophy.image_url);
+}
+
+/* Gets an image if it is in memory */
+UTexture2D* UGameJoltImageLoader::FindImage(const FString& URL)
+{
+	UTexture2D** Texture = Images.Find(URL);
+	if(!Texture)
+		return nullptr;
+
+	ImageUses.FindChecked(URL).LastAccessTime = FPlatformTime::Seconds();
+	return *Texture;
+}
+
+/* Loads an image and calls back with it */
+void UGameJoltImageLoader::RequestImage(const FString& URL, FGameJoltImageCallback OnLoaded)
+{
+	if(URL.IsEmpty())
+	{
+		if(OnLoaded)
+			OnLoaded(nullptr);
+		return;
+	}
+
+	if(UTexture2D* Texture = FindImage(URL))
+	{
+		if(OnLoaded)
+			OnLoaded(Texture);
+		return;
+	}
+
+	RequestImagePixels(URL, [OnLoaded = MoveTemp(OnLoaded)](UTexture2D* Texture, const TArray<uint8>* Pixels, int32 Width, int32 Height)
+	{
+		if(OnLoaded)
+			OnLoaded(Texture);
+	});
+}
+
+/* Loads an image and calls back with its decoded pixels */
+void UGameJoltImageLoader::RequestImagePixels(const FString& URL, FGameJoltImagePixelsCallback OnLoaded)
+{
+	if(URL.IsEmpty())
+	{
+		if(OnLoaded)
+			OnLoaded(nullptr, nullptr, 0, 0);
+		return;
+	}
+
+	// Joins the load in flight or queued for the same URL
+	if(TArray<FGameJoltImagePixelsCallback>* URLWaiters = Waiters.Find(URL))
+	{
+		URLWaiters->Add(MoveTemp(OnLoaded));
+		return;
+	}
+
+	Waiters.Add(URL).Add(MoveTemp(OnLoaded));
+	Queue.Add(URL);
+	StartNextLoads();
+}
+
+/* Removes all images from memory */
+void UGameJoltImageLoader::ClearMemory()
+{
+	DEC_MEMORY_STAT_BY(STAT_GameJolt_ImageMemory, MemoryBytes);
+	Images.Reset();
+	ImageUses.Reset();
+	MemoryBytes = 0;
+}
+
+/* Starts loading the next images until the limit of loads in flight is reached */
+void UGameJoltImageLoader::StartNextLoads()
+{
+	while(NumLoading < FMath::Max(MaxParallelLoads, 1) && Queue.Num() > 0)
+	{
+		const FString URL = Queue[0];
+		Queue.RemoveAt(0, 1, false);
+		NumLoading++;
+		StartLoad(URL);
+	}
+}
+
+/* Reads an image from disk and decodes it on a worker thread, downloading it if it isn't kept or expired */
+void UGameJoltImageLoader::StartLoad(const FString& URL)
+{
+	if(!bUseDiskCache)
+	{
+		Download(URL, TArray<uint8>());
+		return;
+	}
+
+	const bool bPrune = !bDiskCachePruned;
+	bDiskCachePruned = true;
+
+	TWeakObjectPtr<UGameJoltImageLoader> WeakThis(this);
+	IImageWrapperModule* ImageWrapper = &GetImageWrapperModule();
+	const FString Directory = DiskDirectory;
+	const double Lifetime = DiskCacheLifetime;
+	Async(EAsyncExecution::ThreadPool, [WeakThis, URL, ImageWrapper, Directory, Lifetime, bPrune]()
+	{
+		if(bPrune)
+			PruneKeptImages(Directory, Lifetime);
+
+		TArray<uint8> File;
+		bool bExpired = true;
+		FGameJoltDecodedImage Image;
+		const bool bKept = ReadKeptImage(Directory, URL, Lifetime, File, bExpired);
+		const bool bDecoded = bKept && !bExpired && DecodeImage(*ImageWrapper, File, Image);
+		if(bDecoded)
+			File.Reset();
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, URL, bDecoded, Image = MoveTemp(Image), File = MoveTemp(File)]()
+		{
+			if(!WeakThis.IsValid())
+				return;
+			if(bDecoded)
+				WeakThis->OnDecoded(URL, &Image);
+			else
+				WeakThis->Download(URL, File);
+		});
+	});
+}
+
+/* Downloads an image */
+void UGameJoltImageLoader::Download(const FString& URL, const TArray<uint8>& ExpiredFile)
+{
+	TWeakObjectPtr<UGameJoltImageLoader> WeakThis(this);
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb("GET");
+	HttpRequest->SetURL(URL);
+	HttpRequest->OnProcessRequestComplete().BindLambda([WeakThis, URL, ExpiredFile](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+	{
+		if(!WeakThis.IsValid())
+			return;
+
+		if(bWasSuccessful && Response.IsValid() && EHttpResponseCodes::IsOk(Response->GetResponseCode()) && Response->GetContent().Num() > 0)
+		{
+			WeakThis->Decode(URL, Response->GetContent(), true);
+			return;
+		}
+
+		// The expired file is better than no image while the server can't be reached
+		UE_LOG(GJAPI, Warning, TEXT("Failed to download the image %s"), *URL);
+		WeakThis->Decode(URL, ExpiredFile, false);
+	});
+	HttpRequest->ProcessRequest();
+}
+
+/* Decodes a downloaded image on a worker thread */
+void UGameJoltImageLoader::Decode(const FString& URL, TArray<uint8> File, bool bKeepOnDisk)
+{
+	if(File.Num() == 0)
+	{
+		OnDecoded(URL, nullptr);
+		return;
+	}
+
+	TWeakObjectPtr<UGameJoltImageLoader> WeakThis(this);
+	IImageWrapperModule* ImageWrapper = &GetImageWrapperModule();
+	const FString Directory = DiskDirectory;
+	const bool bKeep = bKeepOnDisk && bUseDiskCache;
+	Async(EAsyncExecution::ThreadPool, [WeakThis, URL, ImageWrapper, Directory, bKeep, File = MoveTemp(File)]()
+	{
+		FGameJoltDecodedImage Image;
+		const bool bDecoded = DecodeImage(*ImageWrapper, File, Image);
+		if(!bDecoded)
+			UE_LOG(GJAPI, Warning, TEXT("Failed to decode the image %s"), *URL);
+		else if(bKeep)
+			KeepImage(Directory, URL, File);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, URL, bDecoded, Image = MoveTemp(Image)]()
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnDecoded(URL, bDecoded ? &Image : nullptr);
+		});
+	});
+}
+
+/* Creates the texture of a decoded image and calls the waiting callbacks */
+void UGameJoltImageLoader::OnDecoded(const FString& URL, const FGameJoltDecodedImage* Image)
+{
+	NumLoading--;
+
+	UTexture2D* Texture = nullptr;
+	if(Image)
+	{
+		Texture = UTexture2D::CreateTransient(Image->Width, Image->Height, PF_B8G8R8A8);
+		if(Texture)
+		{
+			FTexture2DMipMap& Mip = Texture->PlatformData->Mips[0];
+			void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+			if(MipData)
+				FMemory::Memcpy(MipData, Image->Pixels.GetData(), Image->Pixels.Num());
+			Mip.BulkData.Unlock();
+
+			if(MipData)
+			{
+				Texture->UpdateResource();
+				AddToMemory(URL, Texture, Image->Pixels.Num());
+			}
+			else
+			{
+				UE_LOG(GJAPI, Error, TEXT("Failed to fill the texture of the image %s"), *URL);
+				Texture = nullptr;
+			}
+		}
+	}
+
+	const TArray<uint8>* Pixels = Texture ? &Image->Pixels : nullptr;
+	const int32 Width = Texture ? Image->Width : 0;
+	const int32 Height = Texture ? Image->Height : 0;
+
+	TArray<FGameJoltImagePixelsCallback> URLWaiters;
+	Waiters.RemoveAndCopyValue(URL, URLWaiters);
+	for(FGameJoltImagePixelsCallback& OnLoaded : URLWaiters)
+	{
+		if(OnLoaded)
+			OnLoaded(Texture, Pixels, Width, Height);
+	}
+
+	StartNextLoads();
+}
+
+/* Keeps a texture in memory, evicting the least recently used ones beyond the budget */
+void UGameJoltImageLoader::AddToMemory(const FString& URL, UTexture2D* Texture, int32 Bytes)
+{
+	RemoveFromMemory(URL);
+
+	FImageUse& Use = ImageUses.Add(URL);
+	Use.Bytes = Bytes;
+	Use.LastAccessTime = FPlatformTime::Seconds();
+	Images.Add(URL, Texture);
+	MemoryBytes += Bytes;
+	INC_MEMORY_STAT_BY(STAT_GameJolt_ImageMemory, Bytes);
+
+	// The new image is kept even if it exceeds the budget on its own, its callbacks are about to use it
+	while(MemoryBytes > MaxMemoryBytes && ImageUses.Num() > 1)
+	{
+		const FString* OldestURL = nullptr;
+		double OldestAccessTime = TNumericLimits<double>::Max();
+		for(const TPair<FString, FImageUse>& Pair : ImageUses)
+		{
+			if(Pair.Value.LastAccessTime < OldestAccessTime && Pair.Key != URL)
+			{
+				OldestURL = &Pair.Key;
+				OldestAccessTime = Pair.Value.LastAccessTime;
+			}
+		}
+		RemoveFromMemory(FString(*OldestURL));
+	}
+}
+
+/* Removes an image from memory */
+void UGameJoltImageLoader::RemoveFromMemory(const FString& URL)
+{
+	FImageUse Use;
+	if(!ImageUses.RemoveAndCopyValue(URL, Use))
+		return;
+
+	Images.Remove(URL);
+	MemoryBytes -= Use.Bytes;
+	DEC_MEMORY_STAT_BY(STAT_GameJolt_ImageMemory, Use.Bytes);
+}
+
+/* Gets the image wrapper module */
+IImageWrapperModule& UGameJoltImageLoader::GetImageWrapperModule()
+{
+	if(!ImageWrapperModule)
+		ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	return *ImageWrapperModule;
+}
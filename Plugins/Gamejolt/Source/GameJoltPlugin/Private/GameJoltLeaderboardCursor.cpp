@@ -0,0 +1,270 @@
+#include "GameJoltLeaderboardCursor.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+
+/* Estimates the memory held by scores, in bytes */
+static int32 EstimateScoresSize(const TArray<FScoreInfo>& Scores)
+{
+	int32 Size = Scores.GetAllocatedSize();
+	for(const FScoreInfo& Score : Scores)
+	{
+		Size += Score.ScoreString.GetAllocatedSize() + Score.ExtraData.GetAllocatedSize() + Score.UserName.GetAllocatedSize()
+			+ Score.Guest.GetAllocatedSize() + Score.UnixTimestamp.GetAllocatedSize();
+	}
+	return Size;
+}
+
+/* Constructor */
+UGameJoltLeaderboardCursor::UGameJoltLeaderboardCursor(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	PrefetchPages = 1;
+	MaxCachedMemory = 256 * 1024;
+	API = nullptr;
+	TableID = 0;
+	PageSize = 25;
+	FirstVisibleIndex = 0;
+	LastVisibleIndex = -1;
+	NumTotalRows = -1;
+	bAscending = false;
+	Generation = 0;
+	CachedMemory = 0;
+}
+
+/* Creates a cursor over a scoreboard */
+UGameJoltLeaderboardCursor* UGameJoltLeaderboardCursor::CreateLeaderboardCursor(UUEGameJoltAPI* API, int32 TableID, int32 PageSize)
+{
+	if(!API)
+	{
+		UE_LOG(GJAPI, Error, TEXT("A leaderboard cursor needs an API instance to fetch its pages with"));
+		return nullptr;
+	}
+
+	UGameJoltLeaderboardCursor* Cursor = NewObject<UGameJoltLeaderboardCursor>(API);
+	Cursor->API = API;
+	Cursor->TableID = TableID;
+	Cursor->PageSize = FMath::Clamp(PageSize, 1, GJAPI_MAX_SCORE_LIMIT);
+	return Cursor;
+}
+
+/* Sets the rows currently shown */
+void UGameJoltLeaderboardCursor::SetVisibleRange(int32 FirstIndex, int32 LastIndex)
+{
+	FirstVisibleIndex = FMath::Max(FirstIndex, 0);
+	LastVisibleIndex = FMath::Max(LastIndex, FirstVisibleIndex);
+	Update();
+}
+
+/* Gets a row */
+bool UGameJoltLeaderboardCursor::GetRow(int32 Index, FScoreInfo& Score) const
+{
+	if(Index < 0)
+		return false;
+
+	const FPage* Page = Pages.Find(Index / PageSize);
+	if(!Page || !Page->Scores.IsValidIndex(Index % PageSize))
+		return false;
+
+	Score = Page->Scores[Index % PageSize];
+	return true;
+}
+
+/* Gets the amount of rows to show */
+int32 UGameJoltLeaderboardCursor::GetNumRows() const
+{
+	if(NumTotalRows >= 0)
+		return NumTotalRows;
+	return (Boundaries.Num() + 1) * PageSize;
+}
+
+/* Whether the last page has been loaded */
+bool UGameJoltLeaderboardCursor::IsEndReached() const
+{
+	return NumTotalRows >= 0;
+}
+
+/* Drops all pages */
+void UGameJoltLeaderboardCursor::Reset()
+{
+	Pages.Empty();
+	Boundaries.Empty();
+	LoadingPages.Empty();
+	NumTotalRows = -1;
+	bAscending = false;
+	CachedMemory = 0;
+	Generation++;
+	Update();
+}
+
+/* Gets the estimated memory held by the loaded pages */
+int32 UGameJoltLeaderboardCursor::GetCachedMemory() const
+{
+	return CachedMemory;
+}
+
+/* Fetches the missing pages around the visible range and evicts the ones far away */
+void UGameJoltLeaderboardCursor::Update()
+{
+	if(!API || LastVisibleIndex < 0)
+		return;
+
+	const int32 FirstPage = FMath::Max(FirstVisibleIndex / PageSize - PrefetchPages, 0);
+	int32 LastPage = LastVisibleIndex / PageSize + PrefetchPages;
+	if(NumTotalRows >= 0)
+		LastPage = FMath::Min(LastPage, FMath::Max(NumTotalRows - 1, 0) / PageSize);
+
+	// Pages are chained, so a page can only be fetched once the one before it was seen
+	// After a jump past the discovered pages, the pages in between are walked through first
+	for(int32 PageIndex = FMath::Min(FirstPage, Boundaries.Num()); PageIndex <= LastPage; PageIndex++)
+	{
+		if(Pages.Contains(PageIndex) || LoadingPages.Contains(PageIndex))
+			continue;
+		if(PageIndex > 0 && !Boundaries.IsValidIndex(PageIndex - 1))
+			break;
+		FetchPage(PageIndex);
+	}
+
+	EvictPages();
+}
+
+/* Fetches a page whose previous page boundary is known */
+void UGameJoltLeaderboardCursor::FetchPage(int32 PageIndex)
+{
+	int32 NumSkipped = 0;
+	bool bHasWorseThan = false;
+	int32 WorseThan = 0;
+	if(PageIndex > 0)
+	{
+		// Include the scores tied with the end of the previous page and skip the ones shown already
+		// worse_than excludes its own value, so it is moved by one towards the better scores
+		const FPageBoundary& Boundary = Boundaries[PageIndex - 1];
+		bHasWorseThan = true;
+		if(Boundary.NumTied + PageSize <= GJAPI_MAX_SCORE_LIMIT)
+		{
+			NumSkipped = Boundary.NumTied;
+			WorseThan = bAscending ? Boundary.Sort - 1 : Boundary.Sort + 1;
+		}
+		else
+		{
+			UE_LOG(GJAPI, Warning, TEXT("More scores are tied at %d than a page can skip. The remaining ones are left out"), Boundary.Sort);
+			WorseThan = Boundary.Sort;
+		}
+	}
+
+	FGameJoltQueryBuilder Query(TEXT("/scores/"));
+	Query.Add(TEXT("limit"), PageSize + NumSkipped);
+	if(TableID > 0)
+		Query.Add(TEXT("table_id"), TableID);
+	if(bHasWorseThan)
+		Query.Add(TEXT("worse_than"), WorseThan);
+
+	// The global scores, without triggering the events of the API instance
+	TWeakObjectPtr<UGameJoltLeaderboardCursor> WeakThis(this);
+	const uint32 FetchGeneration = Generation;
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_SCORES_FETCH, Query.Build(), false,
+		[WeakThis, PageIndex, NumSkipped, FetchGeneration](const FGameJoltRequest& CompletedRequest)
+		{
+			if(WeakThis.IsValid())
+				WeakThis->OnPageFetched(CompletedRequest, PageIndex, NumSkipped, FetchGeneration);
+		}, FString(), true);
+
+	if(GameJoltRequest.IsValid())
+		LoadingPages.Add(PageIndex);
+}
+
+/* Callback of a page request */
+void UGameJoltLeaderboardCursor::OnPageFetched(const FGameJoltRequest& GameJoltRequest, int32 PageIndex, int32 NumSkipped, uint32 FetchGeneration)
+{
+	if(FetchGeneration != Generation)
+		return;
+	LoadingPages.Remove(PageIndex);
+
+	if(!GameJoltRequest.bSucceeded)
+	{
+		OnPageFailed.Broadcast(PageIndex * PageSize);
+		return;
+	}
+
+	TArray<FScoreInfo> Scores;
+	if(GameJoltRequest.bStreamed)
+		Scores = GameJoltRequest.Scores;
+	else
+		FGameJoltResponseDecoder::DecodeScores(GameJoltRequest.Response, Scores);
+
+	const bool bLastPage = Scores.Num() < PageSize + NumSkipped;
+	Scores.RemoveAt(0, FMath::Min(NumSkipped, Scores.Num()));
+	if(PageIndex == 0 && Scores.Num() > 1)
+		bAscending = Scores[0].ScoreSort < Scores.Last().ScoreSort;
+
+	if(bLastPage)
+	{
+		NumTotalRows = PageIndex * PageSize + Scores.Num();
+		Boundaries.SetNum(FMath::Min(Boundaries.Num(), PageIndex));
+		for(auto It = Pages.CreateIterator(); It; ++It)
+		{
+			if(It.Key() > PageIndex)
+			{
+				CachedMemory -= It.Value().Size;
+				It.RemoveCurrent();
+			}
+		}
+	}
+	else
+	{
+		FPageBoundary Boundary;
+		Boundary.Sort = Scores.Last().ScoreSort;
+		Boundary.NumTied = 0;
+		for(int32 i = Scores.Num() - 1; i >= 0 && Scores[i].ScoreSort == Boundary.Sort; i--)
+			Boundary.NumTied++;
+
+		// The tie might have started on an earlier page
+		if(Boundary.NumTied == Scores.Num() && PageIndex > 0 && Boundaries[PageIndex - 1].Sort == Boundary.Sort)
+			Boundary.NumTied += Boundaries[PageIndex - 1].NumTied;
+
+		if(Boundaries.Num() <= PageIndex)
+			Boundaries.SetNum(PageIndex + 1);
+		Boundaries[PageIndex] = Boundary;
+	}
+
+	if(FPage* OldPage = Pages.Find(PageIndex))
+		CachedMemory -= OldPage->Size;
+	FPage& Page = Pages.Add(PageIndex);
+	Page.Scores = MoveTemp(Scores);
+	Page.Size = EstimateScoresSize(Page.Scores);
+	CachedMemory += Page.Size;
+
+	if(Page.Scores.Num() > 0)
+		OnRowsLoaded.Broadcast(PageIndex * PageSize, Page.Scores.Num());
+	if(bLastPage)
+		OnEndReached.Broadcast(NumTotalRows);
+
+	// The next page can be fetched now that this one ended
+	Update();
+}
+
+/* Evicts the pages furthest from the visible ones until the cap is met */
+void UGameJoltLeaderboardCursor::EvictPages()
+{
+	// Pages within the prefetch window are kept even beyond the cap, Update would only fetch them again
+	const int32 FirstKeptPage = FirstVisibleIndex / PageSize - PrefetchPages;
+	const int32 LastKeptPage = LastVisibleIndex / PageSize + PrefetchPages;
+	while(CachedMemory > MaxCachedMemory)
+	{
+		int32 FurthestPage = INDEX_NONE;
+		int32 FurthestDistance = 0;
+		for(const TPair<int32, FPage>& Pair : Pages)
+		{
+			const int32 Distance = Pair.Key < FirstKeptPage ? FirstKeptPage - Pair.Key : Pair.Key - LastKeptPage;
+			if(Distance > FurthestDistance)
+			{
+				FurthestPage = Pair.Key;
+				FurthestDistance = Distance;
+			}
+		}
+
+		if(FurthestPage == INDEX_NONE)
+			break;
+		CachedMemory -= Pages[FurthestPage].Size;
+		Pages.Remove(FurthestPage);
+	}
+}
@@ -0,0 +1,228 @@
+#include "GameJoltLocalLeaderboard.h"
+#include "GameJoltPluginModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/* "GJLB", the first bytes of every table file */
+static const uint32 LocalLeaderboardMagic = 0x424C4A47;
+
+/* The version of the table files. Files of other versions are discarded */
+static const uint8 LocalLeaderboardVersion = 1;
+
+/* Seconds the server's time of a score may differ from the local time it was recorded at */
+static const int64 LocalScoreTimeTolerance = 600;
+
+FGameJoltLocalLeaderboard::FGameJoltLocalLeaderboard(const FString& InDirectory, int32 InMaxScores)
+	: Directory(InDirectory)
+	, MaxScores(FMath::Max(InMaxScores, 1))
+{
+}
+
+/* Changes the amount of best scores kept per table */
+void FGameJoltLocalLeaderboard::SetMaxScores(int32 InMaxScores)
+{
+	MaxScores = FMath::Max(InMaxScores, 1);
+}
+
+/* Records a score added by this client */
+void FGameJoltLocalLeaderboard::AddLocalScore(int32 TableID, const FScoreInfo& Score)
+{
+	FTable& Table = GetTable(TableID);
+	Table.Scores.Add(ToLocalScore(Score, true));
+	SortAndTrim(Table);
+	Save(TableID, Table);
+}
+
+/* Merges scores fetched from the server */
+void FGameJoltLocalLeaderboard::MergeServerScores(int32 TableID, const TArray<FScoreInfo>& Scores)
+{
+	FTable& Table = GetTable(TableID);
+	if(Scores.Num() > 1 && Scores[0].ScoreSort != Scores.Last().ScoreSort)
+		Table.bAscending = Scores[0].ScoreSort < Scores.Last().ScoreSort;
+
+	bool bChanged = false;
+	for(const FScoreInfo& Score : Scores)
+	{
+		const FLocalScore ServerScore = ToLocalScore(Score, false);
+		FLocalScore* KeptScore = Table.Scores.FindByPredicate([&ServerScore](const FLocalScore& Candidate) { return IsSameScore(Candidate, ServerScore); });
+		if(!KeptScore)
+		{
+			Table.Scores.Add(ServerScore);
+			bChanged = true;
+		}
+		else if(KeptScore->bLocal)
+		{
+			// The server's copy carries the server's time, which later fetches return again
+			*KeptScore = ServerScore;
+			bChanged = true;
+		}
+	}
+
+	if(!bChanged)
+		return;
+	SortAndTrim(Table);
+	Save(TableID, Table);
+}
+
+/* Gets the best scores of a table */
+void FGameJoltLocalLeaderboard::GetScores(int32 TableID, int32 Limit, TArray<FScoreInfo>& OutScores)
+{
+	const FTable& Table = GetTable(TableID);
+	const int32 NumScores = Limit > 0 ? FMath::Min(Limit, Table.Scores.Num()) : Table.Scores.Num();
+
+	OutScores.Reset(NumScores);
+	for(int32 i = 0; i < NumScores; i++)
+	{
+		const FLocalScore& KeptScore = Table.Scores[i];
+		FScoreInfo& Score = OutScores.AddDefaulted_GetRef();
+		Score.ScoreString = KeptScore.Score;
+		Score.ScoreSort = KeptScore.Sort;
+		Score.ExtraData = KeptScore.ExtraData;
+		Score.UserName = KeptScore.UserName;
+		Score.UserID = KeptScore.UserID;
+		Score.Guest = KeptScore.Guest;
+		Score.UnixTimestamp = FString::Printf(TEXT("%lld"), KeptScore.Stored);
+		Score.TimeStamp = FDateTime::FromUnixTimestamp(KeptScore.Stored);
+	}
+}
+
+/* Gets the amount of scores of a table which haven't been returned by the server yet */
+int32 FGameJoltLocalLeaderboard::NumLocalScores(int32 TableID)
+{
+	int32 NumLocal = 0;
+	for(const FLocalScore& Score : GetTable(TableID).Scores)
+		NumLocal += Score.bLocal ? 1 : 0;
+	return NumLocal;
+}
+
+/* Gets a table, loading its file on first use */
+FGameJoltLocalLeaderboard::FTable& FGameJoltLocalLeaderboard::GetTable(int32 TableID)
+{
+	if(FTable* Table = Tables.Find(TableID))
+		return *Table;
+
+	FTable& Table = Tables.Add(TableID);
+	if(!Load(GetFilename(TableID), Table))
+	{
+		Table.Scores.Reset();
+		Table.bAscending = false;
+	}
+	SortAndTrim(Table);
+	return Table;
+}
+
+/* Reads a table file */
+bool FGameJoltLocalLeaderboard::Load(const FString& Filename, FTable& OutTable) const
+{
+	TArray<uint8> Bytes;
+	if(!FFileHelper::LoadFileToArray(Bytes, *Filename, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint8 Version = 0;
+	uint8 Flags = 0;
+	int32 NumScores = 0;
+	Reader << Magic << Version << Flags << NumScores;
+	if(Reader.IsError() || Magic != LocalLeaderboardMagic || Version != LocalLeaderboardVersion || NumScores < 0 || NumScores > Bytes.Num())
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Discarding the invalid local scoreboard %s"), *Filename);
+		return false;
+	}
+
+	OutTable.bAscending = (Flags & 1) != 0;
+	OutTable.Scores.SetNum(NumScores);
+	for(FLocalScore& Score : OutTable.Scores)
+		SerializeScore(Reader, Score);
+
+	if(Reader.IsError())
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Discarding the truncated local scoreboard %s"), *Filename);
+		return false;
+	}
+	return true;
+}
+
+/* Writes a table file */
+void FGameJoltLocalLeaderboard::Save(int32 TableID, FTable& Table) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	uint32 Magic = LocalLeaderboardMagic;
+	uint8 Version = LocalLeaderboardVersion;
+	uint8 Flags = Table.bAscending ? 1 : 0;
+	int32 NumScores = Table.Scores.Num();
+	Writer << Magic << Version << Flags << NumScores;
+	for(FLocalScore& Score : Table.Scores)
+		SerializeScore(Writer, Score);
+
+	// Written next to the table first, so a crash can't leave a torn file behind
+	const FString Filename = GetFilename(TableID);
+	const FString TempFilename = Filename + TEXT(".tmp");
+	if(!FFileHelper::SaveArrayToFile(Bytes, *TempFilename) || !IFileManager::Get().Move(*Filename, *TempFilename, true))
+		UE_LOG(GJAPI, Error, TEXT("Failed to write the local scoreboard %s"), *Filename);
+}
+
+/* Sorts a table from best to worst and drops the scores beyond the cap */
+void FGameJoltLocalLeaderboard::SortAndTrim(FTable& Table) const
+{
+	const bool bAscending = Table.bAscending;
+	Table.Scores.StableSort([bAscending](const FLocalScore& A, const FLocalScore& B)
+	{
+		if(A.Sort != B.Sort)
+			return bAscending ? A.Sort < B.Sort : A.Sort > B.Sort;
+		return A.Stored < B.Stored;
+	});
+
+	if(Table.Scores.Num() > MaxScores)
+		Table.Scores.SetNum(MaxScores);
+}
+
+/* Gets the file of a table */
+FString FGameJoltLocalLeaderboard::GetFilename(int32 TableID) const
+{
+	return FPaths::Combine(Directory, FString::Printf(TEXT("Table_%d.gjlb"), TableID));
+}
+
+/* Whether two scores are the same score of the same player */
+bool FGameJoltLocalLeaderboard::IsSameScore(const FLocalScore& A, const FLocalScore& B)
+{
+	if(A.Sort != B.Sort)
+		return false;
+
+	const bool bSamePlayer = A.UserName.IsEmpty() && B.UserName.IsEmpty() ? A.Guest == B.Guest : A.UserName.Equals(B.UserName, ESearchCase::IgnoreCase);
+	if(!bSamePlayer)
+		return false;
+
+	// A local score was recorded with the local time, the server stored it a little later with its own clock
+	if(A.bLocal || B.bLocal)
+		return FMath::Abs(A.Stored - B.Stored) <= LocalScoreTimeTolerance;
+	return A.Stored == B.Stored;
+}
+
+/* Serializes a score in the format of the table files */
+void FGameJoltLocalLeaderboard::SerializeScore(FArchive& Ar, FLocalScore& Score)
+{
+	uint8 bLocal = Score.bLocal ? 1 : 0;
+	Ar << Score.Sort << Score.Stored << Score.UserID << bLocal;
+	Ar << Score.Score << Score.UserName << Score.Guest << Score.ExtraData;
+	Score.bLocal = bLocal != 0;
+}
+
+/* Converts a score to the kept format */
+FGameJoltLocalLeaderboard::FLocalScore FGameJoltLocalLeaderboard::ToLocalScore(const FScoreInfo& Score, bool bLocal)
+{
+	FLocalScore LocalScore;
+	LocalScore.Score = Score.ScoreString;
+	LocalScore.Sort = Score.ScoreSort;
+	LocalScore.ExtraData = Score.ExtraData;
+	LocalScore.UserName = Score.UserName;
+	LocalScore.UserID = Score.UserID;
+	LocalScore.Guest = Score.Guest;
+	LocalScore.Stored = Score.TimeStamp.ToUnixTimestamp();
+	LocalScore.bLocal = bLocal;
+	return LocalScore;
+}
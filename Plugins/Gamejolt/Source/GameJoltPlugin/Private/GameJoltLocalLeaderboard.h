@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/**
+ * On-disk top scores of every scoreboard, for offline and guest play
+ * Every table is kept in its own file: a small header followed by the scores sorted from best to worst, loaded with a single read
+ * Scores added by this client and scores fetched from the server are merged. A score is kept once per user (or guest), sort value and time
+ */
+class FGameJoltLocalLeaderboard
+{
+public:
+
+	/**
+	 * @param InDirectory The directory the table files are stored in
+	 * @param InMaxScores The amount of best scores kept per table
+	 */
+	FGameJoltLocalLeaderboard(const FString& InDirectory, int32 InMaxScores);
+
+	/* Changes the amount of best scores kept per table */
+	void SetMaxScores(int32 InMaxScores);
+
+	/**
+	 * Records a score added by this client
+	 * It counts as local until a fetch from the server returns it, which replaces it with the server's copy
+	 * @param TableID The id of the scoreboard. 0 for the primary one
+	 */
+	void AddLocalScore(int32 TableID, const FScoreInfo& Score);
+
+	/**
+	 * Merges scores fetched from the server
+	 * @param TableID The id of the scoreboard. 0 for the primary one
+	 * @param Scores The scores sorted from best to worst, as the server returned them
+	 */
+	void MergeServerScores(int32 TableID, const TArray<FScoreInfo>& Scores);
+
+	/* Gets the best scores of a table. A limit of 0 gets all kept scores */
+	void GetScores(int32 TableID, int32 Limit, TArray<FScoreInfo>& OutScores);
+
+	/* Gets the amount of scores of a table which haven't been returned by the server yet */
+	int32 NumLocalScores(int32 TableID);
+
+private:
+
+	/* A kept score */
+	struct FLocalScore
+	{
+		FString Score;
+		int32 Sort;
+		FString ExtraData;
+		FString UserName;
+		int32 UserID;
+		FString Guest;
+
+		/* Unix time the score was stored at. The local time for scores which haven't been returned by the server yet */
+		int64 Stored;
+
+		/* Whether the score was added by this client and hasn't been returned by the server yet */
+		bool bLocal;
+	};
+
+	/* The kept scores of a table */
+	struct FTable
+	{
+		/* Sorted from best to worst */
+		TArray<FLocalScore> Scores;
+
+		/* Whether lower sort values are better. Detected from the scores the server returns */
+		bool bAscending;
+	};
+
+	/* Gets a table, loading its file on first use */
+	FTable& GetTable(int32 TableID);
+
+	/* Reads a table file. Returns false if it is missing or invalid */
+	bool Load(const FString& Filename, FTable& OutTable) const;
+
+	/* Writes a table file */
+	void Save(int32 TableID, FTable& Table) const;
+
+	/* Sorts a table from best to worst and drops the scores beyond the cap */
+	void SortAndTrim(FTable& Table) const;
+
+	/* Gets the file of a table */
+	FString GetFilename(int32 TableID) const;
+
+	/* Whether two scores are the same score of the same player */
+	static bool IsSameScore(const FLocalScore& A, const FLocalScore& B);
+
+	/* Serializes a score in the format of the table files */
+	static void SerializeScore(FArchive& Ar, FLocalScore& Score);
+
+	/* Converts a score to the kept format */
+	static FLocalScore ToLocalScore(const FScoreInfo& Score, bool bLocal);
+
+	FString Directory;
+
+	int32 MaxScores;
+
+	/* The loaded tables, by id */
+	TMap<int32, FTable> Tables;
+};
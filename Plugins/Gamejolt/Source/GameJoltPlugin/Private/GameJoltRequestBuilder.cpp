@@ -0,0 +1,294 @@
+#include "GameJoltRequestBuilder.h"
+#include "Misc/SecureHash.h"
+#include "Containers/StringConv.h"
+#include "Misc/Parse.h"
+#include "GameJoltStats.h"
+
+/* Gets the end of the run of non-ASCII characters starting at Start */
+static int32 FindNonAsciiRunEnd(const TCHAR* Characters, int32 Start, int32 Num)
+{
+	int32 End = Start;
+	while(End < Num && Characters[End] >= 0x80)
+		End++;
+	return End;
+}
+
+/**
+ * Appends percent-encoded characters. Unreserved characters (RFC 3986) are kept as they are
+ * Non-ASCII characters are encoded byte by byte from their UTF-8 form. Whole runs of them are converted at once, so surrogate pairs stay intact
+ */
+static void AppendEncodedCharacters(FString& Out, const TCHAR* Characters, int32 Num)
+{
+	static const TCHAR HexDigits[] = TEXT("0123456789ABCDEF");
+
+	for(int32 i = 0; i < Num; )
+	{
+		const TCHAR Character = Characters[i];
+		if(Character < 0x80)
+		{
+			if(FChar::IsAlnum(Character) || Character == TEXT('-') || Character == TEXT('_') || Character == TEXT('.') || Character == TEXT('~'))
+			{
+				Out += Character;
+			}
+			else
+			{
+				Out += TEXT('%');
+				Out += HexDigits[Character >> 4];
+				Out += HexDigits[Character & 0xF];
+			}
+			i++;
+			continue;
+		}
+
+		const int32 RunEnd = FindNonAsciiRunEnd(Characters, i, Num);
+		FTCHARToUTF8 Converted(Characters + i, RunEnd - i);
+		for(int32 j = 0; j < Converted.Length(); j++)
+		{
+			const uint8 Byte = static_cast<uint8>(Converted.Get()[j]);
+			Out += TEXT('%');
+			Out += HexDigits[Byte >> 4];
+			Out += HexDigits[Byte & 0xF];
+		}
+		i = RunEnd;
+	}
+}
+
+FGameJoltQueryBuilder::FGameJoltQueryBuilder(const TCHAR* Endpoint, int32 ExpectedLen)
+{
+	Query.Reserve(ExpectedLen);
+	Query += Endpoint;
+	Query += TEXT('?');
+}
+
+/* Appends a parameter, percent-encoding its value */
+FGameJoltQueryBuilder& FGameJoltQueryBuilder::Add(const TCHAR* Key, const FString& Value)
+{
+	AppendKey(Key);
+	AppendEncoded(Query, Value);
+	return *this;
+}
+
+/* Appends a parameter, percent-encoding its value */
+FGameJoltQueryBuilder& FGameJoltQueryBuilder::Add(const TCHAR* Key, const TCHAR* Value)
+{
+	AppendKey(Key);
+	AppendEncodedCharacters(Query, Value, FCString::Strlen(Value));
+	return *this;
+}
+
+/* Appends an integer parameter */
+FGameJoltQueryBuilder& FGameJoltQueryBuilder::Add(const TCHAR* Key, int32 Value)
+{
+	AppendKey(Key);
+	Query.AppendInt(Value);
+	return *this;
+}
+
+/* Appends a comma separated list of integers as a single parameter */
+FGameJoltQueryBuilder& FGameJoltQueryBuilder::Add(const TCHAR* Key, const TArray<int32>& Values)
+{
+	AppendKey(Key);
+	for(int32 i = 0; i < Values.Num(); i++)
+	{
+		if(i > 0)
+			Query += TEXT(',');
+		Query.AppendInt(Values[i]);
+	}
+	return *this;
+}
+
+/* Appends a parameter whose value is percent-encoded already */
+FGameJoltQueryBuilder& FGameJoltQueryBuilder::AddEncoded(const TCHAR* Key, const FString& EncodedValue)
+{
+	AppendKey(Key);
+	Query += EncodedValue;
+	return *this;
+}
+
+/* Gets the built endpoint and query */
+FString FGameJoltQueryBuilder::Build()
+{
+	return MoveTemp(Query);
+}
+
+/* Appends the separator and the key of the next parameter */
+void FGameJoltQueryBuilder::AppendKey(const TCHAR* Key)
+{
+	if(Query.Len() > 0 && Query[Query.Len() - 1] != TEXT('?'))
+		Query += TEXT('&');
+	Query += Key;
+	Query += TEXT('=');
+}
+
+/* Appends the percent-encoded value to a string */
+void FGameJoltQueryBuilder::AppendEncoded(FString& Out, const FString& Value)
+{
+	AppendEncodedCharacters(Out, *Value, Value.Len());
+}
+
+/* Decodes a percent-encoded value */
+FString FGameJoltQueryBuilder::Decode(const FString& Value)
+{
+	// Decoded byte by byte, multi-byte characters are only complete in the UTF-8 form
+	TArray<ANSICHAR> Bytes;
+	Bytes.Reserve(Value.Len() + 1);
+	for(int32 i = 0; i < Value.Len(); )
+	{
+		if(Value[i] == TEXT('%') && i + 2 < Value.Len() && FChar::IsHexDigit(Value[i + 1]) && FChar::IsHexDigit(Value[i + 2]))
+		{
+			Bytes.Add(static_cast<ANSICHAR>(FParse::HexDigit(Value[i + 1]) * 16 + FParse::HexDigit(Value[i + 2])));
+			i += 3;
+			continue;
+		}
+
+		if(Value[i] < 0x80)
+		{
+			Bytes.Add(static_cast<ANSICHAR>(Value[i]));
+			i++;
+			continue;
+		}
+
+		// Characters which weren't encoded, converted as a run so surrogate pairs stay intact
+		const int32 RunEnd = FindNonAsciiRunEnd(*Value, i, Value.Len());
+		FTCHARToUTF8 Converted(*Value + i, RunEnd - i);
+		Bytes.Append(Converted.Get(), Converted.Length());
+		i = RunEnd;
+	}
+
+	FUTF8ToTCHAR Decoded(Bytes.GetData(), Bytes.Num());
+	return FString(Decoded.Length(), Decoded.Get());
+}
+
+/**
+ * Feeds the UTF-8 form of a string to a hasher in chunks, without converting the whole string
+ * Runs of non-ASCII characters are converted at once, so surrogate pairs stay intact
+ */
+template<typename HasherType>
+static void HashString(HasherType& Hasher, const FString& String)
+{
+	ANSICHAR Buffer[256];
+	int32 NumBuffered = 0;
+	for(int32 i = 0; i < String.Len(); )
+	{
+		if(String[i] < 0x80)
+		{
+			Buffer[NumBuffered++] = static_cast<ANSICHAR>(String[i]);
+			if(NumBuffered == UE_ARRAY_COUNT(Buffer))
+			{
+				Hasher.Update(reinterpret_cast<const uint8*>(Buffer), NumBuffered);
+				NumBuffered = 0;
+			}
+			i++;
+			continue;
+		}
+
+		Hasher.Update(reinterpret_cast<const uint8*>(Buffer), NumBuffered);
+		NumBuffered = 0;
+		const int32 RunEnd = FindNonAsciiRunEnd(*String, i, String.Len());
+		FTCHARToUTF8 Converted(*String + i, RunEnd - i);
+		Hasher.Update(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		i = RunEnd;
+	}
+	Hasher.Update(reinterpret_cast<const uint8*>(Buffer), NumBuffered);
+}
+
+FGameJoltRequestSigner::FGameJoltRequestSigner()
+	: Algorithm(EGameJoltSignatureAlgorithm::MD5)
+	, CachedGameID(0)
+{
+}
+
+/* Updates the cached settings */
+void FGameJoltRequestSigner::Configure(const FString& Server, const FString& Root, const FString& Version, int32 GameID, const FString& PrivateKey, EGameJoltSignatureAlgorithm InAlgorithm)
+{
+	Algorithm = InAlgorithm;
+
+	if(Server != CachedServer || Root != CachedRoot || Version != CachedVersion || UrlPrefix.IsEmpty())
+	{
+		CachedServer = Server;
+		CachedRoot = Root;
+		CachedVersion = Version;
+		UrlPrefix = TEXT("https://") + Server + Root + Version;
+	}
+
+	if(GameID != CachedGameID || GameIDParameter.IsEmpty())
+	{
+		CachedGameID = GameID;
+		GameIDParameter = TEXT("game_id=");
+		GameIDParameter.AppendInt(GameID);
+	}
+
+	if(PrivateKey != CachedPrivateKey)
+	{
+		CachedPrivateKey = PrivateKey;
+		FTCHARToUTF8 Converted(*PrivateKey);
+		PrivateKeyUTF8.Reset(Converted.Length());
+		PrivateKeyUTF8.Append(Converted.Get(), Converted.Length());
+	}
+}
+
+/* Builds the signed URL of an endpoint */
+FString FGameJoltRequestSigner::BuildUrl(const FString& Endpoint, bool bWithPrefix, const FString* UserName, const FString* UserToken) const
+{
+	// Sized for the worst case of the user info being encoded completely, plus the signature
+	int32 ExpectedLen = Endpoint.Len() + GameIDParameter.Len() + 64;
+	if(bWithPrefix)
+		ExpectedLen += UrlPrefix.Len();
+	if(UserName && UserToken)
+		ExpectedLen += (UserName->Len() + UserToken->Len()) * 3 + 24;
+
+	FString Url;
+	Url.Reserve(ExpectedLen);
+	if(bWithPrefix)
+		Url += UrlPrefix;
+	Url += Endpoint;
+
+	if(Url.Len() > 0 && Url[Url.Len() - 1] != TEXT('?') && Url[Url.Len() - 1] != TEXT('&'))
+		Url += TEXT('&');
+	Url += GameIDParameter;
+
+	if(UserName && UserToken)
+	{
+		Url += TEXT("&username=");
+		FGameJoltQueryBuilder::AppendEncoded(Url, *UserName);
+		Url += TEXT("&user_token=");
+		FGameJoltQueryBuilder::AppendEncoded(Url, *UserToken);
+	}
+
+	AppendSignature(Url);
+	return Url;
+}
+
+/* Appends the signature of everything in the URL so far */
+void FGameJoltRequestSigner::AppendSignature(FString& Url) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameJolt_Sign);
+	static const TCHAR HexDigits[] = TEXT("0123456789abcdef");
+
+	uint8 Digest[20];
+	int32 DigestSize;
+	if(Algorithm == EGameJoltSignatureAlgorithm::SHA1)
+	{
+		FSHA1 Hasher;
+		HashString(Hasher, Url);
+		Hasher.Update(reinterpret_cast<const uint8*>(PrivateKeyUTF8.GetData()), PrivateKeyUTF8.Num());
+		Hasher.Final();
+		Hasher.GetHash(Digest);
+		DigestSize = 20;
+	}
+	else
+	{
+		FMD5 Hasher;
+		HashString(Hasher, Url);
+		Hasher.Update(reinterpret_cast<const uint8*>(PrivateKeyUTF8.GetData()), PrivateKeyUTF8.Num());
+		Hasher.Final(Digest);
+		DigestSize = 16;
+	}
+
+	Url += TEXT("&signature=");
+	for(int32 i = 0; i < DigestSize; i++)
+	{
+		Url += HexDigits[Digest[i] >> 4];
+		Url += HexDigits[Digest[i] & 0xF];
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/* The maximum amount of scores the server returns for a single request */
+#define GJAPI_MAX_SCORE_LIMIT 100
+
+/**
+ * Builds the endpoint and query of a request into a single pre-sized buffer
+ * Values are percent-encoded while they are appended, without temporary strings
+ */
+class FGameJoltQueryBuilder
+{
+public:
+
+	/**
+	 * @param Endpoint The endpoint without a query, e.g. "/scores/"
+	 * @param ExpectedLen The expected length of the whole query. Used to size the buffer once
+	 */
+	explicit FGameJoltQueryBuilder(const TCHAR* Endpoint, int32 ExpectedLen = 128);
+
+	/* Appends a parameter, percent-encoding its value */
+	FGameJoltQueryBuilder& Add(const TCHAR* Key, const FString& Value);
+
+	/* Appends a parameter, percent-encoding its value */
+	FGameJoltQueryBuilder& Add(const TCHAR* Key, const TCHAR* Value);
+
+	/* Appends an integer parameter */
+	FGameJoltQueryBuilder& Add(const TCHAR* Key, int32 Value);
+
+	/* Appends a comma separated list of integers as a single parameter */
+	FGameJoltQueryBuilder& Add(const TCHAR* Key, const TArray<int32>& Values);
+
+	/* Appends a parameter whose value is percent-encoded already */
+	FGameJoltQueryBuilder& AddEncoded(const TCHAR* Key, const FString& EncodedValue);
+
+	/* Gets the length of the endpoint and query built so far */
+	int32 Len() const { return Query.Len(); }
+
+	/* Gets the built endpoint and query, leaving the builder empty */
+	FString Build();
+
+	/* Appends the percent-encoded value to a string. Unreserved characters (RFC 3986) are kept as they are */
+	static void AppendEncoded(FString& Out, const FString& Value);
+
+	/* Decodes a percent-encoded value */
+	static FString Decode(const FString& Value);
+
+private:
+
+	/* Appends the separator and the key of the next parameter */
+	void AppendKey(const TCHAR* Key);
+
+	FString Query;
+};
+
+/**
+ * Appends game_id, the user info and the signature to requests of one game
+ * Everything constant across requests (URL prefix, game_id parameter, private key) is cached until the settings change
+ */
+class FGameJoltRequestSigner
+{
+public:
+
+	FGameJoltRequestSigner();
+
+	/* Updates the cached settings. Cheap if nothing changed */
+	void Configure(const FString& Server, const FString& Root, const FString& Version, int32 GameID, const FString& PrivateKey, EGameJoltSignatureAlgorithm Algorithm);
+
+	/* Gets the URL every endpoint is appended to, e.g. "https://api.gamejolt.com/api/game/v1_2" */
+	const FString& GetUrlPrefix() const { return UrlPrefix; }
+
+	/**
+	 * Builds the signed URL of an endpoint
+	 * @param bWithPrefix Whether the URL starts with the server. Sub-requests of a batch are signed without it
+	 * @param UserName Appended as username, together with the token, if not null
+	 */
+	FString BuildUrl(const FString& Endpoint, bool bWithPrefix, const FString* UserName, const FString* UserToken) const;
+
+	/* Appends the signature of everything in the URL so far */
+	void AppendSignature(FString& Url) const;
+
+private:
+
+	FString UrlPrefix;
+
+	/* "game_id=<id>", without a separator */
+	FString GameIDParameter;
+
+	/* The private key in the encoding hashed after the URL */
+	TArray<ANSICHAR> PrivateKeyUTF8;
+
+	EGameJoltSignatureAlgorithm Algorithm;
+
+	/* The settings the cache was built from */
+	FString CachedServer;
+	FString CachedRoot;
+	FString CachedVersion;
+	int32 CachedGameID;
+	FString CachedPrivateKey;
+};
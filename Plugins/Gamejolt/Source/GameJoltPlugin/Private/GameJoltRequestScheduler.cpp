@@ -0,0 +1,162 @@
+#include "GameJoltRequestScheduler.h"
+#include "HAL/PlatformTime.h"
+#include "GameJoltStats.h"
+
+FGameJoltRequestScheduler::FGameJoltRequestScheduler()
+	: MaxConcurrent(0)
+	, PeakQueueDepth(0)
+	, Dispatched(0)
+	, Delayed(0)
+	, TotalWaitTime(0.0)
+	, MaxWaitTime(0.0)
+{
+}
+
+FGameJoltRequestScheduler::~FGameJoltRequestScheduler()
+{
+	DEC_DWORD_STAT_BY(STAT_GameJolt_Queued, Num());
+}
+
+/* Gets the endpoint class an action counts against */
+EGameJoltEndpointClass FGameJoltRequestScheduler::GetEndpointClass(EGameJoltComponentEnum Action)
+{
+	switch(Action)
+	{
+		case EGameJoltComponentEnum::GJ_USER_AUTH:
+		case EGameJoltComponentEnum::GJ_USER_AUTOLOGIN:
+		case EGameJoltComponentEnum::GJ_USER_FETCH:
+		case EGameJoltComponentEnum::GJ_USERS_FETCH:
+		case EGameJoltComponentEnum::GJ_USER_FRIENDLIST:
+			return EGameJoltEndpointClass::Users;
+		case EGameJoltComponentEnum::GJ_SESSION_OPEN:
+		case EGameJoltComponentEnum::GJ_SESSION_PING:
+		case EGameJoltComponentEnum::GJ_SESSION_CLOSE:
+		case EGameJoltComponentEnum::GJ_SESSION_CHECK:
+			return EGameJoltEndpointClass::Sessions;
+		case EGameJoltComponentEnum::GJ_TROPHIES_FETCH:
+		case EGameJoltComponentEnum::GJ_TROPHIES_ADD:
+		case EGameJoltComponentEnum::GJ_TROHIES_REMOVE:
+			return EGameJoltEndpointClass::Trophies;
+		case EGameJoltComponentEnum::GJ_SCORES_FETCH:
+		case EGameJoltComponentEnum::GJ_SCORES_ADD:
+		case EGameJoltComponentEnum::GJ_SCORES_TABLE:
+		case EGameJoltComponentEnum::GJ_SCORES_RANK:
+			return EGameJoltEndpointClass::Scores;
+		case EGameJoltComponentEnum::GJ_DATASTORE_FETCH:
+		case EGameJoltComponentEnum::GJ_DATASTORE_SET:
+		case EGameJoltComponentEnum::GJ_DATASTORE_UPDATE:
+		case EGameJoltComponentEnum::GJ_DATASTORE_REMOVE:
+		case EGameJoltComponentEnum::GJ_DATASTORE_KEYS:
+			return EGameJoltEndpointClass::DataStore;
+		default:
+			return EGameJoltEndpointClass::Misc;
+	}
+}
+
+/* Updates the limits */
+void FGameJoltRequestScheduler::Configure(const TMap<EGameJoltEndpointClass, FGameJoltRateLimit>& Limits, int32 InMaxConcurrent)
+{
+	MaxConcurrent = InMaxConcurrent;
+
+	for(auto It = Buckets.CreateIterator(); It; ++It)
+	{
+		if(!Limits.Contains(It.Key()))
+			It.RemoveCurrent();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for(const TPair<EGameJoltEndpointClass, FGameJoltRateLimit>& Limit : Limits)
+	{
+		FTokenBucket* Bucket = Buckets.Find(Limit.Key);
+		if(!Bucket)
+		{
+			// New buckets start full
+			Bucket = &Buckets.Add(Limit.Key);
+			Bucket->Tokens = Limit.Value.Burst;
+			Bucket->LastRefillTime = Now;
+		}
+		Bucket->Limit = Limit.Value;
+		Bucket->Tokens = FMath::Min(Bucket->Tokens, static_cast<float>(FMath::Max(Limit.Value.Burst, 1)));
+	}
+}
+
+/* Queues a request */
+void FGameJoltRequestScheduler::Enqueue(TSharedRef<FGameJoltRequest> GameJoltRequest, EGameJoltRequestPriority Priority)
+{
+	const EGameJoltEndpointClass EndpointClass = GetEndpointClass(GameJoltRequest->Action);
+	Queues[static_cast<uint8>(Priority)].Emplace(GameJoltRequest, EndpointClass, FPlatformTime::Seconds());
+	PeakQueueDepth = FMath::Max(PeakQueueDepth, Num());
+	INC_DWORD_STAT(STAT_GameJolt_Queued);
+}
+
+/* Takes the next request which may be sent now */
+TSharedPtr<FGameJoltRequest> FGameJoltRequestScheduler::Dequeue(int32 NumInFlight, float& OutRetryIn)
+{
+	OutRetryIn = -1.f;
+	if(MaxConcurrent > 0 && NumInFlight >= MaxConcurrent)
+		return nullptr;
+
+	const double Now = FPlatformTime::Seconds();
+	for(TArray<FQueuedRequest>& Queue : Queues)
+	{
+		for(int32 i = 0; i < Queue.Num(); i++)
+		{
+			FTokenBucket* Bucket = Buckets.Find(Queue[i].EndpointClass);
+			if(Bucket)
+			{
+				Refill(*Bucket, Now);
+				if(Bucket->Tokens < 1.f)
+				{
+					const float RetryIn = (1.f - Bucket->Tokens) / FMath::Max(Bucket->Limit.RequestsPerSecond, 0.01f);
+					OutRetryIn = OutRetryIn < 0.f ? RetryIn : FMath::Min(OutRetryIn, RetryIn);
+					continue;
+				}
+				Bucket->Tokens -= 1.f;
+			}
+
+			TSharedRef<FGameJoltRequest> Request = Queue[i].Request;
+			const double WaitTime = Now - Queue[i].EnqueueTime;
+			Queue.RemoveAt(i);
+			DEC_DWORD_STAT(STAT_GameJolt_Queued);
+
+			Dispatched++;
+			TotalWaitTime += WaitTime;
+			MaxWaitTime = FMath::Max(MaxWaitTime, WaitTime);
+			// Anything beyond the frame it was queued in counts as delayed
+			if(WaitTime > 0.001)
+				Delayed++;
+			return Request;
+		}
+	}
+	return nullptr;
+}
+
+/* Gets the amount of queued requests */
+int32 FGameJoltRequestScheduler::Num() const
+{
+	int32 Total = 0;
+	for(const TArray<FQueuedRequest>& Queue : Queues)
+		Total += Queue.Num();
+	return Total;
+}
+
+/* Gets the counters */
+FGameJoltSchedulerStats FGameJoltRequestScheduler::GetStats() const
+{
+	FGameJoltSchedulerStats Stats;
+	Stats.QueueDepth = Num();
+	Stats.PeakQueueDepth = PeakQueueDepth;
+	Stats.Dispatched = Dispatched;
+	Stats.Delayed = Delayed;
+	Stats.AverageWaitTime = Dispatched > 0 ? static_cast<float>(TotalWaitTime / Dispatched) : 0.f;
+	Stats.MaxWaitTime = static_cast<float>(MaxWaitTime);
+	return Stats;
+}
+
+/* Adds the tokens refilled since the last refill */
+void FGameJoltRequestScheduler::Refill(FTokenBucket& Bucket, double Now)
+{
+	const double Elapsed = Now - Bucket.LastRefillTime;
+	Bucket.LastRefillTime = Now;
+	Bucket.Tokens = FMath::Min(Bucket.Tokens + static_cast<float>(Elapsed * Bucket.Limit.RequestsPerSecond), static_cast<float>(FMath::Max(Bucket.Limit.Burst, 1)));
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/**
+ * Admission control for outgoing requests
+ * Requests wait in one FIFO queue per priority. The highest priority request whose endpoint class has a token left goes first,
+ * so a throttled class doesn't hold back the requests of other classes
+ */
+class FGameJoltRequestScheduler
+{
+public:
+
+	FGameJoltRequestScheduler();
+
+	~FGameJoltRequestScheduler();
+
+	/* Gets the endpoint class an action counts against */
+	static EGameJoltEndpointClass GetEndpointClass(EGameJoltComponentEnum Action);
+
+	/**
+	 * Updates the limits. Buckets keep their tokens, capped at the new burst
+	 * @param MaxConcurrent The maximum amount of requests in flight. 0 means unlimited
+	 */
+	void Configure(const TMap<EGameJoltEndpointClass, FGameJoltRateLimit>& Limits, int32 MaxConcurrent);
+
+	/* Queues a request */
+	void Enqueue(TSharedRef<FGameJoltRequest> GameJoltRequest, EGameJoltRequestPriority Priority);
+
+	/**
+	 * Takes the next request which may be sent now and consumes its token
+	 * @param NumInFlight The amount of requests in flight
+	 * @param OutRetryIn Seconds until a token of a waiting class refills. Negative if only a free slot helps, or nothing is queued
+	 * @return The request to send. Invalid if none may be sent now
+	 */
+	TSharedPtr<FGameJoltRequest> Dequeue(int32 NumInFlight, float& OutRetryIn);
+
+	/* Gets the amount of queued requests */
+	int32 Num() const;
+
+	/* Gets the counters */
+	FGameJoltSchedulerStats GetStats() const;
+
+private:
+
+	/* A queued request */
+	struct FQueuedRequest
+	{
+		TSharedRef<FGameJoltRequest> Request;
+		EGameJoltEndpointClass EndpointClass;
+
+		/* FPlatformTime::Seconds() when the request was queued */
+		double EnqueueTime;
+
+		FQueuedRequest(TSharedRef<FGameJoltRequest> InRequest, EGameJoltEndpointClass InEndpointClass, double InEnqueueTime)
+			: Request(InRequest)
+			, EndpointClass(InEndpointClass)
+			, EnqueueTime(InEnqueueTime)
+		{
+		}
+	};
+
+	/* The token bucket of an endpoint class */
+	struct FTokenBucket
+	{
+		FGameJoltRateLimit Limit;
+		float Tokens;
+		double LastRefillTime;
+	};
+
+	/* Adds the tokens refilled since the last refill */
+	static void Refill(FTokenBucket& Bucket, double Now);
+
+	/* Queues by priority, highest first */
+	TArray<FQueuedRequest> Queues[3];
+
+	/* Buckets of the limited endpoint classes */
+	TMap<EGameJoltEndpointClass, FTokenBucket> Buckets;
+
+	int32 MaxConcurrent;
+
+	int32 PeakQueueDepth;
+	int32 Dispatched;
+	int32 Delayed;
+	double TotalWaitTime;
+	double MaxWaitTime;
+};
@@ -0,0 +1,127 @@
+#include "GameJoltResponseCache.h"
+#include "HAL/PlatformTime.h"
+
+FGameJoltResponseCache::FGameJoltResponseCache(int32 InMaxEntries)
+	: Hits(0)
+	, StaleHits(0)
+	, Misses(0)
+	, Evictions(0)
+	, MaxEntries(InMaxEntries)
+{
+}
+
+/* Looks up a response */
+EGameJoltCacheLookup FGameJoltResponseCache::Find(const FString& Key, float TimeToLive, float StaleWindow, TSharedPtr<FJsonObject>& OutData, bool& bOutNeedsRefresh)
+{
+	bOutNeedsRefresh = false;
+
+	FGameJoltCacheEntry* Entry = Entries.Find(Key);
+	if(!Entry)
+	{
+		Misses++;
+		return EGameJoltCacheLookup::Miss;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const double Age = Now - Entry->StoredTime;
+	if(Age > TimeToLive + StaleWindow)
+	{
+		// Kept as a fallback while the server can't be reached, until it is replaced or evicted
+		Misses++;
+		return EGameJoltCacheLookup::Miss;
+	}
+
+	Entry->LastAccessTime = Now;
+	OutData = Entry->Data;
+	if(Age <= TimeToLive)
+	{
+		Hits++;
+		return EGameJoltCacheLookup::Fresh;
+	}
+
+	StaleHits++;
+	bOutNeedsRefresh = !Entry->bRefreshing;
+	Entry->bRefreshing = true;
+	return EGameJoltCacheLookup::Stale;
+}
+
+/* Stores a response */
+void FGameJoltResponseCache::Store(const FString& Key, EGameJoltComponentEnum Action, const TSharedPtr<FJsonObject>& Data)
+{
+	FGameJoltCacheEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.Action = Action;
+	Entry.Data = Data;
+	Entry.StoredTime = FPlatformTime::Seconds();
+	Entry.LastAccessTime = Entry.StoredTime;
+	Entry.bRefreshing = false;
+
+	EnforceMaxEntries();
+}
+
+/* Looks up a response regardless of its age */
+bool FGameJoltResponseCache::FindAnyAge(const FString& Key, TSharedPtr<FJsonObject>& OutData)
+{
+	FGameJoltCacheEntry* Entry = Entries.Find(Key);
+	if(!Entry)
+		return false;
+
+	Entry->LastAccessTime = FPlatformTime::Seconds();
+	OutData = Entry->Data;
+	StaleHits++;
+	return true;
+}
+
+/* Allows the next stale lookup to revalidate the entry again */
+void FGameJoltResponseCache::EndRefresh(const FString& Key)
+{
+	if(FGameJoltCacheEntry* Entry = Entries.Find(Key))
+		Entry->bRefreshing = false;
+}
+
+/* Removes all entries the predicate returns true for */
+void FGameJoltResponseCache::Invalidate(TFunctionRef<bool(const FString& Key, EGameJoltComponentEnum Action)> Predicate)
+{
+	for(auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if(Predicate(It.Key(), It.Value().Action))
+		{
+			It.RemoveCurrent();
+			Evictions++;
+		}
+	}
+}
+
+/* Removes all entries */
+void FGameJoltResponseCache::Empty()
+{
+	Evictions += Entries.Num();
+	Entries.Empty();
+}
+
+/* Changes the maximum amount of entries */
+void FGameJoltResponseCache::SetMaxEntries(int32 InMaxEntries)
+{
+	MaxEntries = InMaxEntries;
+	EnforceMaxEntries();
+}
+
+/* Removes the least recently used entries until the cap is met */
+void FGameJoltResponseCache::EnforceMaxEntries()
+{
+	while(MaxEntries > 0 && Entries.Num() > MaxEntries)
+	{
+		const FString* OldestKey = nullptr;
+		double OldestAccessTime = TNumericLimits<double>::Max();
+		for(const TPair<FString, FGameJoltCacheEntry>& Pair : Entries)
+		{
+			if(Pair.Value.LastAccessTime < OldestAccessTime)
+			{
+				OldestAccessTime = Pair.Value.LastAccessTime;
+				OldestKey = &Pair.Key;
+			}
+		}
+
+		Entries.Remove(FString(*OldestKey));
+		Evictions++;
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/* Result of a cache lookup */
+enum class EGameJoltCacheLookup : uint8
+{
+	/* Not cached, or expired beyond the stale window */
+	Miss,
+	/* Cached and within its time to live */
+	Fresh,
+	/* Expired, but still within the stale window. Can be served while it is revalidated */
+	Stale
+};
+
+/* A cached response */
+struct FGameJoltCacheEntry
+{
+	EGameJoltComponentEnum Action;
+
+	/* The parsed response, including the "response" envelope */
+	TSharedPtr<FJsonObject> Data;
+
+	/* FPlatformTime::Seconds() when the response was stored */
+	double StoredTime;
+
+	/* FPlatformTime::Seconds() when the response was looked up last. Used to evict the least recently used entry */
+	double LastAccessTime;
+
+	/* Whether a request revalidating the stale entry is in flight */
+	bool bRefreshing;
+
+	FGameJoltCacheEntry()
+		: Action(EGameJoltComponentEnum::GJ_OTHER)
+		, StoredTime(0.0)
+		, LastAccessTime(0.0)
+		, bRefreshing(false)
+	{
+	}
+};
+
+/**
+ * In-memory cache of parsed responses of read requests, keyed by endpoint and user
+ * Entries expire after a time to live and can be served stale while they are revalidated
+ * Expired entries stay until they are evicted, so they can still be served while the server can't be reached
+ */
+class FGameJoltResponseCache
+{
+public:
+
+	explicit FGameJoltResponseCache(int32 InMaxEntries);
+
+	/**
+	 * Looks up a response
+	 * @param TimeToLive Seconds a response is served without revalidation
+	 * @param StaleWindow Seconds after TimeToLive a response is still served while it is revalidated
+	 * @param OutData The cached response. Only valid if it wasn't a miss
+	 * @param bOutNeedsRefresh Whether the caller has to revalidate the stale response. Only true for the first stale lookup
+	 */
+	EGameJoltCacheLookup Find(const FString& Key, float TimeToLive, float StaleWindow, TSharedPtr<FJsonObject>& OutData, bool& bOutNeedsRefresh);
+
+	/* Looks up a response regardless of its age, e.g. to serve it while the server can't be reached. Counts as a stale hit */
+	bool FindAnyAge(const FString& Key, TSharedPtr<FJsonObject>& OutData);
+
+	/* Stores a response, evicting the least recently used one if the cache is full */
+	void Store(const FString& Key, EGameJoltComponentEnum Action, const TSharedPtr<FJsonObject>& Data);
+
+	/* Allows the next stale lookup to revalidate the entry again, e.g. after the revalidation failed */
+	void EndRefresh(const FString& Key);
+
+	/* Removes all entries the predicate returns true for */
+	void Invalidate(TFunctionRef<bool(const FString& Key, EGameJoltComponentEnum Action)> Predicate);
+
+	/* Removes all entries */
+	void Empty();
+
+	/* Changes the maximum amount of entries */
+	void SetMaxEntries(int32 InMaxEntries);
+
+	/* Gets the amount of entries */
+	int32 Num() const { return Entries.Num(); }
+
+	/* Lookups served within the time to live */
+	int32 Hits;
+
+	/* Lookups served within the stale window */
+	int32 StaleHits;
+
+	/* Lookups which had to go to the server */
+	int32 Misses;
+
+	/* Entries removed because they were invalidated or the cache was full */
+	int32 Evictions;
+
+private:
+
+	/* Removes the least recently used entries until the cap is met */
+	void EnforceMaxEntries();
+
+	TMap<FString, FGameJoltCacheEntry> Entries;
+
+	int32 MaxEntries;
+};
@@ -0,0 +1,153 @@
+#include "GameJoltResponseDecoder.h"
+#include "GameJoltPluginModule.h"
+#include "Dom/JsonObject.h"
+
+/* Calls the visitor for every object in the array field of the response, after pre-sizing the output array */
+template<typename ElementType, typename VisitorType>
+static bool DecodeObjectArray(const TSharedPtr<FJsonObject>& Response, const TCHAR* Key, TArray<ElementType>& OutArray, VisitorType Visitor)
+{
+	OutArray.Reset();
+
+	const TArray<TSharedPtr<FJsonValue>>* Values;
+	if(!Response.IsValid() || !Response->TryGetArrayField(Key, Values))
+	{
+		UE_LOG(GJAPI, Error, TEXT("Array entry '%s' not found in the response!"), Key);
+		return false;
+	}
+
+	OutArray.Reserve(Values->Num());
+	for(const TSharedPtr<FJsonValue>& Value : *Values)
+	{
+		const TSharedPtr<FJsonObject>* Object;
+		if(Value.IsValid() && Value->TryGetObject(Object))
+			Visitor(**Object, OutArray.AddDefaulted_GetRef());
+	}
+	return true;
+}
+
+/* Decodes the "scores" of a scoreboard */
+bool FGameJoltResponseDecoder::DecodeScores(const TSharedPtr<FJsonObject>& Response, TArray<FScoreInfo>& OutScores)
+{
+	return DecodeObjectArray(Response, TEXT("scores"), OutScores, [](const FJsonObject& Object, FScoreInfo& Score)
+	{
+		Score.ScoreSort = DecodeInt(Object, TEXT("sort"));
+		Score.ScoreString = DecodeString(Object, TEXT("score"));
+		Score.ExtraData = DecodeString(Object, TEXT("extra_data"));
+		Score.UserName = DecodeString(Object, TEXT("user"));
+		Score.UserID = DecodeInt(Object, TEXT("user_id"));
+		Score.Guest = DecodeString(Object, TEXT("guest"));
+		Score.UnixTimestamp = DecodeString(Object, TEXT("stored"));
+		// Older servers send a unix timestamp in "stored", current ones a relative time next to "stored_timestamp"
+		Score.TimeStamp = FDateTime::FromUnixTimestamp(Object.HasField(TEXT("stored_timestamp")) ? DecodeInt(Object, TEXT("stored_timestamp")) : DecodeInt(Object, TEXT("stored")));
+	});
+}
+
+/* Decodes the "users" of a user fetch */
+bool FGameJoltResponseDecoder::DecodeUsers(const TSharedPtr<FJsonObject>& Response, TArray<FUserInfo>& OutUsers)
+{
+	return DecodeObjectArray(Response, TEXT("users"), OutUsers, [](const FJsonObject& Object, FUserInfo& User)
+	{
+		User.S_User_ID = DecodeInt(Object, TEXT("id"));
+		User.User_Name = DecodeString(Object, TEXT("username"));
+		User.User_Type = DecodeString(Object, TEXT("type"));
+		User.User_AvatarURL = DecodeString(Object, TEXT("avatar_url"));
+		User.Signed_up = DecodeString(Object, TEXT("signed_up"));
+		User.Last_Logged_in = DecodeString(Object, TEXT("last_logged_in"));
+		User.status = DecodeString(Object, TEXT("status"));
+	});
+}
+
+/* Decodes the "trophies" of a trophy fetch */
+bool FGameJoltResponseDecoder::DecodeTrophies(const TSharedPtr<FJsonObject>& Response, TArray<FTrophyInfo>& OutTrophies)
+{
+	return DecodeObjectArray(Response, TEXT("trophies"), OutTrophies, [](const FJsonObject& Object, FTrophyInfo& Trophy)
+	{
+		Trophy.Trophy_ID = DecodeInt(Object, TEXT("id"));
+		Trophy.Name = DecodeString(Object, TEXT("title"));
+		Trophy.Description = DecodeString(Object, TEXT("description"));
+		Trophy.Difficulty = DecodeString(Object, TEXT("difficulty"));
+		Trophy.image_url = DecodeString(Object, TEXT("image_url"));
+		Trophy.achieved = DecodeString(Object, TEXT("achieved"));
+	});
+}
+
+/* Decodes the "tables" of a scoreboard table fetch */
+bool FGameJoltResponseDecoder::DecodeScoreTables(const TSharedPtr<FJsonObject>& Response, TArray<FScoreTableInfo>& OutTables)
+{
+	return DecodeObjectArray(Response, TEXT("tables"), OutTables, [](const FJsonObject& Object, FScoreTableInfo& Table)
+	{
+		Table.Id = DecodeInt(Object, TEXT("id"));
+		Table.Name = DecodeString(Object, TEXT("name"));
+		Table.Description = DecodeString(Object, TEXT("description"));
+		Table.Primary = DecodeString(Object, TEXT("primary"));
+	});
+}
+
+/* Decodes the "friends" of a friendlist fetch */
+bool FGameJoltResponseDecoder::DecodeFriendlist(const TSharedPtr<FJsonObject>& Response, TArray<int32>& OutFriendIDs)
+{
+	return DecodeObjectArray(Response, TEXT("friends"), OutFriendIDs, [](const FJsonObject& Object, int32& FriendID)
+	{
+		FriendID = DecodeInt(Object, TEXT("friend_id"));
+	});
+}
+
+/* Decodes the "keys" of a data-store key fetch */
+bool FGameJoltResponseDecoder::DecodeDataKeys(const TSharedPtr<FJsonObject>& Response, TArray<FString>& OutKeys)
+{
+	return DecodeObjectArray(Response, TEXT("keys"), OutKeys, [](const FJsonObject& Object, FString& Key)
+	{
+		Key = DecodeString(Object, TEXT("key"));
+	});
+}
+
+/* Decodes the fields of a server time fetch */
+bool FGameJoltResponseDecoder::DecodeServerTime(const TSharedPtr<FJsonObject>& Response, FDateTime& OutServerTime)
+{
+	if(!DecodeSuccess(Response))
+	{
+		UE_LOG(GJAPI, Error, TEXT("Can't read time: Request failed!"));
+		OutServerTime = FDateTime();
+		return false;
+	}
+
+	const int32 Year = DecodeInt(*Response, TEXT("year"));
+	const int32 Month = DecodeInt(*Response, TEXT("month"));
+	const int32 Day = DecodeInt(*Response, TEXT("day"));
+	const int32 Hour = DecodeInt(*Response, TEXT("hour"));
+	const int32 Minute = DecodeInt(*Response, TEXT("minute"));
+	const int32 Second = DecodeInt(*Response, TEXT("second"));
+	if(!FDateTime::Validate(Year, Month, Day, Hour, Minute, Second, 0))
+	{
+		OutServerTime = FDateTime();
+		return false;
+	}
+
+	OutServerTime = FDateTime(Year, Month, Day, Hour, Minute, Second);
+	return true;
+}
+
+/* Decodes the "success" field */
+bool FGameJoltResponseDecoder::DecodeSuccess(const TSharedPtr<FJsonObject>& Response)
+{
+	bool bSuccess = false;
+	if(Response.IsValid())
+		Response->TryGetBoolField(TEXT("success"), bSuccess);
+	return bSuccess;
+}
+
+/* Decodes a string field */
+FString FGameJoltResponseDecoder::DecodeString(const FJsonObject& Object, const TCHAR* Key)
+{
+	FString Value;
+	Object.TryGetStringField(Key, Value);
+	return Value;
+}
+
+/* Decodes an integer field */
+int32 FGameJoltResponseDecoder::DecodeInt(const FJsonObject& Object, const TCHAR* Key)
+{
+	int32 Value = 0;
+	Object.TryGetNumberField(Key, Value);
+	return Value;
+}
@@ -0,0 +1,96 @@
+#include "GameJoltScoreSubmitter.h"
+
+/* Gets the key of a player */
+FString FGameJoltScoreSubmitter::GetPlayerKey(const FString& UserName, const FString& Guest)
+{
+	if(!UserName.IsEmpty())
+		return TEXT("user:") + UserName.ToLower();
+	return TEXT("guest:") + Guest;
+}
+
+/* Sets the tables whose better scores have lower sort values */
+void FGameJoltScoreSubmitter::SetAscendingTables(const TArray<int32>& TableIDs)
+{
+	AscendingTables.Reset();
+	AscendingTables.Append(TableIDs);
+}
+
+/* Whether a score is better than the personal best of its player and the score held back for them */
+bool FGameJoltScoreSubmitter::IsImprovement(int32 TableID, const FString& Player, int32 Sort) const
+{
+	const FString Key = GetKey(TableID, Player);
+	if(const int32* Best = Bests.Find(Key))
+	{
+		if(!IsBetter(TableID, Sort, *Best))
+			return false;
+	}
+	if(const FGameJoltHeldScore* HeldScore = HeldScores.Find(Key))
+	{
+		if(!IsBetter(TableID, Sort, HeldScore->Sort))
+			return false;
+	}
+	return true;
+}
+
+/* Holds a score back until the window ends */
+bool FGameJoltScoreSubmitter::Hold(const FGameJoltHeldScore& Score)
+{
+	const FString Key = GetKey(Score.TableID, Score.Player);
+	const bool bCollapsed = HeldScores.Contains(Key);
+	HeldScores.Add(Key, Score);
+	return bCollapsed;
+}
+
+/* Removes and returns all scores held back */
+TArray<FGameJoltHeldScore> FGameJoltScoreSubmitter::TakeHeldScores()
+{
+	TArray<FGameJoltHeldScore> Scores;
+	HeldScores.GenerateValueArray(Scores);
+	HeldScores.Empty();
+	return Scores;
+}
+
+/* Sets the personal best of a player to a score which is being sent */
+TOptional<int32> FGameJoltScoreSubmitter::SetBest(int32 TableID, const FString& Player, int32 Sort)
+{
+	TOptional<int32> PreviousBest;
+	int32& Best = Bests.FindOrAdd(GetKey(TableID, Player), Sort);
+	if(Best != Sort)
+		PreviousBest = Best;
+	Best = Sort;
+	return PreviousBest;
+}
+
+/* Restores the previous personal best, unless a better score was sent in the meantime */
+void FGameJoltScoreSubmitter::RestoreBest(int32 TableID, const FString& Player, int32 Sort, TOptional<int32> PreviousBest)
+{
+	const FString Key = GetKey(TableID, Player);
+	const int32* Best = Bests.Find(Key);
+	if(!Best || *Best != Sort)
+		return;
+
+	if(PreviousBest.IsSet())
+		Bests.Add(Key, PreviousBest.GetValue());
+	else
+		Bests.Remove(Key);
+}
+
+/* Raises the personal best of a player to a score fetched from the server */
+void FGameJoltScoreSubmitter::UpdateBest(int32 TableID, const FString& Player, int32 Sort)
+{
+	int32& Best = Bests.FindOrAdd(GetKey(TableID, Player), Sort);
+	if(IsBetter(TableID, Sort, Best))
+		Best = Sort;
+}
+
+/* Whether a sort value is better than another one on a table */
+bool FGameJoltScoreSubmitter::IsBetter(int32 TableID, int32 Sort, int32 OtherSort) const
+{
+	return AscendingTables.Contains(TableID) ? Sort < OtherSort : Sort > OtherSort;
+}
+
+/* Gets the key of a player on a table */
+FString FGameJoltScoreSubmitter::GetKey(int32 TableID, const FString& Player)
+{
+	return FString::Printf(TEXT("%d|%s"), TableID, *Player);
+}
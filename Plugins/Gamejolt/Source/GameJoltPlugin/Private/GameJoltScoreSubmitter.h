@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* A score held back until the end of its submission window */
+struct FGameJoltHeldScore
+{
+	FString UserScore;
+	int32 Sort;
+	FString Guest;
+	FString ExtraData;
+	int32 TableID;
+
+	/* Identifies the player the score belongs to, see FGameJoltScoreSubmitter::GetPlayerKey */
+	FString Player;
+
+	FGameJoltHeldScore()
+		: Sort(0)
+		, TableID(0)
+	{
+	}
+};
+
+/**
+ * Decides which added scores are worth sending
+ * Keeps the personal best of every player per table, learned from the sent scores and the fetched scoreboards
+ * A score which isn't better than the personal best can't change the player's standing and isn't sent
+ * Scores added within a submission window are held back and collapsed to the best one per player and table
+ */
+class FGameJoltScoreSubmitter
+{
+public:
+
+	/* Gets the key of a player. Users are matched case insensitive, guests by their exact name */
+	static FString GetPlayerKey(const FString& UserName, const FString& Guest);
+
+	/* Sets the tables whose better scores have lower sort values. 0 for the primary one */
+	void SetAscendingTables(const TArray<int32>& TableIDs);
+
+	/* Whether a score is better than the personal best of its player and the score held back for them */
+	bool IsImprovement(int32 TableID, const FString& Player, int32 Sort) const;
+
+	/**
+	 * Holds a score back until the window ends. Replaces the held score of the same player and table
+	 * @return Whether another score was held already, so this one collapsed with it
+	 */
+	bool Hold(const FGameJoltHeldScore& Score);
+
+	/* Whether scores are held back */
+	bool HasHeldScores() const { return HeldScores.Num() > 0; }
+
+	/* Removes and returns all scores held back */
+	TArray<FGameJoltHeldScore> TakeHeldScores();
+
+	/**
+	 * Sets the personal best of a player to a score which is being sent
+	 * @return The previous personal best, to restore it if the score is rejected
+	 */
+	TOptional<int32> SetBest(int32 TableID, const FString& Player, int32 Sort);
+
+	/* Restores the previous personal best, unless a better score was sent in the meantime */
+	void RestoreBest(int32 TableID, const FString& Player, int32 Sort, TOptional<int32> PreviousBest);
+
+	/* Raises the personal best of a player to a score fetched from the server */
+	void UpdateBest(int32 TableID, const FString& Player, int32 Sort);
+
+private:
+
+	/* Whether a sort value is better than another one on a table */
+	bool IsBetter(int32 TableID, int32 Sort, int32 OtherSort) const;
+
+	/* Gets the key of a player on a table */
+	static FString GetKey(int32 TableID, const FString& Player);
+
+	TSet<int32> AscendingTables;
+
+	/* Personal bests, by table and player */
+	TMap<FString, int32> Bests;
+
+	/* Scores held back, by table and player */
+	TMap<FString, FGameJoltHeldScore> HeldScores;
+};
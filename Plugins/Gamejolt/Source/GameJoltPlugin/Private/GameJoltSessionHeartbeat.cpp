@@ -0,0 +1,190 @@
+#include "GameJoltSessionHeartbeat.h"
+#include "GameJoltPluginModule.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FGameJoltSessionHeartbeat::FGameJoltSessionHeartbeat(FGameJoltPingCallback InOnPinged)
+	: Thread(nullptr)
+	, WakeEvent(nullptr)
+	, bStopping(false)
+	, Status(static_cast<int32>(ESessionStatus::Active))
+	, LastPingTime(0.0)
+	, Interval(30.f)
+	, OnPinged(MoveTemp(InOnPinged))
+{
+}
+
+FGameJoltSessionHeartbeat::~FGameJoltSessionHeartbeat()
+{
+	Shutdown();
+}
+
+/* Starts the thread */
+bool FGameJoltSessionHeartbeat::Start(float InInterval)
+{
+	if(Thread)
+		return true;
+
+	{
+		FScopeLock Lock(&SettingsLock);
+		Interval = FMath::Max(InInterval, 1.f);
+		LastPingTime = FPlatformTime::Seconds();
+	}
+
+	bStopping = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("GameJoltSessionHeartbeat"), 0, TPri_BelowNormal);
+	if(!Thread)
+	{
+		UE_LOG(GJAPI, Error, TEXT("Could not create the session heartbeat thread"));
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		return false;
+	}
+	return true;
+}
+
+/* Stops the thread and waits for it to exit */
+void FGameJoltSessionHeartbeat::Shutdown()
+{
+	if(!Thread)
+		return;
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+/* Whether the thread is running */
+bool FGameJoltSessionHeartbeat::IsRunning() const
+{
+	return Thread != nullptr;
+}
+
+/* Sets the status sent with the next ping */
+void FGameJoltSessionHeartbeat::SetStatus(ESessionStatus InStatus)
+{
+	Status.Set(static_cast<int32>(InStatus));
+}
+
+/* Gets the status sent with the next ping */
+ESessionStatus FGameJoltSessionHeartbeat::GetStatus() const
+{
+	return static_cast<ESessionStatus>(Status.GetValue());
+}
+
+/* Copies the settings the pings are signed with */
+void FGameJoltSessionHeartbeat::SetRequestSettings(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InTransport, const FGameJoltRequestSigner& InSigner, const FString& InUserName, const FString& InUserToken)
+{
+	FScopeLock Lock(&SettingsLock);
+	Transport = InTransport;
+	Signer = InSigner;
+	UserName = InUserName;
+	UserToken = InUserToken;
+}
+
+/* Whether the next ping is due within the specified seconds */
+bool FGameJoltSessionHeartbeat::IsPingDue(float Within) const
+{
+	FScopeLock Lock(&SettingsLock);
+	return FPlatformTime::Seconds() + Within >= LastPingTime + Interval;
+}
+
+/* Restarts the interval */
+void FGameJoltSessionHeartbeat::NotifyPinged()
+{
+	FScopeLock Lock(&SettingsLock);
+	LastPingTime = FPlatformTime::Seconds();
+}
+
+/* Builds the endpoint of a ping with the current status */
+FString FGameJoltSessionHeartbeat::BuildPingEndpoint() const
+{
+	return FGameJoltQueryBuilder(TEXT("/sessions/ping/")).Add(TEXT("status"), GetStatus() == ESessionStatus::Active ? TEXT("active") : TEXT("idle")).Build();
+}
+
+/* Sends the request closing the session, without a callback */
+void FGameJoltSessionHeartbeat::SendClose()
+{
+	SendSigned(TEXT("/sessions/close/?"), false);
+}
+
+/* Pings once per interval until the thread is stopped */
+uint32 FGameJoltSessionHeartbeat::Run()
+{
+	while(!bStopping)
+	{
+		double NextPingTime;
+		{
+			FScopeLock Lock(&SettingsLock);
+			NextPingTime = LastPingTime + Interval;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if(Now < NextPingTime)
+		{
+			WakeEvent->Wait(FMath::Max(1, FMath::CeilToInt((NextPingTime - Now) * 1000.0)));
+			continue;
+		}
+
+		NotifyPinged();
+		SendSigned(BuildPingEndpoint(), true);
+	}
+	return 0;
+}
+
+/* Makes the thread exit */
+void FGameJoltSessionHeartbeat::Stop()
+{
+	bStopping = true;
+	if(WakeEvent)
+		WakeEvent->Trigger();
+}
+
+/* Signs the endpoint with the copied settings and hands it to the transport */
+void FGameJoltSessionHeartbeat::SendSigned(const FString& Endpoint, bool bNotify)
+{
+	FString Url;
+	TSharedPtr<IGameJoltTransport, ESPMode::ThreadSafe> PingTransport;
+	{
+		FScopeLock Lock(&SettingsLock);
+		if(!Transport.IsValid() || Signer.GetUrlPrefix().IsEmpty())
+			return;
+		Url = Signer.BuildUrl(Endpoint, true, &UserName, &UserToken);
+		PingTransport = Transport;
+	}
+
+	// Completion is called on the game thread, whenever it gets to it. The ping is on its way already
+	FGameJoltTransportCallback OnComplete;
+	if(bNotify && OnPinged)
+	{
+		FGameJoltPingCallback Callback = OnPinged;
+		OnComplete = [Callback](bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& Content)
+		{
+			if(!bWasSuccessful || ResponseCode >= 500)
+			{
+				Callback(false, false);
+				return;
+			}
+
+			bool bSuccess = false;
+			TSharedPtr<FJsonObject> Data;
+			const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+			TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(FString(Converted.Length(), Converted.Get()));
+			const TSharedPtr<FJsonObject>* ResponseObject;
+			if(FJsonSerializer::Deserialize(JsonReader, Data) && Data.IsValid() && Data->TryGetObjectField(TEXT("response"), ResponseObject))
+				(*ResponseObject)->TryGetBoolField(TEXT("success"), bSuccess);
+			Callback(true, bSuccess);
+		};
+	}
+
+	PingTransport->Send(Url, FString(), MoveTemp(OnComplete));
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltRequestBuilder.h"
+
+/**
+ * Called on the game thread once a ping of the heartbeat completed
+ * @param bReachedServer Whether the server answered at all
+ * @param bSucceeded Whether the server reported success. False while reached means the session expired
+ */
+typedef TFunction<void(bool bReachedServer, bool bSucceeded)> FGameJoltPingCallback;
+
+/**
+ * Pings the open session of one user from its own thread
+ * The pings are signed and handed to the transport without the game thread, so they keep going during level loads and long frames
+ * The game thread only updates the status and the request settings
+ */
+class FGameJoltSessionHeartbeat : public FRunnable
+{
+public:
+
+	/* @param InOnPinged Called on the game thread once a ping completed */
+	explicit FGameJoltSessionHeartbeat(FGameJoltPingCallback InOnPinged);
+
+	virtual ~FGameJoltSessionHeartbeat();
+
+	/**
+	 * Starts the thread. The first ping is sent after one interval, the session was just opened
+	 * @param InInterval Seconds between two pings
+	 * @return Whether the thread could be created
+	 */
+	bool Start(float InInterval);
+
+	/* Stops the thread and waits for it to exit. No ping is sent afterwards */
+	void Shutdown();
+
+	/* Whether the thread is running */
+	bool IsRunning() const;
+
+	/* Sets the status sent with the next ping */
+	void SetStatus(ESessionStatus InStatus);
+
+	/* Gets the status sent with the next ping */
+	ESessionStatus GetStatus() const;
+
+	/* Copies the settings the pings are signed with. Called on the game thread whenever they might have changed */
+	void SetRequestSettings(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InTransport, const FGameJoltRequestSigner& InSigner, const FString& InUserName, const FString& InUserToken);
+
+	/* Whether the next ping is due within the specified seconds */
+	bool IsPingDue(float Within) const;
+
+	/* Restarts the interval, e.g. because a ping went out within a batch */
+	void NotifyPinged();
+
+	/* Builds the endpoint of a ping with the current status, without game_id, user info and signature */
+	FString BuildPingEndpoint() const;
+
+	/* Sends the request closing the session, without a callback. Used on shutdown, when nothing may be called back */
+	void SendClose();
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+
+	/* Signs the endpoint with the copied settings and hands it to the transport */
+	void SendSigned(const FString& Endpoint, bool bNotify);
+
+	FRunnableThread* Thread;
+
+	/* Wakes the thread up early to exit */
+	FEvent* WakeEvent;
+
+	FThreadSafeBool bStopping;
+
+	/* Guards the settings and the ping time, which are shared with the game thread */
+	mutable FCriticalSection SettingsLock;
+
+	TSharedPtr<IGameJoltTransport, ESPMode::ThreadSafe> Transport;
+	FGameJoltRequestSigner Signer;
+	FString UserName;
+	FString UserToken;
+
+	/* ESessionStatus of the next ping */
+	FThreadSafeCounter Status;
+
+	/* FPlatformTime::Seconds of the last ping */
+	double LastPingTime;
+
+	float Interval;
+
+	FGameJoltPingCallback OnPinged;
+};
@@ -0,0 +1,76 @@
+#include "GameJoltStats.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+DEFINE_STAT(STAT_GameJolt_BuildUrl);
+DEFINE_STAT(STAT_GameJolt_Sign);
+DEFINE_STAT(STAT_GameJolt_Parse);
+DEFINE_STAT(STAT_GameJolt_Broadcast);
+
+DEFINE_STAT(STAT_GameJolt_InFlight);
+DEFINE_STAT(STAT_GameJolt_Queued);
+DEFINE_STAT(STAT_GameJolt_Failed);
+DEFINE_STAT(STAT_GameJolt_Retried);
+DEFINE_STAT(STAT_GameJolt_ScoresSkipped);
+DEFINE_STAT(STAT_GameJolt_DataWritesMerged);
+DEFINE_STAT(STAT_GameJolt_DataWritesFlushed);
+DEFINE_STAT(STAT_GameJolt_UserLookupsMerged);
+DEFINE_STAT(STAT_GameJolt_ImageMemory);
+
+#if UE_TRACE_ENABLED
+
+UE_TRACE_CHANNEL_DEFINE(GameJoltChannel)
+
+UE_TRACE_EVENT_BEGIN(GameJolt, RequestBegin)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, RequestId)
+	UE_TRACE_EVENT_FIELD(uint8, Action)
+	UE_TRACE_EVENT_FIELD(uint32, PayloadSize)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(GameJolt, RequestEnd)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, RequestId)
+	UE_TRACE_EVENT_FIELD(uint32, ResponseSize)
+	UE_TRACE_EVENT_FIELD(uint8, RetryCount)
+	UE_TRACE_EVENT_FIELD(bool, bSucceeded)
+	UE_TRACE_EVENT_FIELD(bool, bFromCache)
+UE_TRACE_EVENT_END()
+
+#endif
+
+/* Traces the start of a request */
+void FGameJoltRequestTrace::Begin(const FGameJoltRequest& GameJoltRequest)
+{
+#if UE_TRACE_ENABLED
+	// The endpoint is attached as TCHARs, without a terminator. Long queries are cut off
+	const uint16 EndpointSize = static_cast<uint16>(FMath::Min(GameJoltRequest.Endpoint.Len(), 1024) * sizeof(TCHAR));
+	UE_TRACE_LOG(GameJolt, RequestBegin, GameJoltChannel, EndpointSize)
+		<< RequestBegin.Cycle(FPlatformTime::Cycles64())
+		<< RequestBegin.RequestId(GameJoltRequest.Id)
+		<< RequestBegin.Action(static_cast<uint8>(GameJoltRequest.Action))
+		<< RequestBegin.PayloadSize(GameJoltRequest.Endpoint.Len() + GameJoltRequest.Body.Len())
+		<< RequestBegin.Attachment(*GameJoltRequest.Endpoint, EndpointSize);
+
+	// Insights has no analyzer for the events above, but draws bookmarks in its timing view
+	if(UE_TRACE_CHANNELEXPR_IS_ENABLED(GameJoltChannel))
+		TRACE_BOOKMARK(TEXT("GameJolt request %u began: %s"), GameJoltRequest.Id, *GameJoltRequest.Endpoint.Left(128));
+#endif
+}
+
+/* Traces the end of a request */
+void FGameJoltRequestTrace::End(const FGameJoltRequest& GameJoltRequest)
+{
+#if UE_TRACE_ENABLED
+	UE_TRACE_LOG(GameJolt, RequestEnd, GameJoltChannel)
+		<< RequestEnd.Cycle(FPlatformTime::Cycles64())
+		<< RequestEnd.RequestId(GameJoltRequest.Id)
+		<< RequestEnd.ResponseSize(GameJoltRequest.ResponseSize)
+		<< RequestEnd.RetryCount(static_cast<uint8>(FMath::Min(GameJoltRequest.RetryCount, 255)))
+		<< RequestEnd.bSucceeded(GameJoltRequest.bSucceeded)
+		<< RequestEnd.bFromCache(GameJoltRequest.bFromCache);
+
+	if(UE_TRACE_CHANNELEXPR_IS_ENABLED(GameJoltChannel))
+		TRACE_BOOKMARK(TEXT("GameJolt request %u ended: %s"), GameJoltRequest.Id, GameJoltRequest.bFromCache ? TEXT("cached") : GameJoltRequest.bSucceeded ? TEXT("succeeded") : TEXT("failed"));
+#endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "UEGameJoltAPI.h"
+
+DECLARE_STATS_GROUP(TEXT("GameJolt"), STATGROUP_GameJolt, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build URL"), STAT_GameJolt_BuildUrl, STATGROUP_GameJolt, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sign URL"), STAT_GameJolt_Sign, STATGROUP_GameJolt, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Response"), STAT_GameJolt_Parse, STATGROUP_GameJolt, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast Delegates"), STAT_GameJolt_Broadcast, STATGROUP_GameJolt, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests In Flight"), STAT_GameJolt_InFlight, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Queued"), STAT_GameJolt_Queued, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Failed"), STAT_GameJolt_Failed, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Requests Retried"), STAT_GameJolt_Retried, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Scores Not Sent"), STAT_GameJolt_ScoresSkipped, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Data-Store Writes Merged"), STAT_GameJolt_DataWritesMerged, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Data-Store Writes Flushed"), STAT_GameJolt_DataWritesFlushed, STATGROUP_GameJolt, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("User Lookups Merged"), STAT_GameJolt_UserLookupsMerged, STATGROUP_GameJolt, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Image Memory"), STAT_GameJolt_ImageMemory, STATGROUP_GameJolt, );
+
+#if UE_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(GameJoltChannel)
+#endif
+
+/**
+ * Traces the lifetime of every request on the "GameJolt" trace channel, enabled with -trace=GameJolt
+ * A request begins when it is started and ends when its response was handled, so the span covers queueing, batching and retries
+ * Both events carry the request id to pair them up, the begin event also carries the endpoint
+ * The plugin doesn't ship an Insights analyzer for them, so both are also traced as bookmarks, which Timing Insights draws with the request id
+ */
+struct FGameJoltRequestTrace
+{
+	/* Traces the start of a request */
+	static void Begin(const FGameJoltRequest& GameJoltRequest);
+
+	/* Traces the end of a request, after its response was parsed */
+	static void End(const FGameJoltRequest& GameJoltRequest);
+};
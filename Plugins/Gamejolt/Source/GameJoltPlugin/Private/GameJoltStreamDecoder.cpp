@@ -0,0 +1,317 @@
+#include "GameJoltStreamDecoder.h"
+#include "GameJoltPluginModule.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/Archive.h"
+
+typedef TJsonReader<TCHAR> FGameJoltJsonReader;
+
+/**
+ * Decodes UTF-8 bytes into characters while the JSON reader reads them
+ * The reader asks for one character at a time, so the content never exists as a whole in characters
+ * Invalid sequences are read as U+FFFD
+ */
+class FGameJoltUtf8Archive : public FArchive
+{
+public:
+
+	explicit FGameJoltUtf8Archive(const TArray<uint8>& InBytes)
+		: Bytes(InBytes)
+		, Offset(0)
+		, PendingChar(0)
+	{
+		SetIsLoading(true);
+	}
+
+	virtual void Serialize(void* Data, int64 Num) override
+	{
+		TCHAR* Chars = static_cast<TCHAR*>(Data);
+		const int64 NumChars = Num / static_cast<int64>(sizeof(TCHAR));
+		if(NumChars * static_cast<int64>(sizeof(TCHAR)) != Num)
+		{
+			SetError();
+			return;
+		}
+
+		for(int64 i = 0; i < NumChars; i++)
+		{
+			if(AtEnd())
+			{
+				FMemory::Memzero(Chars + i, (NumChars - i) * sizeof(TCHAR));
+				SetError();
+				return;
+			}
+			Chars[i] = ReadChar();
+		}
+	}
+
+	virtual bool AtEnd() override
+	{
+		return PendingChar == 0 && Offset >= Bytes.Num();
+	}
+
+	virtual int64 Tell() override
+	{
+		return Offset;
+	}
+
+	virtual int64 TotalSize() override
+	{
+		return Bytes.Num();
+	}
+
+	virtual FString GetArchiveName() const override
+	{
+		return TEXT("FGameJoltUtf8Archive");
+	}
+
+private:
+
+	/* Decodes the next character */
+	TCHAR ReadChar()
+	{
+		static const TCHAR ReplacementChar = static_cast<TCHAR>(0xFFFD);
+
+		if(PendingChar != 0)
+		{
+			const TCHAR Char = PendingChar;
+			PendingChar = 0;
+			return Char;
+		}
+
+		const uint8 Lead = Bytes[Offset++];
+		if(Lead < 0x80)
+			return static_cast<TCHAR>(Lead);
+
+		int32 NumTrailing = 0;
+		uint32 CodePoint = 0;
+		if((Lead & 0xE0) == 0xC0)
+		{
+			NumTrailing = 1;
+			CodePoint = Lead & 0x1F;
+		}
+		else if((Lead & 0xF0) == 0xE0)
+		{
+			NumTrailing = 2;
+			CodePoint = Lead & 0x0F;
+		}
+		else if((Lead & 0xF8) == 0xF0)
+		{
+			NumTrailing = 3;
+			CodePoint = Lead & 0x07;
+		}
+		else
+		{
+			return ReplacementChar;
+		}
+
+		for(int32 i = 0; i < NumTrailing; i++)
+		{
+			if(Offset >= Bytes.Num() || (Bytes[Offset] & 0xC0) != 0x80)
+				return ReplacementChar;
+			CodePoint = (CodePoint << 6) | (Bytes[Offset++] & 0x3F);
+		}
+
+		if(CodePoint > 0x10FFFF || (CodePoint >= 0xD800 && CodePoint <= 0xDFFF))
+			return ReplacementChar;
+
+		// Where TCHAR has 16 bits, characters beyond the basic plane are read as a surrogate pair
+		if(sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+		{
+			CodePoint -= 0x10000;
+			PendingChar = static_cast<TCHAR>(0xDC00 + (CodePoint & 0x3FF));
+			return static_cast<TCHAR>(0xD800 + (CodePoint >> 10));
+		}
+		return static_cast<TCHAR>(CodePoint);
+	}
+
+	const TArray<uint8>& Bytes;
+	int32 Offset;
+
+	/* The second half of a surrogate pair, read next */
+	TCHAR PendingChar;
+};
+
+/* Reads the current value as a string, whether the server sent it as a string, a number or a boolean */
+static FString ReadValueAsString(FGameJoltJsonReader& Reader, EJsonNotation Notation)
+{
+	switch(Notation)
+	{
+		case EJsonNotation::String:
+			return Reader.GetValueAsString();
+		case EJsonNotation::Number:
+		{
+			const double Number = Reader.GetValueAsNumber();
+			return FMath::IsNearlyEqual(Number, FMath::RoundToDouble(Number)) ? FString::Printf(TEXT("%lld"), static_cast<int64>(Number)) : FString::SanitizeFloat(Number);
+		}
+		case EJsonNotation::Boolean:
+			return Reader.GetValueAsBoolean() ? TEXT("true") : TEXT("false");
+		default:
+			return FString();
+	}
+}
+
+/* Reads the current value as an integer, whether the server sent it as a string or a number */
+static int32 ReadValueAsInt(FGameJoltJsonReader& Reader, EJsonNotation Notation)
+{
+	switch(Notation)
+	{
+		case EJsonNotation::String:
+			return FCString::Atoi(*Reader.GetValueAsString());
+		case EJsonNotation::Number:
+			return static_cast<int32>(Reader.GetValueAsNumber());
+		default:
+			return 0;
+	}
+}
+
+/**
+ * Walks the tokens of a response and emits one record per object in the array field of the "response" object
+ * @param Visitor Called for every scalar field of a record with the record, the field name and the notation of the value
+ */
+template<typename RecordType, typename VisitorType>
+static bool StreamRecords(const TArray<uint8>& Content, const TCHAR* ArrayKey, int32 ExpectedNum, FGameJoltStreamEnvelope& OutEnvelope, TArray<RecordType>& OutRecords, VisitorType Visitor)
+{
+	OutEnvelope = FGameJoltStreamEnvelope();
+	OutRecords.Reset(ExpectedNum);
+
+	// The server sends UTF-8, decoded while the reader walks the tokens
+	FGameJoltUtf8Archive Stream(Content);
+	TSharedRef<FGameJoltJsonReader> Reader = TJsonReaderFactory<TCHAR>::Create(&Stream);
+
+	// 0: outside of the root object, 1: in the root object, 2: in the "response" object
+	int32 Depth = 0;
+	EJsonNotation Notation;
+	while(Reader->ReadNext(Notation))
+	{
+		if(Notation == EJsonNotation::Error)
+			break;
+
+		if(Depth == 0)
+		{
+			if(Notation == EJsonNotation::ObjectStart)
+				Depth = 1;
+			continue;
+		}
+
+		if(Notation == EJsonNotation::ObjectEnd)
+		{
+			if(--Depth == 0)
+				break;
+			continue;
+		}
+
+		const FString& Identifier = Reader->GetIdentifier();
+		if(Depth == 1)
+		{
+			if(Notation == EJsonNotation::ObjectStart && Identifier == TEXT("response"))
+				Depth = 2;
+			else if(Notation == EJsonNotation::ObjectStart)
+				Reader->SkipObject();
+			else if(Notation == EJsonNotation::ArrayStart)
+				Reader->SkipArray();
+			continue;
+		}
+
+		// Within the "response" object
+		if(Notation == EJsonNotation::ArrayStart)
+		{
+			if(Identifier != ArrayKey)
+			{
+				Reader->SkipArray();
+				continue;
+			}
+
+			while(Reader->ReadNext(Notation) && Notation != EJsonNotation::ArrayEnd && Notation != EJsonNotation::Error)
+			{
+				if(Notation == EJsonNotation::ArrayStart)
+				{
+					Reader->SkipArray();
+					continue;
+				}
+				if(Notation != EJsonNotation::ObjectStart)
+					continue;
+
+				RecordType& Record = OutRecords.AddDefaulted_GetRef();
+				while(Reader->ReadNext(Notation) && Notation != EJsonNotation::ObjectEnd && Notation != EJsonNotation::Error)
+				{
+					if(Notation == EJsonNotation::ObjectStart)
+						Reader->SkipObject();
+					else if(Notation == EJsonNotation::ArrayStart)
+						Reader->SkipArray();
+					else
+						Visitor(Record, Reader->GetIdentifier(), *Reader, Notation);
+				}
+			}
+		}
+		else if(Notation == EJsonNotation::ObjectStart)
+		{
+			Reader->SkipObject();
+		}
+		else if(Identifier == TEXT("success"))
+		{
+			OutEnvelope.bSuccess = ReadValueAsString(*Reader, Notation) == TEXT("true");
+		}
+		else if(Identifier == TEXT("message"))
+		{
+			OutEnvelope.Message = ReadValueAsString(*Reader, Notation);
+		}
+	}
+
+	if(!Reader->GetErrorMessage().IsEmpty())
+	{
+		UE_LOG(GJAPI, Error, TEXT("JSON data is invalid! %s"), *Reader->GetErrorMessage());
+		return false;
+	}
+	return Depth == 0;
+}
+
+/* Decodes the "scores" of a scoreboard */
+bool FGameJoltStreamDecoder::DecodeScores(const TArray<uint8>& Content, int32 ExpectedNum, FGameJoltStreamEnvelope& OutEnvelope, TArray<FScoreInfo>& OutScores)
+{
+	return StreamRecords(Content, TEXT("scores"), ExpectedNum, OutEnvelope, OutScores, [](FScoreInfo& Score, const FString& Field, FGameJoltJsonReader& Reader, EJsonNotation Notation)
+	{
+		if(Field == TEXT("sort"))
+			Score.ScoreSort = ReadValueAsInt(Reader, Notation);
+		else if(Field == TEXT("score"))
+			Score.ScoreString = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("extra_data"))
+			Score.ExtraData = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("user"))
+			Score.UserName = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("user_id"))
+			Score.UserID = ReadValueAsInt(Reader, Notation);
+		else if(Field == TEXT("guest"))
+			Score.Guest = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("stored"))
+		{
+			// Older servers send a unix timestamp here, current ones a relative time next to "stored_timestamp"
+			Score.UnixTimestamp = ReadValueAsString(Reader, Notation);
+			if(Score.UnixTimestamp.IsNumeric())
+				Score.TimeStamp = FDateTime::FromUnixTimestamp(FCString::Atoi64(*Score.UnixTimestamp));
+		}
+		else if(Field == TEXT("stored_timestamp"))
+			Score.TimeStamp = FDateTime::FromUnixTimestamp(ReadValueAsInt(Reader, Notation));
+	});
+}
+
+/* Decodes the "users" of a user fetch */
+bool FGameJoltStreamDecoder::DecodeUsers(const TArray<uint8>& Content, int32 ExpectedNum, FGameJoltStreamEnvelope& OutEnvelope, TArray<FUserInfo>& OutUsers)
+{
+	return StreamRecords(Content, TEXT("users"), ExpectedNum, OutEnvelope, OutUsers, [](FUserInfo& User, const FString& Field, FGameJoltJsonReader& Reader, EJsonNotation Notation)
+	{
+		if(Field == TEXT("id"))
+			User.S_User_ID = ReadValueAsInt(Reader, Notation);
+		else if(Field == TEXT("username"))
+			User.User_Name = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("type"))
+			User.User_Type = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("avatar_url"))
+			User.User_AvatarURL = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("signed_up"))
+			User.Signed_up = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("last_logged_in"))
+			User.Last_Logged_in = ReadValueAsString(Reader, Notation);
+		else if(Field == TEXT("status"))
+			User.status = ReadValueAsString(Reader, Notation);
+	});
+}
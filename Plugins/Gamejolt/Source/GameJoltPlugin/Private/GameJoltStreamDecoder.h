@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/* The envelope fields read while streaming a response */
+struct FGameJoltStreamEnvelope
+{
+	/* The "success" field of the response */
+	bool bSuccess;
+
+	/* The "message" field of the response. Only set by failed requests */
+	FString Message;
+
+	FGameJoltStreamEnvelope()
+		: bSuccess(false)
+	{
+	}
+};
+
+/**
+ * Decodes large responses token by token, straight from the received bytes into the typed structs
+ * No JSON DOM is built and the content isn't converted to a string, the bytes are decoded while the tokens are read
+ * Every decoder returns false if the content isn't valid JSON
+ */
+class FGameJoltStreamDecoder
+{
+public:
+
+	/**
+	 * Decodes the "scores" of a scoreboard
+	 * @param ExpectedNum The expected amount of scores, e.g. the limit of the request. Used to pre-size the output array
+	 */
+	static bool DecodeScores(const TArray<uint8>& Content, int32 ExpectedNum, FGameJoltStreamEnvelope& OutEnvelope, TArray<FScoreInfo>& OutScores);
+
+	/**
+	 * Decodes the "users" of a user fetch
+	 * @param ExpectedNum The expected amount of users, e.g. the amount of requested ids. Used to pre-size the output array
+	 */
+	static bool DecodeUsers(const TArray<uint8>& Content, int32 ExpectedNum, FGameJoltStreamEnvelope& OutEnvelope, TArray<FUserInfo>& OutUsers);
+};
@@ -0,0 +1,229 @@
+#include "GameJoltTestListener.h"
+
+/* Constructor */
+UGameJoltTestListener::UGameJoltTestListener(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	NumResults = 0;
+	NumFailures = 0;
+	NumUsersFetched = 0;
+	NumUserListsFetched = 0;
+	NumFriendlistsFetched = 0;
+	NumTrophiesFetched = 0;
+	NumScoreboardsFetched = 0;
+	NumScoreTablesFetched = 0;
+	NumDataKeysFetched = 0;
+	NumLookups = 0;
+	NumFriendsLeaderboardsLoaded = 0;
+	NumFriendsLeaderboardFailures = 0;
+	NumRowsLoaded = 0;
+	NumTimesFetched = 0;
+}
+
+/* Binds to the events of an API instance */
+void UGameJoltTestListener::Listen(UUEGameJoltAPI* API)
+{
+	API->OnGetResult.AddDynamic(this, &UGameJoltTestListener::HandleGetResult);
+	API->OnFailed.AddDynamic(this, &UGameJoltTestListener::HandleFailed);
+	API->OnUserAuthorized.AddDynamic(this, &UGameJoltTestListener::HandleUserAuthorized);
+	API->OnAutoLogin.AddDynamic(this, &UGameJoltTestListener::HandleAutoLogin);
+	API->OnUserFetched.AddDynamic(this, &UGameJoltTestListener::HandleUserFetched);
+	API->OnUsersFetched.AddDynamic(this, &UGameJoltTestListener::HandleUsersFetched);
+	API->OnFriendlistFetched.AddDynamic(this, &UGameJoltTestListener::HandleFriendlistFetched);
+	API->OnSessionOpened.AddDynamic(this, &UGameJoltTestListener::HandleSessionOpened);
+	API->OnSessionPinged.AddDynamic(this, &UGameJoltTestListener::HandleSessionPinged);
+	API->OnSessionClosed.AddDynamic(this, &UGameJoltTestListener::HandleSessionClosed);
+	API->OnSessionChecked.AddDynamic(this, &UGameJoltTestListener::HandleSessionChecked);
+	API->OnTrophiesFetched.AddDynamic(this, &UGameJoltTestListener::HandleTrophiesFetched);
+	API->OnTrophyRemoved.AddDynamic(this, &UGameJoltTestListener::HandleTrophyRemoved);
+	API->OnScoreAdded.AddDynamic(this, &UGameJoltTestListener::HandleScoreAdded);
+	API->OnScoreboardFetched.AddDynamic(this, &UGameJoltTestListener::HandleScoreboardFetched);
+	API->OnScoreboardTableFetched.AddDynamic(this, &UGameJoltTestListener::HandleScoreboardTableFetched);
+	API->OnRankFetched.AddDynamic(this, &UGameJoltTestListener::HandleRankFetched);
+	API->OnTimeFetched.AddDynamic(this, &UGameJoltTestListener::HandleTimeFetched);
+	API->OnDataKeysFetched.AddDynamic(this, &UGameJoltTestListener::HandleDataKeysFetched);
+}
+
+/* Binds to the events of a blob store */
+void UGameJoltTestListener::Listen(UGameJoltBlobStore* BlobStore)
+{
+	BlobStore->OnBlobSaved.AddDynamic(this, &UGameJoltTestListener::HandleBlobSaved);
+	BlobStore->OnBlobLoaded.AddDynamic(this, &UGameJoltTestListener::HandleBlobLoaded);
+}
+
+/* Binds to the events of a data-store mirror */
+void UGameJoltTestListener::Listen(UGameJoltDataStoreMirror* Mirror)
+{
+	Mirror->OnSynced.AddDynamic(this, &UGameJoltTestListener::HandleMirrorSynced);
+	Mirror->OnSyncFailed.AddDynamic(this, &UGameJoltTestListener::HandleMirrorSyncFailed);
+}
+
+/* Binds to the events of a user lookup */
+void UGameJoltTestListener::Listen(UGameJoltUserLookup* UserLookup)
+{
+	UserLookup->OnUsersLookedUp.AddDynamic(this, &UGameJoltTestListener::HandleUsersLookedUp);
+}
+
+/* Binds to the events of a friends leaderboard */
+void UGameJoltTestListener::Listen(UGameJoltFriendsLeaderboard* Leaderboard)
+{
+	Leaderboard->OnLoaded.AddDynamic(this, &UGameJoltTestListener::HandleFriendsLeaderboardLoaded);
+	Leaderboard->OnFailed.AddDynamic(this, &UGameJoltTestListener::HandleFriendsLeaderboardFailed);
+}
+
+/* Binds to the events of a leaderboard cursor */
+void UGameJoltTestListener::Listen(UGameJoltLeaderboardCursor* Cursor)
+{
+	Cursor->OnRowsLoaded.AddDynamic(this, &UGameJoltTestListener::HandleRowsLoaded);
+	Cursor->OnEndReached.AddDynamic(this, &UGameJoltTestListener::HandleEndReached);
+}
+
+void UGameJoltTestListener::HandleGetResult()
+{
+	NumResults++;
+}
+
+void UGameJoltTestListener::HandleFailed()
+{
+	NumFailures++;
+}
+
+void UGameJoltTestListener::HandleUserAuthorized(bool bIsLoggedIn)
+{
+	UserAuthorized.Add(bIsLoggedIn);
+}
+
+void UGameJoltTestListener::HandleAutoLogin(bool bIsLoggedIn)
+{
+	AutoLogins.Add(bIsLoggedIn);
+}
+
+void UGameJoltTestListener::HandleUserFetched(FUserInfo InUser)
+{
+	User = InUser;
+	NumUsersFetched++;
+}
+
+void UGameJoltTestListener::HandleUsersFetched(const TArray<FUserInfo>& InUsers)
+{
+	Users = InUsers;
+	NumUserListsFetched++;
+}
+
+void UGameJoltTestListener::HandleFriendlistFetched(const TArray<int32>& InFriendlist)
+{
+	Friendlist = InFriendlist;
+	NumFriendlistsFetched++;
+}
+
+void UGameJoltTestListener::HandleSessionOpened(bool bIsSessionOpen)
+{
+	SessionsOpened.Add(bIsSessionOpen);
+}
+
+void UGameJoltTestListener::HandleSessionPinged(bool bIsSessionStillOpen)
+{
+	SessionsPinged.Add(bIsSessionStillOpen);
+}
+
+void UGameJoltTestListener::HandleSessionClosed(bool bIsSessionClosed)
+{
+	SessionsClosed.Add(bIsSessionClosed);
+}
+
+void UGameJoltTestListener::HandleSessionChecked(bool bIsSessionStillOpen)
+{
+	SessionsChecked.Add(bIsSessionStillOpen);
+}
+
+void UGameJoltTestListener::HandleTrophiesFetched(TArray<FTrophyInfo> InTrophies)
+{
+	Trophies = InTrophies;
+	NumTrophiesFetched++;
+}
+
+void UGameJoltTestListener::HandleTrophyRemoved(bool bWasRemoved)
+{
+	TrophiesRemoved.Add(bWasRemoved);
+}
+
+void UGameJoltTestListener::HandleScoreAdded(bool bWasScoreAdded)
+{
+	ScoresAdded.Add(bWasScoreAdded);
+}
+
+void UGameJoltTestListener::HandleScoreboardFetched(const TArray<FScoreInfo>& InScores)
+{
+	Scores = InScores;
+	NumScoreboardsFetched++;
+}
+
+void UGameJoltTestListener::HandleScoreboardTableFetched(TArray<FScoreTableInfo> InScoreTables)
+{
+	ScoreTables = InScoreTables;
+	NumScoreTablesFetched++;
+}
+
+void UGameJoltTestListener::HandleRankFetched(int32 Rank)
+{
+	Ranks.Add(Rank);
+}
+
+void UGameJoltTestListener::HandleTimeFetched(FDateTime InServerTime)
+{
+	ServerTime = InServerTime;
+	NumTimesFetched++;
+}
+
+void UGameJoltTestListener::HandleDataKeysFetched(const TArray<FString>& Keys)
+{
+	DataKeys = Keys;
+	NumDataKeysFetched++;
+}
+
+void UGameJoltTestListener::HandleBlobSaved(const FString& Name, bool bWasSaved)
+{
+	BlobsSaved.Add(bWasSaved);
+}
+
+void UGameJoltTestListener::HandleBlobLoaded(const FString& Name, bool bWasLoaded, const TArray<uint8>& Data)
+{
+	BlobsLoaded.Add(bWasLoaded);
+	BlobData = Data;
+}
+
+void UGameJoltTestListener::HandleMirrorSynced(int32 NumKeys)
+{
+	MirrorSyncs.Add(NumKeys);
+}
+
+void UGameJoltTestListener::HandleMirrorSyncFailed(int32 NumFailedKeys)
+{
+	MirrorSyncFailures.Add(NumFailedKeys);
+}
+
+void UGameJoltTestListener::HandleUsersLookedUp(const TArray<FUserInfo>& InUsers)
+{
+	LookedUpUsers = InUsers;
+	NumLookups++;
+}
+
+void UGameJoltTestListener::HandleFriendsLeaderboardLoaded(const TArray<FScoreInfo>& InScores)
+{
+	FriendScores = InScores;
+	NumFriendsLeaderboardsLoaded++;
+}
+
+void UGameJoltTestListener::HandleFriendsLeaderboardFailed()
+{
+	NumFriendsLeaderboardFailures++;
+}
+
+void UGameJoltTestListener::HandleRowsLoaded(int32 FirstIndex, int32 NumRows)
+{
+	NumRowsLoaded += NumRows;
+}
+
+void UGameJoltTestListener::HandleEndReached(int32 NumRows)
+{
+	EndsReached.Add(NumRows);
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UEGameJoltAPI.h"
+#include "GameJoltBlobStore.h"
+#include "GameJoltDataStoreMirror.h"
+#include "GameJoltFriendsLeaderboard.h"
+#include "GameJoltLeaderboardCursor.h"
+#include "GameJoltUserLookup.h"
+#include "GameJoltTestListener.generated.h"
+
+/**
+ * Records the events of an API instance, so the automation tests can check their payloads
+ * Dynamic events can only be bound to UFUNCTIONs, hence the UObject
+ */
+UCLASS(Transient)
+class UGameJoltTestListener : public UObject
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/* Binds to the events of an API instance */
+	void Listen(UUEGameJoltAPI* API);
+
+	/* Binds to the events of a blob store */
+	void Listen(UGameJoltBlobStore* BlobStore);
+
+	/* Binds to the events of a data-store mirror */
+	void Listen(UGameJoltDataStoreMirror* Mirror);
+
+	/* Binds to the events of a user lookup */
+	void Listen(UGameJoltUserLookup* UserLookup);
+
+	/* Binds to the events of a friends leaderboard */
+	void Listen(UGameJoltFriendsLeaderboard* Leaderboard);
+
+	/* Binds to the events of a leaderboard cursor */
+	void Listen(UGameJoltLeaderboardCursor* Cursor);
+
+	UFUNCTION()
+	void HandleGetResult();
+
+	UFUNCTION()
+	void HandleFailed();
+
+	UFUNCTION()
+	void HandleUserAuthorized(bool bIsLoggedIn);
+
+	UFUNCTION()
+	void HandleAutoLogin(bool bIsLoggedIn);
+
+	UFUNCTION()
+	void HandleUserFetched(FUserInfo InUser);
+
+	UFUNCTION()
+	void HandleUsersFetched(const TArray<FUserInfo>& InUsers);
+
+	UFUNCTION()
+	void HandleFriendlistFetched(const TArray<int32>& InFriendlist);
+
+	UFUNCTION()
+	void HandleSessionOpened(bool bIsSessionOpen);
+
+	UFUNCTION()
+	void HandleSessionPinged(bool bIsSessionStillOpen);
+
+	UFUNCTION()
+	void HandleSessionClosed(bool bIsSessionClosed);
+
+	UFUNCTION()
+	void HandleSessionChecked(bool bIsSessionStillOpen);
+
+	UFUNCTION()
+	void HandleTrophiesFetched(TArray<FTrophyInfo> InTrophies);
+
+	UFUNCTION()
+	void HandleTrophyRemoved(bool bWasRemoved);
+
+	UFUNCTION()
+	void HandleScoreAdded(bool bWasScoreAdded);
+
+	UFUNCTION()
+	void HandleScoreboardFetched(const TArray<FScoreInfo>& InScores);
+
+	UFUNCTION()
+	void HandleScoreboardTableFetched(TArray<FScoreTableInfo> InScoreTables);
+
+	UFUNCTION()
+	void HandleRankFetched(int32 Rank);
+
+	UFUNCTION()
+	void HandleTimeFetched(FDateTime InServerTime);
+
+	UFUNCTION()
+	void HandleDataKeysFetched(const TArray<FString>& Keys);
+
+	UFUNCTION()
+	void HandleBlobSaved(const FString& Name, bool bWasSaved);
+
+	UFUNCTION()
+	void HandleBlobLoaded(const FString& Name, bool bWasLoaded, const TArray<uint8>& Data);
+
+	UFUNCTION()
+	void HandleMirrorSynced(int32 NumKeys);
+
+	UFUNCTION()
+	void HandleMirrorSyncFailed(int32 NumFailedKeys);
+
+	UFUNCTION()
+	void HandleUsersLookedUp(const TArray<FUserInfo>& InUsers);
+
+	UFUNCTION()
+	void HandleFriendsLeaderboardLoaded(const TArray<FScoreInfo>& InScores);
+
+	UFUNCTION()
+	void HandleFriendsLeaderboardFailed();
+
+	UFUNCTION()
+	void HandleRowsLoaded(int32 FirstIndex, int32 NumRows);
+
+	UFUNCTION()
+	void HandleEndReached(int32 NumRows);
+
+	/* The amount of responses, OnGetResult triggers for every one */
+	int32 NumResults;
+
+	/* The amount of failed requests. They trigger OnFailed instead of their specific event */
+	int32 NumFailures;
+
+	/* The payloads of the events with a single flag or number, in the order they arrived */
+	TArray<bool> UserAuthorized;
+	TArray<bool> AutoLogins;
+	TArray<bool> SessionsOpened;
+	TArray<bool> SessionsPinged;
+	TArray<bool> SessionsClosed;
+	TArray<bool> SessionsChecked;
+	TArray<bool> TrophiesRemoved;
+	TArray<bool> ScoresAdded;
+	TArray<int32> Ranks;
+	TArray<bool> BlobsSaved;
+	TArray<bool> BlobsLoaded;
+	TArray<int32> MirrorSyncs;
+	TArray<int32> MirrorSyncFailures;
+	TArray<int32> EndsReached;
+
+	/* The last payload of each list event, and how often it arrived */
+	FUserInfo User;
+	int32 NumUsersFetched;
+	TArray<FUserInfo> Users;
+	int32 NumUserListsFetched;
+	TArray<int32> Friendlist;
+	int32 NumFriendlistsFetched;
+	TArray<FTrophyInfo> Trophies;
+	int32 NumTrophiesFetched;
+	TArray<FScoreInfo> Scores;
+	int32 NumScoreboardsFetched;
+	TArray<FScoreTableInfo> ScoreTables;
+	int32 NumScoreTablesFetched;
+	TArray<FString> DataKeys;
+	int32 NumDataKeysFetched;
+	TArray<uint8> BlobData;
+	TArray<FUserInfo> LookedUpUsers;
+	int32 NumLookups;
+	TArray<FScoreInfo> FriendScores;
+	int32 NumFriendsLeaderboardsLoaded;
+	int32 NumFriendsLeaderboardFailures;
+
+	/* The rows loaded by a leaderboard cursor, summed over all pages */
+	int32 NumRowsLoaded;
+
+	FDateTime ServerTime;
+	int32 NumTimesFetched;
+};
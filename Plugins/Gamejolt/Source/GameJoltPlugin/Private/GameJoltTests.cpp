@@ -0,0 +1,988 @@
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GameJoltBlobStore.h"
+#include "GameJoltDataStoreMirror.h"
+#include "GameJoltFakeServer.h"
+#include "GameJoltFriendsLeaderboard.h"
+#include "GameJoltLeaderboardCursor.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltTestListener.h"
+#include "GameJoltTransport.h"
+#include "GameJoltUserLookup.h"
+#include "UEGameJoltAPI.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+
+/* Game id and private key the fake server of the tests is set up with */
+#define GJAPI_TEST_GAME_ID 1
+#define GJAPI_TEST_PRIVATE_KEY TEXT("automation")
+
+/* Seconds a test waits for an event before it fails */
+static const double TestEventTimeout = 5.0;
+
+static const int32 TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+/**
+ * The fake server, API instance and listener a single test runs against
+ * Shared by the latent commands of the test, released with the last one
+ */
+class FGameJoltTestFixture
+{
+public:
+
+	FGameJoltTestFixture()
+		: Server(FGameJoltFakeServer::Create(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY))
+	{
+		API = NewObject<UUEGameJoltAPI>();
+		API->AddToRoot();
+		API->SetTransport(Server);
+
+		Listener = NewObject<UGameJoltTestListener>();
+		Listener->AddToRoot();
+		Listener->Listen(API);
+	}
+
+	~FGameJoltTestFixture()
+	{
+		if(!UObjectInitialized())
+			return;
+
+		API->SetTransport(nullptr);
+		API->RemoveFromRoot();
+		Listener->RemoveFromRoot();
+		for(UObject* Object : KeptObjects)
+			Object->RemoveFromRoot();
+	}
+
+	/* Keeps an object created by the test alive until the test ends. Their outer doesn't */
+	template<typename ObjectType>
+	ObjectType* Keep(ObjectType* Object)
+	{
+		Object->AddToRoot();
+		KeptObjects.Add(Object);
+		return Object;
+	}
+
+	TSharedRef<FGameJoltFakeServer, ESPMode::ThreadSafe> Server;
+	UUEGameJoltAPI* API;
+	UGameJoltTestListener* Listener;
+
+private:
+
+	TArray<UObject*> KeptObjects;
+};
+
+/* Waits until a condition holds, e.g. until an event arrived. Fails the test if it doesn't in time */
+class FGameJoltWaitCommand : public IAutomationLatentCommand
+{
+public:
+
+	FGameJoltWaitCommand(FAutomationTestBase* InTest, const FString& InDescription, TFunction<bool()> InCondition)
+		: Test(InTest)
+		, Description(InDescription)
+		, Condition(MoveTemp(InCondition))
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if(Condition())
+			return true;
+		if(GetCurrentRunTime() < TestEventTimeout)
+			return false;
+
+		Test->AddError(FString::Printf(TEXT("Timed out waiting for %s"), *Description));
+		return true;
+	}
+
+private:
+
+	FAutomationTestBase* Test;
+	FString Description;
+	TFunction<bool()> Condition;
+};
+
+/* Queues a wait for a condition behind the steps queued before */
+static void WaitFor(FAutomationTestBase* Test, const FString& Description, TFunction<bool()> Condition)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FGameJoltWaitCommand(Test, Description, MoveTemp(Condition)));
+}
+
+/* Queues a step behind the steps queued before */
+static void Then(TFunction<void()> Step)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Step]()
+	{
+		Step();
+		return true;
+	}));
+}
+
+/* Queues a step which runs a delay after the steps queued before */
+static void ThenAfter(float Seconds, TFunction<void()> Step)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FDelayedFunctionLatentCommand(MoveTemp(Step), Seconds));
+}
+
+/* Initializes the API with the game of the fake server and logs a user in */
+static void LogIn(FAutomationTestBase* Test, TSharedPtr<FGameJoltTestFixture> Fixture, const FString& UserName, const FString& UserToken)
+{
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+	Fixture->API->Login(UserName, UserToken);
+	WaitFor(Test, TEXT("OnUserAuthorized"), [Fixture]() { return Fixture->Listener->UserAuthorized.Num() > 0; });
+	Then([Test, Fixture]()
+	{
+		Test->TestTrue(TEXT("The user is logged in"), Fixture->Listener->UserAuthorized.Num() > 0 && Fixture->Listener->UserAuthorized.Last());
+	});
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltInitTest, "GameJolt.API.Init", TestFlags)
+bool FGameJoltInitTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+
+	// Without auto login there are no credentials to look for
+	TestFalse(TEXT("Init without auto login"), Fixture->API->Init(GJAPI_TEST_GAME_ID, TEXT("wrong key"), false));
+
+	// Requests are signed with the key passed to Init, the server rejects a wrong one
+	// Rejected requests trigger OnFailed instead of their specific event
+	Fixture->API->Login(TEXT("Player"), TEXT("token"));
+	WaitFor(this, TEXT("the login signed with the wrong key"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("OnUserAuthorized after the wrong key"), Fixture->Listener->UserAuthorized.Num(), 0);
+		TestFalse(TEXT("Logged in after the wrong key"), Fixture->API->bIsLoggedIn);
+		Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+		Fixture->API->Login(TEXT("Player"), TEXT("token"));
+	});
+	WaitFor(this, TEXT("the login signed with the right key"), [Fixture]() { return Fixture->Listener->UserAuthorized.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Login signed with the right key"), Fixture->Listener->UserAuthorized[0]);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltAuthTest, "GameJolt.API.Auth", TestFlags)
+bool FGameJoltAuthTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	Fixture->API->Login(TEXT("Player"), TEXT("wrong token"));
+	WaitFor(this, TEXT("the login with the wrong token"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("OnUserAuthorized after the wrong token"), Fixture->Listener->UserAuthorized.Num(), 0);
+		TestFalse(TEXT("Logged in after the wrong token"), Fixture->API->bIsLoggedIn);
+		Fixture->API->Login(TEXT("Player"), TEXT("token"));
+	});
+	WaitFor(this, TEXT("the login with the right token"), [Fixture]() { return Fixture->Listener->UserAuthorized.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Login with the right token"), Fixture->Listener->UserAuthorized[0]);
+		TestTrue(TEXT("Logged in after the right token"), Fixture->API->bIsLoggedIn);
+		Fixture->API->LogOffUser();
+		TestFalse(TEXT("Logged in after logging off"), Fixture->API->bIsLoggedIn);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltAutoLoginTest, "GameJolt.API.AutoLogin", TestFlags)
+bool FGameJoltAutoLoginTest::RunTest(const FString& Parameters)
+{
+	// The file the GameJolt client puts next to the game it launches
+	const FString CredentialsPath = FPaths::Combine(FPaths::ProjectDir(), TEXT(".gj-credentials"));
+	if(FPaths::FileExists(CredentialsPath))
+	{
+		AddWarning(TEXT("Skipped, the project has a .gj-credentials file the test would overwrite"));
+		return true;
+	}
+
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+
+	// A version line, then the user's name and token
+	FFileHelper::SaveStringArrayToFile(TArray<FString>({ TEXT("0.2.1"), TEXT("Player"), TEXT("token") }), *CredentialsPath);
+	TestTrue(TEXT("Init with auto login"), Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, true));
+	WaitFor(this, TEXT("OnAutoLogin"), [Fixture]() { return Fixture->Listener->AutoLogins.Num() == 1; });
+	Then([this, Fixture, CredentialsPath]()
+	{
+		IFileManager::Get().Delete(*CredentialsPath);
+		TestTrue(TEXT("Logged in automatically"), Fixture->Listener->AutoLogins.Num() == 1 && Fixture->Listener->AutoLogins[0]);
+		TestTrue(TEXT("Logged in after auto login"), Fixture->API->bIsLoggedIn);
+		TestEqual(TEXT("User of the credentials"), Fixture->API->UserName, FString(TEXT("Player")));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltUsersTest, "GameJolt.API.Users", TestFlags)
+bool FGameJoltUsersTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	const int32 PlayerID = Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	const int32 FriendID = Fixture->Server->AddUser(TEXT("Friend"), TEXT("token"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	Then([Fixture]() { Fixture->API->FetchUser(); });
+	WaitFor(this, TEXT("OnUserFetched"), [Fixture]() { return Fixture->Listener->NumUsersFetched == 1; });
+	Then([this, Fixture, PlayerID, FriendID]()
+	{
+		TestEqual(TEXT("Fetched user id"), Fixture->Listener->User.S_User_ID, PlayerID);
+		TestEqual(TEXT("Fetched user name"), Fixture->Listener->User.User_Name, FString(TEXT("Player")));
+		Fixture->API->FetchUsers({ PlayerID, FriendID });
+	});
+	WaitFor(this, TEXT("OnUsersFetched"), [Fixture]() { return Fixture->Listener->NumUserListsFetched == 1; });
+	Then([this, Fixture, FriendID]()
+	{
+		const TArray<FUserInfo>& Users = Fixture->Listener->Users;
+		if(!TestEqual(TEXT("Fetched users"), Users.Num(), 2))
+			return;
+		TestEqual(TEXT("Second user id"), Users[1].S_User_ID, FriendID);
+		TestEqual(TEXT("Second user name"), Users[1].User_Name, FString(TEXT("Friend")));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltSessionTest, "GameJolt.API.Sessions", TestFlags)
+bool FGameJoltSessionTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	Then([Fixture]() { Fixture->API->OpenSession(); });
+	WaitFor(this, TEXT("OnSessionOpened"), [Fixture]() { return Fixture->Listener->SessionsOpened.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Session opened"), Fixture->Listener->SessionsOpened[0]);
+		Fixture->API->PingSession(ESessionStatus::Idle);
+	});
+	WaitFor(this, TEXT("OnSessionPinged"), [Fixture]() { return Fixture->Listener->SessionsPinged.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Open session pinged"), Fixture->Listener->SessionsPinged[0]);
+		Fixture->API->CheckSession();
+	});
+	WaitFor(this, TEXT("OnSessionChecked"), [Fixture]() { return Fixture->Listener->SessionsChecked.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Open session checked"), Fixture->Listener->SessionsChecked[0]);
+		Fixture->API->CloseSession();
+	});
+	WaitFor(this, TEXT("OnSessionClosed"), [Fixture]() { return Fixture->Listener->SessionsClosed.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Session closed"), Fixture->Listener->SessionsClosed[0]);
+		Fixture->API->CheckSession();
+	});
+
+	// Unlike other requests, a failed check still triggers its specific event
+	WaitFor(this, TEXT("OnSessionChecked after closing"), [Fixture]() { return Fixture->Listener->SessionsChecked.Num() == 2; });
+	Then([this, Fixture]()
+	{
+		TestFalse(TEXT("Closed session checked"), Fixture->Listener->SessionsChecked[1]);
+		Fixture->API->PingSession(ESessionStatus::Active);
+	});
+	WaitFor(this, TEXT("the ping after closing"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("OnSessionPinged after closing"), Fixture->Listener->SessionsPinged.Num(), 1);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltTrophyTest, "GameJolt.API.Trophies", TestFlags)
+bool FGameJoltTrophyTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	Fixture->Server->AddTrophy(1, TEXT("First Steps"));
+	Fixture->Server->AddTrophy(2, TEXT("Completionist"), TEXT("Platinum"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	// Every request triggers OnGetResult once, the login was the first
+	Then([Fixture]() { Fixture->API->RewardTrophy(1); });
+	WaitFor(this, TEXT("the trophy reward"), [Fixture]() { return Fixture->Listener->NumResults >= 2; });
+	Then([Fixture]() { Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK); });
+	WaitFor(this, TEXT("OnTrophiesFetched"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 1; });
+	Then([this, Fixture]()
+	{
+		const TArray<FTrophyInfo>& Trophies = Fixture->Listener->Trophies;
+		if(!TestEqual(TEXT("Fetched trophies"), Trophies.Num(), 2))
+			return;
+		TestEqual(TEXT("First trophy id"), Trophies[0].Trophy_ID, 1);
+		TestEqual(TEXT("First trophy name"), Trophies[0].Name, FString(TEXT("First Steps")));
+		TestNotEqual(TEXT("Rewarded trophy achieved"), Trophies[0].achieved, FString(TEXT("false")));
+		TestEqual(TEXT("Second trophy difficulty"), Trophies[1].Difficulty, FString(TEXT("Platinum")));
+		TestEqual(TEXT("Second trophy achieved"), Trophies[1].achieved, FString(TEXT("false")));
+		Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_USER);
+	});
+	WaitFor(this, TEXT("OnTrophiesFetched of the achieved trophies"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 2; });
+	Then([this, Fixture]()
+	{
+		const TArray<FTrophyInfo>& Trophies = Fixture->Listener->Trophies;
+		if(TestEqual(TEXT("Fetched achieved trophies"), Trophies.Num(), 1))
+			TestEqual(TEXT("Achieved trophy id"), Trophies[0].Trophy_ID, 1);
+		Fixture->API->RemoveRewardedTrophy(1);
+	});
+	WaitFor(this, TEXT("OnTrophyRemoved"), [Fixture]() { return Fixture->Listener->TrophiesRemoved.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Trophy removed"), Fixture->Listener->TrophiesRemoved[0]);
+		Fixture->API->RemoveRewardedTrophy(1);
+	});
+	WaitFor(this, TEXT("the removal of a trophy which isn't achieved"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([Fixture]() { Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_USER); });
+	WaitFor(this, TEXT("OnTrophiesFetched after the removal"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 3; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Achieved trophies after the removal"), Fixture->Listener->Trophies.Num(), 0);
+		TestEqual(TEXT("OnTrophyRemoved of the failed removal"), Fixture->Listener->TrophiesRemoved.Num(), 1);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltScoreTest, "GameJolt.API.Scores", TestFlags)
+bool FGameJoltScoreTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	Fixture->Server->AddScoreTable(1, TEXT("Main"), true);
+	Fixture->Server->AddGuestScore(1, TEXT("10 Points"), 10, TEXT("Guest"));
+	Fixture->Server->AddGuestScore(1, TEXT("30 Points"), 30, TEXT("Champion"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	Then([Fixture]() { Fixture->API->AddScore(TEXT("20 Points"), 20, FString(), FString(), 1); });
+	WaitFor(this, TEXT("OnScoreAdded"), [Fixture]() { return Fixture->Listener->ScoresAdded.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Score added"), Fixture->Listener->ScoresAdded[0]);
+		Fixture->API->FetchScoreboard(10, 1, 0, 0);
+	});
+	WaitFor(this, TEXT("OnScoreboardFetched"), [Fixture]() { return Fixture->Listener->NumScoreboardsFetched == 1; });
+	Then([this, Fixture]()
+	{
+		const TArray<FScoreInfo>& Scores = Fixture->Listener->Scores;
+		if(!TestEqual(TEXT("Fetched scores"), Scores.Num(), 3))
+			return;
+
+		// Best first, the user's score between the guests'
+		TestEqual(TEXT("Best score"), Scores[0].ScoreSort, 30);
+		TestEqual(TEXT("Best score guest"), Scores[0].Guest, FString(TEXT("Champion")));
+		TestEqual(TEXT("Added score"), Scores[1].ScoreString, FString(TEXT("20 Points")));
+		TestEqual(TEXT("Added score user"), Scores[1].UserName, FString(TEXT("Player")));
+		TestEqual(TEXT("Worst score"), Scores[2].ScoreSort, 10);
+		Fixture->API->FetchScoreboardTable();
+		Fixture->API->FetchRank(25, 1);
+	});
+	WaitFor(this, TEXT("OnScoreboardTableFetched"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 1; });
+	WaitFor(this, TEXT("OnRankFetched"), [Fixture]() { return Fixture->Listener->Ranks.Num() == 1; });
+	Then([this, Fixture]()
+	{
+		const TArray<FScoreTableInfo>& ScoreTables = Fixture->Listener->ScoreTables;
+		if(TestEqual(TEXT("Fetched scoreboards"), ScoreTables.Num(), 1))
+		{
+			TestEqual(TEXT("Scoreboard id"), ScoreTables[0].Id, 1);
+			TestEqual(TEXT("Scoreboard name"), ScoreTables[0].Name, FString(TEXT("Main")));
+		}
+
+		// Behind 30 and ahead of 20 and 10
+		TestEqual(TEXT("Rank"), Fixture->Listener->Ranks[0], 2);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltDataStoreTest, "GameJolt.API.DataStore", TestFlags)
+bool FGameJoltDataStoreTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	// Every request triggers OnGetResult once, the login was the first
+	Then([Fixture]()
+	{
+		Fixture->API->SetData(EDataStore::User, TEXT("save_level"), TEXT("7"));
+		Fixture->API->SetData(EDataStore::Global, TEXT("motd"), TEXT("Hello"));
+	});
+	WaitFor(this, TEXT("the data-store writes"), [Fixture]() { return Fixture->Listener->NumResults >= 3; });
+	Then([Fixture]() { Fixture->API->FetchData(EDataStore::User, TEXT("save_level")); });
+	WaitFor(this, TEXT("the data-store fetch"), [Fixture]() { return Fixture->Listener->NumResults >= 4; });
+	Then([this, Fixture]()
+	{
+		bool bSuccess = false;
+		FString DataAsString;
+		int32 DataAsInt = 0;
+		Fixture->API->GetData(bSuccess, DataAsString, DataAsInt);
+		TestTrue(TEXT("Data fetched"), bSuccess);
+		TestEqual(TEXT("Fetched data"), DataAsString, FString(TEXT("7")));
+		TestEqual(TEXT("Fetched data as int"), DataAsInt, 7);
+		Fixture->API->FetchDataKeys(EDataStore::Global, TEXT("*"));
+	});
+	WaitFor(this, TEXT("OnDataKeysFetched"), [Fixture]() { return Fixture->Listener->NumDataKeysFetched == 1; });
+	Then([this, Fixture]()
+	{
+		// The user's keys are kept apart from the global ones
+		TestEqual(TEXT("Global keys"), Fixture->Listener->DataKeys, TArray<FString>({ TEXT("motd") }));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltDataStoreUpdateTest, "GameJolt.API.DataStoreUpdate", TestFlags)
+bool FGameJoltDataStoreUpdateTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	Fixture->API->SetData(EDataStore::Global, TEXT("coins"), TEXT("5"));
+	WaitFor(this, TEXT("the data-store write"), [Fixture]() { return Fixture->Listener->NumResults >= 1; });
+	Then([Fixture]() { Fixture->API->UpdateData(EDataStore::Global, TEXT("coins"), EDataOperation::add, TEXT("3")); });
+	WaitFor(this, TEXT("the data-store update"), [Fixture]() { return Fixture->Listener->NumResults >= 2; });
+	Then([this, Fixture]()
+	{
+		// Updates answer with the new data
+		bool bSuccess = false;
+		FString DataAsString;
+		int32 DataAsInt = 0;
+		Fixture->API->GetData(bSuccess, DataAsString, DataAsInt);
+		TestTrue(TEXT("Data updated"), bSuccess);
+		TestEqual(TEXT("Updated data"), DataAsInt, 8);
+		Fixture->API->RemoveData(EDataStore::Global, TEXT("coins"));
+	});
+	WaitFor(this, TEXT("the data-store removal"), [Fixture]() { return Fixture->Listener->NumResults >= 3; });
+	Then([Fixture]() { Fixture->API->FetchData(EDataStore::Global, TEXT("coins")); });
+	WaitFor(this, TEXT("the fetch of the removed key"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Results after the removal"), Fixture->Listener->NumResults, 3);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltBlobTest, "GameJolt.DataStore.Blob", TestFlags)
+bool FGameJoltBlobTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->API->bBatchRequests = true;
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	// Small chunks transferred in parallel, so several of them are written within one batch window
+	UGameJoltBlobStore* BlobStore = Fixture->Keep(UGameJoltBlobStore::CreateBlobStore(Fixture->API, EDataStore::Global));
+	BlobStore->MaxChunkSize = 1024;
+	BlobStore->MaxParallelTransfers = 4;
+	Fixture->Listener->Listen(BlobStore);
+
+	// Random bytes barely compress, so the blob spans many chunks
+	TArray<uint8> Data;
+	FRandomStream Random(13);
+	for(int32 Index = 0; Index < 16 * 1024; Index++)
+		Data.Add(static_cast<uint8>(Random.RandHelper(256)));
+
+	TestTrue(TEXT("Save started"), BlobStore->SaveBlob(TEXT("save_game"), Data));
+	WaitFor(this, TEXT("OnBlobSaved"), [Fixture]() { return Fixture->Listener->BlobsSaved.Num() == 1; });
+	Then([this, Fixture, BlobStore]()
+	{
+		TestTrue(TEXT("Blob saved with batching"), Fixture->Listener->BlobsSaved[0]);
+		BlobStore->LoadBlob(TEXT("save_game"));
+	});
+	WaitFor(this, TEXT("OnBlobLoaded"), [Fixture]() { return Fixture->Listener->BlobsLoaded.Num() == 1; });
+	Then([this, Fixture, Data]()
+	{
+		TestTrue(TEXT("Blob loaded with batching"), Fixture->Listener->BlobsLoaded[0]);
+		TestTrue(TEXT("Loaded blob is the saved one"), Fixture->Listener->BlobData == Data);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltFriendsTest, "GameJolt.API.Friends", TestFlags)
+bool FGameJoltFriendsTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	const int32 PlayerID = Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	const int32 FriendID = Fixture->Server->AddUser(TEXT("Friend"), TEXT("token"));
+	Fixture->Server->AddUser(TEXT("Stranger"), TEXT("token"));
+	Fixture->Server->AddFriends(PlayerID, FriendID);
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	Then([Fixture]() { Fixture->API->FetchFriendlist(); });
+	WaitFor(this, TEXT("OnFriendlistFetched"), [Fixture]() { return Fixture->Listener->NumFriendlistsFetched == 1; });
+	Then([this, Fixture, FriendID]()
+	{
+		TestEqual(TEXT("Friends"), Fixture->Listener->Friendlist, TArray<int32>({ FriendID }));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltTimeTest, "GameJolt.API.Time", TestFlags)
+bool FGameJoltTimeTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	const FDateTime RequestTime = FDateTime::UtcNow();
+	Fixture->API->FetchServerTime();
+	WaitFor(this, TEXT("OnTimeFetched"), [Fixture]() { return Fixture->Listener->NumTimesFetched == 1; });
+	Then([this, Fixture, RequestTime]()
+	{
+		// The fake server answers with the current time, in whole seconds
+		const FTimespan Difference = Fixture->Listener->ServerTime - RequestTime;
+		TestTrue(TEXT("Server time is the time of the request"), FMath::Abs(Difference.GetTotalSeconds()) < TestEventTimeout + 1.0);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltBatchTest, "GameJolt.Request.Batch", TestFlags)
+bool FGameJoltBatchTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	Fixture->Server->AddTrophy(1, TEXT("First Steps"));
+	Fixture->API->bBatchRequests = true;
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	// The server counts the batch and every sub-request
+	TSharedRef<int32> NumRequestsBefore = MakeShared<int32>(0);
+	Then([Fixture, NumRequestsBefore]()
+	{
+		*NumRequestsBefore = Fixture->Server->GetNumRequests();
+		Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK);
+		Fixture->API->FetchServerTime();
+		Fixture->API->FetchFriendlist();
+	});
+	WaitFor(this, TEXT("the responses of the batch"), [Fixture]()
+	{
+		return Fixture->Listener->NumTrophiesFetched == 1 && Fixture->Listener->NumTimesFetched == 1 && Fixture->Listener->NumFriendlistsFetched == 1;
+	});
+	Then([this, Fixture, NumRequestsBefore]()
+	{
+		TestEqual(TEXT("Requests of the batch"), Fixture->Server->GetNumRequests() - *NumRequestsBefore, 4);
+		TestEqual(TEXT("Trophies routed to their caller"), Fixture->Listener->Trophies.Num(), 1);
+
+		// Two of these fit into the URL of a batch, so they are split into two batches of two
+		*NumRequestsBefore = Fixture->Server->GetNumRequests();
+		for(int32 Index = 0; Index < 4; Index++)
+			Fixture->API->SetData(EDataStore::Global, FString::Printf(TEXT("long_%d"), Index), FString::ChrN(3000, TEXT('x')));
+	});
+	WaitFor(this, TEXT("the split batches"), [Fixture]() { return Fixture->API->GetPendingRequestCount() == 0; });
+	Then([this, Fixture, NumRequestsBefore]()
+	{
+		TestEqual(TEXT("Requests of the split batches"), Fixture->Server->GetNumRequests() - *NumRequestsBefore, 6);
+		Fixture->API->FetchDataKeys(EDataStore::Global, TEXT("long_*"));
+	});
+	WaitFor(this, TEXT("OnDataKeysFetched"), [Fixture]() { return Fixture->Listener->NumDataKeysFetched == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Keys written by the split batches"), Fixture->Listener->DataKeys.Num(), 4);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltJournalTest, "GameJolt.Request.OfflineJournal", TestFlags)
+bool FGameJoltJournalTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+
+	// The journal is kept in the project's saved directory, writes of the game itself must not be replayed against the fake server
+	if(Fixture->API->GetQueuedWriteCount() > 0)
+	{
+		AddWarning(TEXT("Skipped, the project has queued writes the test would replay"));
+		return true;
+	}
+
+	// Every request is lost on the way, without an answer
+	TSharedRef<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> Offline = FGameJoltFaultInjectingTransport::Create(Fixture->Server, 1);
+	Offline->SetFaults(0.f, 0.f, 1.f, 0.f);
+	Fixture->API->SetTransport(Offline);
+	Fixture->API->bQueueOfflineWrites = true;
+	Fixture->API->bRetryFailedRequests = false;
+	Fixture->API->CircuitBreakerThreshold = 0;
+	Fixture->API->OfflineReplayInterval = 600.f;
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	// An update which may have been applied is dropped rather than applied twice
+	Fixture->API->UpdateData(EDataStore::Global, TEXT("journal_counter"), EDataOperation::add, TEXT("1"));
+	WaitFor(this, TEXT("the lost update"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Queued writes after the lost update"), Fixture->API->GetQueuedWriteCount(), 0);
+		Fixture->API->SetData(EDataStore::Global, TEXT("journal_save"), TEXT("queued"));
+	});
+	WaitFor(this, TEXT("the lost write"), [Fixture]() { return Fixture->API->GetPendingRequestCount() == 0; });
+	Then([this, Fixture]()
+	{
+		// Sets are safe to send again, they stay queued without triggering any event
+		TestEqual(TEXT("Queued writes after the lost write"), Fixture->API->GetQueuedWriteCount(), 1);
+		TestEqual(TEXT("Failures after the lost write"), Fixture->Listener->NumFailures, 1);
+		Fixture->API->SetTransport(Fixture->Server);
+		Fixture->API->ReplayQueuedWrites();
+	});
+	WaitFor(this, TEXT("the replay"), [Fixture]() { return Fixture->API->GetQueuedWriteCount() == 0; });
+	TSharedRef<int32> NumResultsBefore = MakeShared<int32>(0);
+	Then([Fixture, NumResultsBefore]()
+	{
+		*NumResultsBefore = Fixture->Listener->NumResults;
+		Fixture->API->FetchData(EDataStore::Global, TEXT("journal_save"));
+	});
+	WaitFor(this, TEXT("the fetch of the replayed write"), [Fixture, NumResultsBefore]() { return Fixture->Listener->NumResults > *NumResultsBefore; });
+	Then([this, Fixture]()
+	{
+		bool bSuccess = false;
+		FString DataAsString;
+		int32 DataAsInt = 0;
+		Fixture->API->GetData(bSuccess, DataAsString, DataAsInt);
+		TestTrue(TEXT("Replayed write fetched"), bSuccess);
+		TestEqual(TEXT("Replayed data"), DataAsString, FString(TEXT("queued")));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltMergeTest, "GameJolt.Request.MergeInFlight", TestFlags)
+bool FGameJoltMergeTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddScoreTable(1, TEXT("Main"));
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	// Identical reads share the request in flight, every caller still gets its event
+	Fixture->API->FetchScoreboardTable();
+	Fixture->API->FetchScoreboardTable();
+	WaitFor(this, TEXT("the merged reads"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 2; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Requests of the merged reads"), Fixture->Server->GetNumRequests(), 1);
+		TestEqual(TEXT("Tables of the merged read"), Fixture->Listener->ScoreTables.Num(), 1);
+		Fixture->API->bMergeIdenticalRequests = false;
+		Fixture->API->FetchScoreboardTable();
+		Fixture->API->FetchScoreboardTable();
+	});
+	WaitFor(this, TEXT("the reads without merging"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 4; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Requests of the reads without merging"), Fixture->Server->GetNumRequests(), 3);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltCacheTest, "GameJolt.Request.Cache", TestFlags)
+bool FGameJoltCacheTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	Fixture->Server->AddTrophy(1, TEXT("First Steps"));
+	Fixture->Server->AddScoreTable(1, TEXT("Main"));
+	Fixture->API->bCacheResponses = true;
+	Fixture->API->CacheStaleWindow = 0.f;
+	Fixture->API->CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_SCORES_TABLE, 0.5f);
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	TSharedRef<int32> NumRequestsBefore = MakeShared<int32>(0);
+	Then([Fixture]() { Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK); });
+	WaitFor(this, TEXT("the first trophy fetch"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 1; });
+	Then([this, Fixture, NumRequestsBefore]()
+	{
+		TestEqual(TEXT("Misses of the first fetch"), Fixture->API->GetCacheStats().Misses, 1);
+		*NumRequestsBefore = Fixture->Server->GetNumRequests();
+		Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK);
+	});
+	WaitFor(this, TEXT("the cached trophy fetch"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 2; });
+	Then([this, Fixture, NumRequestsBefore]()
+	{
+		TestEqual(TEXT("Hits of the second fetch"), Fixture->API->GetCacheStats().Hits, 1);
+		TestEqual(TEXT("Requests of the cached fetch"), Fixture->Server->GetNumRequests(), *NumRequestsBefore);
+		Fixture->API->RewardTrophy(1);
+	});
+
+	// Rewarding a trophy invalidates the fetched trophies
+	WaitFor(this, TEXT("the trophy reward"), [Fixture, NumRequestsBefore]() { return Fixture->Server->GetNumRequests() > *NumRequestsBefore && Fixture->API->GetPendingRequestCount() == 0; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Evictions after the reward"), Fixture->API->GetCacheStats().Evictions >= 1);
+		Fixture->API->FetchAllTrophies(EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK);
+	});
+	WaitFor(this, TEXT("the trophy fetch after the reward"), [Fixture]() { return Fixture->Listener->NumTrophiesFetched == 3; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Misses after the reward"), Fixture->API->GetCacheStats().Misses, 2);
+		if(TestEqual(TEXT("Trophies after the reward"), Fixture->Listener->Trophies.Num(), 1))
+			TestNotEqual(TEXT("Rewarded trophy achieved"), Fixture->Listener->Trophies[0].achieved, FString(TEXT("false")));
+		Fixture->API->FetchScoreboardTable();
+	});
+
+	// Responses expire with their time to live
+	WaitFor(this, TEXT("the first table fetch"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 1; });
+	ThenAfter(0.6f, [Fixture]() { Fixture->API->FetchScoreboardTable(); });
+	WaitFor(this, TEXT("the table fetch after the time to live"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 2; });
+	Then([this, Fixture]()
+	{
+		const FGameJoltCacheStats Stats = Fixture->API->GetCacheStats();
+		TestEqual(TEXT("Misses after the time to live"), Stats.Misses, 4);
+		TestEqual(TEXT("Hits after the time to live"), Stats.Hits, 1);
+		Fixture->API->ClearResponseCache();
+		TestEqual(TEXT("Entries after clearing"), Fixture->API->GetCacheStats().Entries, 0);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltRetryTest, "GameJolt.Request.RetryAndCircuitBreaker", TestFlags)
+bool FGameJoltRetryTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddScoreTable(1, TEXT("Main"));
+
+	// Every request is answered with a server error
+	TSharedRef<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> Failing = FGameJoltFaultInjectingTransport::Create(Fixture->Server, 1);
+	Failing->SetFaults(0.f, 0.f, 0.f, 1.f);
+	Fixture->API->SetTransport(Failing);
+	Fixture->API->MaxRetries = 1;
+	Fixture->API->RetryBaseDelay = 0.f;
+	Fixture->API->RetryMaxDelay = 0.f;
+	Fixture->API->CircuitBreakerThreshold = 2;
+	Fixture->API->CircuitBreakerCooldown = 0.5f;
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	// The retry fails as well, which opens the circuit
+	Fixture->API->FetchScoreboardTable();
+	WaitFor(this, TEXT("the failed retry"), [Fixture]() { return Fixture->Listener->NumFailures == 1; });
+	Then([this, Fixture]()
+	{
+		const FGameJoltRetryStats Stats = Fixture->API->GetRetryStats();
+		TestEqual(TEXT("Retries"), Stats.Retries, 1);
+		TestEqual(TEXT("Open circuits"), Stats.OpenCircuits, 1);
+		TestTrue(TEXT("Circuit open after the failures"), Fixture->API->GetCircuitState(EGameJoltComponentEnum::GJ_SCORES_TABLE) == EGameJoltCircuitState::Open);
+		TestTrue(TEXT("Circuit of other actions closed"), Fixture->API->GetCircuitState(EGameJoltComponentEnum::GJ_TIME) == EGameJoltCircuitState::Closed);
+		Fixture->API->FetchScoreboardTable();
+	});
+	WaitFor(this, TEXT("the request failing fast"), [Fixture]() { return Fixture->Listener->NumFailures == 2; });
+	Then([this, Fixture, Failing]()
+	{
+		TestEqual(TEXT("Failed fast"), Fixture->API->GetRetryStats().FailedFast, 1);
+		Failing->SetFaults(0.f, 0.f, 0.f, 0.f);
+	});
+
+	// After the cooldown a probe is let through, its success closes the circuit
+	ThenAfter(0.6f, [Fixture]() { Fixture->API->FetchScoreboardTable(); });
+	WaitFor(this, TEXT("the probe"), [Fixture]() { return Fixture->Listener->NumScoreTablesFetched == 1; });
+	Then([this, Fixture]()
+	{
+		TestTrue(TEXT("Circuit closed after the probe"), Fixture->API->GetCircuitState(EGameJoltComponentEnum::GJ_SCORES_TABLE) == EGameJoltCircuitState::Closed);
+		TestEqual(TEXT("Open circuits after the probe"), Fixture->API->GetRetryStats().OpenCircuits, 0);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltWriteBehindTest, "GameJolt.DataStore.WriteBehind", TestFlags)
+bool FGameJoltWriteBehindTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->API->bWriteBehindDataStore = true;
+	Fixture->API->DataStoreFlushInterval = 600.f;
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	// Writes of the same key are merged while held back
+	Fixture->API->SetData(EDataStore::Global, TEXT("level"), TEXT("1"));
+	Fixture->API->SetData(EDataStore::Global, TEXT("level"), TEXT("2"));
+	Fixture->API->SetData(EDataStore::Global, TEXT("level"), TEXT("3"));
+	TestEqual(TEXT("Requests while held back"), Fixture->Server->GetNumRequests(), 0);
+	TestEqual(TEXT("Merged writes"), Fixture->API->GetDataStoreWriteStats().Merged, 2);
+
+	Fixture->API->FlushDataStoreWrites();
+	WaitFor(this, TEXT("the flushed write"), [Fixture]() { return Fixture->Listener->NumResults >= 1; });
+	Then([this, Fixture]()
+	{
+		const FGameJoltDataStoreWriteStats Stats = Fixture->API->GetDataStoreWriteStats();
+		TestEqual(TEXT("Sent writes"), Stats.Sent, 1);
+		TestEqual(TEXT("Pending writes"), Stats.Pending, 0);
+		TestEqual(TEXT("Requests of the flush"), Fixture->Server->GetNumRequests(), 1);
+		Fixture->API->FetchData(EDataStore::Global, TEXT("level"));
+	});
+	WaitFor(this, TEXT("the fetch of the flushed write"), [Fixture]() { return Fixture->Listener->NumResults >= 2; });
+	Then([this, Fixture]()
+	{
+		bool bSuccess = false;
+		FString DataAsString;
+		int32 DataAsInt = 0;
+		Fixture->API->GetData(bSuccess, DataAsString, DataAsInt);
+		TestTrue(TEXT("Flushed write fetched"), bSuccess);
+		TestEqual(TEXT("Last write wins"), DataAsString, FString(TEXT("3")));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltMirrorTest, "GameJolt.DataStore.Mirror", TestFlags)
+bool FGameJoltMirrorTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+	Fixture->API->SetData(EDataStore::Global, TEXT("profile_name"), TEXT("Hero"));
+	Fixture->API->SetData(EDataStore::Global, TEXT("profile_level"), TEXT("3"));
+	Fixture->API->SetData(EDataStore::Global, TEXT("settings"), TEXT("default"));
+
+	UGameJoltDataStoreMirror* Mirror = Fixture->Keep(UGameJoltDataStoreMirror::CreateDataStoreMirror(Fixture->API, EDataStore::Global, TEXT("profile_"), 1));
+	Fixture->Listener->Listen(Mirror);
+	WaitFor(this, TEXT("the data-store writes"), [Fixture]() { return Fixture->Listener->NumResults >= 3; });
+	Then([Mirror]() { Mirror->Sync(); });
+	WaitFor(this, TEXT("OnSynced"), [Fixture]() { return Fixture->Listener->MirrorSyncs.Num() == 1; });
+	Then([this, Fixture, Mirror]()
+	{
+		TestEqual(TEXT("Synced keys"), Fixture->Listener->MirrorSyncs[0], 2);
+		TestEqual(TEXT("Mirrored keys"), Mirror->GetKeys().Num(), 2);
+
+		FString Data;
+		TestTrue(TEXT("Mirrored key found"), Mirror->GetData(TEXT("profile_level"), Data));
+		TestEqual(TEXT("Mirrored data"), Data, FString(TEXT("3")));
+		TestFalse(TEXT("Key beyond the prefix found"), Mirror->GetData(TEXT("settings"), Data));
+
+		// Writes through the mirror are visible right away and reach the server
+		Mirror->SetData(TEXT("profile_title"), TEXT("Champion"));
+		TestTrue(TEXT("Written key found"), Mirror->GetData(TEXT("profile_title"), Data));
+		TestEqual(TEXT("Written data"), Data, FString(TEXT("Champion")));
+	});
+	WaitFor(this, TEXT("the write through the mirror"), [Fixture]() { return Fixture->API->GetPendingRequestCount() == 0; });
+	Then([Fixture]() { Fixture->API->FetchDataKeys(EDataStore::Global, TEXT("profile_*")); });
+	WaitFor(this, TEXT("OnDataKeysFetched"), [Fixture]() { return Fixture->Listener->NumDataKeysFetched == 1; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Keys on the server"), Fixture->Listener->DataKeys.Num(), 3);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltUserLookupTest, "GameJolt.Users.Lookup", TestFlags)
+bool FGameJoltUserLookupTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	const int32 PlayerID = Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	const int32 FriendID = Fixture->Server->AddUser(TEXT("Friend"), TEXT("token"));
+	const int32 StrangerID = Fixture->Server->AddUser(TEXT("Stranger"), TEXT("token"));
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	UGameJoltUserLookup* UserLookup = Fixture->Keep(UGameJoltUserLookup::CreateUserLookup(Fixture->API));
+	Fixture->Listener->Listen(UserLookup);
+
+	// Lookups within the same collect window are fetched with one request, the shared user only once
+	UserLookup->LookUpUsers({ PlayerID, FriendID });
+	UserLookup->LookUpUsers({ FriendID, StrangerID });
+	WaitFor(this, TEXT("OnUsersLookedUp"), [Fixture]() { return Fixture->Listener->NumLookups == 2; });
+	Then([this, Fixture, UserLookup, PlayerID, StrangerID]()
+	{
+		TestEqual(TEXT("Requests of the lookups"), Fixture->Server->GetNumRequests(), 1);
+		TestEqual(TEXT("Users of the second lookup"), Fixture->Listener->LookedUpUsers.Num(), 2);
+
+		FUserInfo User;
+		if(TestTrue(TEXT("Looked up user cached"), UserLookup->FindUser(StrangerID, User)))
+			TestEqual(TEXT("Cached user name"), User.User_Name, FString(TEXT("Stranger")));
+		UserLookup->LookUpUsers({ PlayerID });
+	});
+
+	// Cached users answer without a request
+	WaitFor(this, TEXT("OnUsersLookedUp of a cached user"), [Fixture]() { return Fixture->Listener->NumLookups == 3; });
+	Then([this, Fixture]()
+	{
+		TestEqual(TEXT("Requests after the cached lookup"), Fixture->Server->GetNumRequests(), 1);
+		if(TestEqual(TEXT("Users of the cached lookup"), Fixture->Listener->LookedUpUsers.Num(), 1))
+			TestEqual(TEXT("Cached lookup user name"), Fixture->Listener->LookedUpUsers[0].User_Name, FString(TEXT("Player")));
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltFriendsLeaderboardTest, "GameJolt.Scores.FriendsLeaderboard", TestFlags)
+bool FGameJoltFriendsLeaderboardTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	const int32 PlayerID = Fixture->Server->AddUser(TEXT("Player"), TEXT("token"));
+	const int32 FriendID = Fixture->Server->AddUser(TEXT("Friend"), TEXT("token"));
+	const int32 StrangerID = Fixture->Server->AddUser(TEXT("Stranger"), TEXT("token"));
+	Fixture->Server->AddFriends(PlayerID, FriendID);
+	Fixture->Server->AddScoreTable(1, TEXT("Main"));
+	Fixture->Server->AddUserScore(1, TEXT("50 Points"), 50, StrangerID);
+	Fixture->Server->AddUserScore(1, TEXT("40 Points"), 40, FriendID);
+	Fixture->Server->AddUserScore(1, TEXT("30 Points"), 30, PlayerID);
+	Fixture->Server->AddUserScore(1, TEXT("20 Points"), 20, FriendID);
+	Fixture->Server->AddGuestScore(1, TEXT("10 Points"), 10, TEXT("Guest"));
+	LogIn(this, Fixture, TEXT("Player"), TEXT("token"));
+
+	UGameJoltFriendsLeaderboard* Leaderboard = Fixture->Keep(UGameJoltFriendsLeaderboard::CreateFriendsLeaderboard(Fixture->API, 1));
+	Fixture->Listener->Listen(Leaderboard);
+	Then([this, Leaderboard]() { TestTrue(TEXT("Load started"), Leaderboard->Load()); });
+	WaitFor(this, TEXT("OnLoaded"), [Fixture]() { return Fixture->Listener->NumFriendsLeaderboardsLoaded == 1; });
+	Then([this, Fixture, Leaderboard, PlayerID, FriendID]()
+	{
+		// The best score of the friend and the user's, without strangers and guests
+		const TArray<FScoreInfo>& Scores = Fixture->Listener->FriendScores;
+		if(TestEqual(TEXT("Friends' scores"), Scores.Num(), 2))
+		{
+			TestEqual(TEXT("Best friend score user"), Scores[0].UserID, FriendID);
+			TestEqual(TEXT("Best friend score"), Scores[0].ScoreSort, 40);
+			TestEqual(TEXT("Own score user"), Scores[1].UserID, PlayerID);
+			TestEqual(TEXT("Own score"), Scores[1].ScoreSort, 30);
+		}
+		TestTrue(TEXT("Cached friends"), Leaderboard->GetFriendIDs() == TArray<int32>({ FriendID }));
+		TestEqual(TEXT("Failed loads"), Fixture->Listener->NumFriendsLeaderboardFailures, 0);
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltLeaderboardCursorTest, "GameJolt.Scores.LeaderboardCursor", TestFlags)
+bool FGameJoltLeaderboardCursorTest::RunTest(const FString& Parameters)
+{
+	TSharedPtr<FGameJoltTestFixture> Fixture = MakeShared<FGameJoltTestFixture>();
+	Fixture->Server->AddScoreTable(1, TEXT("Main"));
+
+	// Two scores tied across the boundary of the first and second page
+	const TArray<int32> Sorts = { 100, 90, 80, 70, 70, 60, 50, 40, 30, 20 };
+	for(int32 Index = 0; Index < Sorts.Num(); Index++)
+		Fixture->Server->AddGuestScore(1, FString::FromInt(Sorts[Index]), Sorts[Index], FString::Printf(TEXT("Guest %d"), Index));
+	Fixture->API->Init(GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, false);
+
+	UGameJoltLeaderboardCursor* Cursor = Fixture->Keep(UGameJoltLeaderboardCursor::CreateLeaderboardCursor(Fixture->API, 1, 4));
+	Fixture->Listener->Listen(Cursor);
+	Cursor->SetVisibleRange(0, 9);
+	WaitFor(this, TEXT("OnEndReached"), [Fixture]() { return Fixture->Listener->EndsReached.Num() == 1; });
+	Then([this, Fixture, Cursor, Sorts]()
+	{
+		TestEqual(TEXT("Rows at the end"), Fixture->Listener->EndsReached[0], Sorts.Num());
+		TestEqual(TEXT("Loaded rows"), Fixture->Listener->NumRowsLoaded, Sorts.Num());
+		TestTrue(TEXT("End reached"), Cursor->IsEndReached());
+		TestEqual(TEXT("Rows"), Cursor->GetNumRows(), Sorts.Num());
+
+		// Every row once, in the order of the scoreboard
+		for(int32 Index = 0; Index < Sorts.Num(); Index++)
+		{
+			FScoreInfo Score;
+			if(TestTrue(FString::Printf(TEXT("Row %d loaded"), Index), Cursor->GetRow(Index, Score)))
+				TestEqual(FString::Printf(TEXT("Guest of row %d"), Index), Score.Guest, FString::Printf(TEXT("Guest %d"), Index));
+		}
+	});
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameJoltEncodingTest, "GameJolt.RequestBuilder.Encoding", TestFlags)
+bool FGameJoltEncodingTest::RunTest(const FString& Parameters)
+{
+	// U+1F600 takes a surrogate pair where TCHAR is UTF-16. Both halves have to become one 4 byte UTF-8 sequence
+	const FString Value = FString(TEXT("a b")) + TEXT("\U0001F600") + TEXT("\u00E9");
+	FString Encoded;
+	FGameJoltQueryBuilder::AppendEncoded(Encoded, Value);
+	TestEqual(TEXT("Encoded"), Encoded, FString(TEXT("a%20b%F0%9F%98%80%C3%A9")));
+	TestEqual(TEXT("Decoded"), FGameJoltQueryBuilder::Decode(Encoded), Value);
+	TestEqual(TEXT("Decoded unencoded characters"), FGameJoltQueryBuilder::Decode(Value), Value);
+
+	// The signature is the MD5 of the UTF-8 form of the URL followed by the private key
+	FGameJoltRequestSigner Signer;
+	Signer.Configure(TEXT("api.gamejolt.com"), TEXT("/api/game/"), TEXT("v1_2"), GJAPI_TEST_GAME_ID, GJAPI_TEST_PRIVATE_KEY, EGameJoltSignatureAlgorithm::MD5);
+	const FString Url = Signer.BuildUrl(TEXT("/scores/?guest=") + Value, true, nullptr, nullptr);
+	const int32 SignatureStart = Url.Find(TEXT("&signature="));
+	const FTCHARToUTF8 Signed(*(Url.Left(SignatureStart) + GJAPI_TEST_PRIVATE_KEY));
+	TestEqual(TEXT("Signature"), Url.Mid(SignatureStart + 11), FMD5::HashBytes(reinterpret_cast<const uint8*>(Signed.Get()), Signed.Length()));
+	return true;
+}
+
+#endif
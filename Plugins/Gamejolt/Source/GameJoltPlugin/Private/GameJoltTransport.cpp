@@ -0,0 +1,140 @@
+#include "GameJoltTransport.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Containers/Ticker.h"
+#include "Misc/ScopeLock.h"
+
+/* Sends a request through the HTTP module */
+void FGameJoltHttpTransport::Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete)
+{
+	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetVerb("POST");
+	HttpRequest->SetURL(Url);
+	HttpRequest->SetHeader("Content-Type", "application/json");
+	HttpRequest->SetContentAsString(Body);
+	if(OnComplete)
+	{
+		HttpRequest->OnProcessRequestComplete().BindLambda([OnComplete](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+		{
+			if(!bWasSuccessful || !Response.IsValid())
+			{
+				OnComplete(false, 0, TArray<uint8>());
+				return;
+			}
+			OnComplete(true, Response->GetResponseCode(), Response->GetContent());
+		});
+	}
+	HttpRequest->ProcessRequest();
+}
+
+FGameJoltFaultInjectingTransport::FGameJoltFaultInjectingTransport(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InInner, int32 Seed)
+	: Inner(InInner)
+	, Random(Seed)
+	, MinLatency(0.f)
+	, MaxLatency(0.f)
+	, DropRate(0.f)
+	, ServerErrorRate(0.f)
+{
+}
+
+/* Creates a transport injecting faults and registers it with the core ticker */
+TSharedRef<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> FGameJoltFaultInjectingTransport::Create(TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> InInner, int32 Seed)
+{
+	check(IsInGameThread());
+	TSharedRef<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> Transport = MakeShareable(new FGameJoltFaultInjectingTransport(InInner, Seed));
+
+	// The ticker only holds a weak pointer and removes itself on the game thread once the transport is gone, wherever it was released
+	TWeakPtr<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> WeakTransport = Transport;
+	FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakTransport](float DeltaTime)
+	{
+		TSharedPtr<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> Pinned = WeakTransport.Pin();
+		return Pinned.IsValid() && Pinned->Tick(DeltaTime);
+	}));
+	return Transport;
+}
+
+/* Sets the faults to inject */
+void FGameJoltFaultInjectingTransport::SetFaults(float InMinLatency, float InMaxLatency, float InDropRate, float InServerErrorRate)
+{
+	FScopeLock ScopeLock(&Lock);
+	MinLatency = FMath::Max(InMinLatency, 0.f);
+	MaxLatency = FMath::Max(InMaxLatency, MinLatency);
+	DropRate = FMath::Clamp(InDropRate, 0.f, 1.f);
+	ServerErrorRate = FMath::Clamp(InServerErrorRate, 0.f, 1.f);
+}
+
+/* Sends a request through the inner transport, unless it is dropped */
+void FGameJoltFaultInjectingTransport::Send(const FString& Url, const FString& Body, FGameJoltTransportCallback OnComplete)
+{
+	double DueTime;
+	bool bDrop;
+	bool bServerError;
+	{
+		FScopeLock ScopeLock(&Lock);
+		DueTime = FPlatformTime::Seconds() + Random.FRandRange(MinLatency, MaxLatency);
+		bDrop = Random.FRand() < DropRate;
+		bServerError = Random.FRand() < ServerErrorRate;
+	}
+
+	if(bDrop)
+	{
+		Delay(DueTime, false, 0, TArray<uint8>(), MoveTemp(OnComplete));
+		return;
+	}
+
+	// The inner transport still processes requests answered with an error, like a server failing after the fact
+	TWeakPtr<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> WeakThis = AsShared();
+	Inner->Send(Url, Body, [WeakThis, DueTime, bServerError, OnComplete](bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& Content)
+	{
+		TSharedPtr<FGameJoltFaultInjectingTransport, ESPMode::ThreadSafe> This = WeakThis.Pin();
+		if(!This.IsValid())
+			return;
+		if(bServerError)
+			This->Delay(DueTime, true, 503, TArray<uint8>(), OnComplete);
+		else
+			This->Delay(DueTime, bWasSuccessful, ResponseCode, Content, OnComplete);
+	});
+}
+
+/* Holds a response back until its latency elapsed */
+void FGameJoltFaultInjectingTransport::Delay(double DueTime, bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& Content, FGameJoltTransportCallback OnComplete)
+{
+	FScopeLock ScopeLock(&Lock);
+	FDelayedResponse& Response = DelayedResponses.AddDefaulted_GetRef();
+	Response.DueTime = DueTime;
+	Response.bWasSuccessful = bWasSuccessful;
+	Response.ResponseCode = ResponseCode;
+	Response.Content = Content;
+	Response.OnComplete = MoveTemp(OnComplete);
+}
+
+/* Delivers the responses whose latency elapsed */
+bool FGameJoltFaultInjectingTransport::Tick(float DeltaTime)
+{
+	TArray<FDelayedResponse> DueResponses;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const double Now = FPlatformTime::Seconds();
+		for(int32 i = 0; i < DelayedResponses.Num(); )
+		{
+			if(DelayedResponses[i].DueTime <= Now)
+			{
+				DueResponses.Add(MoveTemp(DelayedResponses[i]));
+				DelayedResponses.RemoveAt(i);
+			}
+			else
+			{
+				i++;
+			}
+		}
+	}
+
+	// Outside of the lock, callbacks may send the next request right away
+	for(FDelayedResponse& Response : DueResponses)
+	{
+		if(Response.OnComplete)
+			Response.OnComplete(Response.bWasSuccessful, Response.ResponseCode, Response.Content);
+	}
+	return true;
+}
@@ -0,0 +1,255 @@
+#include "GameJoltUserLookup.h"
+#include "GameJoltPluginModule.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltResponseDecoder.h"
+#include "GameJoltStats.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+
+/* Constructor */
+UGameJoltUserLookup::UGameJoltUserLookup(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	CollectWindow = 0.f;
+	CacheLifetime = 300.f;
+	MaxUsersPerRequest = 100;
+	API = nullptr;
+}
+
+/* Creates a user lookup */
+UGameJoltUserLookup* UGameJoltUserLookup::CreateUserLookup(UUEGameJoltAPI* API, float CollectWindow)
+{
+	if(!API)
+	{
+		UE_LOG(GJAPI, Error, TEXT("A user lookup needs an API instance to fetch its users with"));
+		return nullptr;
+	}
+
+	UGameJoltUserLookup* UserLookup = NewObject<UGameJoltUserLookup>(API);
+	UserLookup->API = API;
+	UserLookup->CollectWindow = FMath::Max(CollectWindow, 0.f);
+	return UserLookup;
+}
+
+/* Removes the ticker ending the collect window */
+void UGameJoltUserLookup::BeginDestroy()
+{
+	if(CollectTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(CollectTickerHandle);
+		CollectTickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
+/* Looks up users */
+bool UGameJoltUserLookup::LookUpUsers(const TArray<int32>& UserIDs)
+{
+	if(UserIDs.Num() == 0)
+		return false;
+
+	TWeakObjectPtr<UGameJoltUserLookup> WeakThis(this);
+	RequestUsers(UserIDs, [WeakThis](const TArray<FUserInfo>& LookedUpUsers)
+	{
+		if(WeakThis.IsValid())
+			WeakThis->OnUsersLookedUp.Broadcast(LookedUpUsers);
+	});
+	return true;
+}
+
+/* Looks up users and calls back with them */
+void UGameJoltUserLookup::RequestUsers(const TArray<int32>& UserIDs, FGameJoltUsersCallback OnLookedUp)
+{
+	const TSharedRef<FLookup> Lookup = MakeShared<FLookup>();
+	Lookup->UserIDs = UserIDs;
+	Lookup->NumPending = 0;
+	Lookup->OnLookedUp = MoveTemp(OnLookedUp);
+
+	TSet<int32> Requested;
+	for(const int32 UserID : UserIDs)
+	{
+		if(UserID <= 0 || Requested.Contains(UserID))
+			continue;
+		Requested.Add(UserID);
+
+		const FCachedUser* CachedUser = Users.Find(UserID);
+		if(CachedUser && IsFresh(*CachedUser))
+		{
+			INC_DWORD_STAT(STAT_GameJolt_UserLookupsMerged);
+			continue;
+		}
+
+		// A user which is collected or being fetched already is fetched once for every lookup waiting for it
+		TArray<TSharedRef<FLookup>>& UserWaiters = Waiters.FindOrAdd(UserID);
+		if(UserWaiters.Num() > 0)
+			INC_DWORD_STAT(STAT_GameJolt_UserLookupsMerged);
+		UserWaiters.Add(Lookup);
+		Lookup->NumPending++;
+
+		if(!Fetching.Contains(UserID))
+			Collected.Add(UserID);
+	}
+
+	// Answered with the next flush like fetched users, so callers see the same order of events either way
+	if(Lookup->NumPending == 0)
+		ReadyLookups.Add(Lookup);
+
+	if(!CollectTickerHandle.IsValid() && (Collected.Num() > 0 || ReadyLookups.Num() > 0))
+	{
+		const float Delay = Collected.Num() > 0 ? CollectWindow : 0.f;
+		CollectTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGameJoltUserLookup::OnCollectWindowElapsed), Delay);
+	}
+}
+
+/* Gets a cached user which hasn't expired yet */
+bool UGameJoltUserLookup::FindUser(int32 UserID, FUserInfo& User) const
+{
+	const FCachedUser* CachedUser = Users.Find(UserID);
+	if(!CachedUser || !IsFresh(*CachedUser))
+		return false;
+
+	User = CachedUser->User;
+	return true;
+}
+
+/* Fetches the collected users right away */
+void UGameJoltUserLookup::Flush()
+{
+	if(CollectTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(CollectTickerHandle);
+		CollectTickerHandle.Reset();
+	}
+
+	TArray<TSharedRef<FLookup>> Lookups = MoveTemp(ReadyLookups);
+	ReadyLookups.Reset();
+	for(const TSharedRef<FLookup>& Lookup : Lookups)
+		FinishLookup(*Lookup);
+
+	if(!API || Collected.Num() == 0)
+		return;
+
+	TArray<int32> UserIDs = Collected.Array();
+	Collected.Reset();
+	Fetching.Append(UserIDs);
+	PruneUsers();
+
+	TWeakObjectPtr<UGameJoltUserLookup> WeakThis(this);
+	const int32 ChunkSize = FMath::Max(MaxUsersPerRequest, 1);
+	for(int32 Start = 0; Start < UserIDs.Num(); Start += ChunkSize)
+	{
+		TArray<int32> ChunkIDs(UserIDs.GetData() + Start, FMath::Min(ChunkSize, UserIDs.Num() - Start));
+		const TSharedPtr<FGameJoltRequest> GameJoltRequest = API->StartRequest(EGameJoltComponentEnum::GJ_USERS_FETCH,
+			FGameJoltQueryBuilder(TEXT("/users/"), 24 + ChunkIDs.Num() * 8).Add(TEXT("user_id"), ChunkIDs).Build(), false,
+			[WeakThis, ChunkIDs](const FGameJoltRequest& CompletedRequest)
+			{
+				if(WeakThis.IsValid())
+					WeakThis->OnUsersFetched(CompletedRequest, ChunkIDs);
+			}, FString(), true);
+
+		if(!GameJoltRequest.IsValid())
+		{
+			UE_LOG(GJAPI, Error, TEXT("Could not fetch %d users."), ChunkIDs.Num());
+			for(const int32 UserID : ChunkIDs)
+			{
+				Fetching.Remove(UserID);
+				ResolveUser(UserID);
+			}
+		}
+	}
+}
+
+/* Removes all users from the cache */
+void UGameJoltUserLookup::ClearCache()
+{
+	Users.Reset();
+}
+
+/* Ticker callback which fetches the collected users once the collect window ended */
+bool UGameJoltUserLookup::OnCollectWindowElapsed(float DeltaTime)
+{
+	CollectTickerHandle.Reset();
+	Flush();
+	return false;
+}
+
+/* Callback of a user fetch */
+void UGameJoltUserLookup::OnUsersFetched(const FGameJoltRequest& GameJoltRequest, const TArray<int32>& UserIDs)
+{
+	if(GameJoltRequest.bSucceeded)
+	{
+		TArray<FUserInfo> FetchedUsers;
+		if(GameJoltRequest.bStreamed)
+			FetchedUsers = GameJoltRequest.Users;
+		else
+			FGameJoltResponseDecoder::DecodeUsers(GameJoltRequest.Response, FetchedUsers);
+
+		const double Now = FPlatformTime::Seconds();
+		for(FUserInfo& User : FetchedUsers)
+		{
+			FCachedUser& CachedUser = Users.Add(User.S_User_ID);
+			CachedUser.User = MoveTemp(User);
+			CachedUser.FetchTime = Now;
+		}
+	}
+
+	// IDs the server didn't return are resolved as well, their lookups leave them out
+	for(const int32 UserID : UserIDs)
+	{
+		Fetching.Remove(UserID);
+		ResolveUser(UserID);
+	}
+}
+
+/* Hands a fetched user, or the failure to fetch it, to the lookups waiting for it */
+void UGameJoltUserLookup::ResolveUser(int32 UserID)
+{
+	TArray<TSharedRef<FLookup>> UserWaiters;
+	Waiters.RemoveAndCopyValue(UserID, UserWaiters);
+	for(const TSharedRef<FLookup>& Lookup : UserWaiters)
+	{
+		if(--Lookup->NumPending == 0)
+			FinishLookup(*Lookup);
+	}
+}
+
+/* Calls back with the users of a lookup */
+void UGameJoltUserLookup::FinishLookup(const FLookup& Lookup) const
+{
+	if(!Lookup.OnLookedUp)
+		return;
+
+	// Expired users are used as well, they are only left in the cache if they couldn't be fetched again
+	TArray<FUserInfo> LookedUpUsers;
+	LookedUpUsers.Reserve(Lookup.UserIDs.Num());
+	for(const int32 UserID : Lookup.UserIDs)
+	{
+		if(const FCachedUser* CachedUser = Users.Find(UserID))
+			LookedUpUsers.Add(CachedUser->User);
+	}
+	Lookup.OnLookedUp(LookedUpUsers);
+}
+
+/* Removes expired users which no lookup is waiting for */
+void UGameJoltUserLookup::PruneUsers()
+{
+	// Expired users being fetched again, or part of a lookup in flight, are still the fallback if the fetch fails
+	TSet<int32> NeededIDs(Fetching);
+	for(const TPair<int32, TArray<TSharedRef<FLookup>>>& Pair : Waiters)
+	{
+		for(const TSharedRef<FLookup>& Lookup : Pair.Value)
+			NeededIDs.Append(Lookup->UserIDs);
+	}
+
+	for(auto It = Users.CreateIterator(); It; ++It)
+	{
+		if(!IsFresh(It.Value()) && !NeededIDs.Contains(It.Key()))
+			It.RemoveCurrent();
+	}
+}
+
+/* Whether a cached user hasn't expired yet */
+bool UGameJoltUserLookup::IsFresh(const FCachedUser& CachedUser) const
+{
+	return FPlatformTime::Seconds() - CachedUser.FetchTime < CacheLifetime;
+}
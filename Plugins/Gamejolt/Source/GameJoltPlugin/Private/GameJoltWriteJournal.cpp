@@ -0,0 +1,239 @@
+#include "GameJoltWriteJournal.h"
+#include "GameJoltPluginModule.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "HAL/FileManager.h"
+
+FGameJoltWriteJournal::FGameJoltWriteJournal(const FString& InFilename, int32 InMaxEntries)
+	: Filename(InFilename)
+	, MaxEntries(InMaxEntries)
+	, NumStaleLines(0)
+{
+}
+
+/* Reads the unacknowledged writes from the journal file */
+void FGameJoltWriteJournal::Load()
+{
+	Entries.Reset();
+	NumStaleLines = 0;
+
+	TArray<FString> Lines;
+	if(!FFileHelper::LoadFileToStringArray(Lines, *Filename))
+		return;
+
+	const UEnum* ActionEnum = StaticEnum<EGameJoltComponentEnum>();
+	for(const FString& Line : Lines)
+	{
+		TSharedPtr<FJsonObject> Object;
+		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Line);
+		if(!FJsonSerializer::Deserialize(JsonReader, Object) || !Object.IsValid())
+		{
+			// A torn line from a crash while appending. Everything before it is still valid
+			UE_LOG(GJAPI, Warning, TEXT("Skipping invalid line in the write journal: '%s'"), *Line);
+			NumStaleLines++;
+			continue;
+		}
+
+		const FString Key = Object->GetStringField(TEXT("key"));
+		const FString Op = Object->GetStringField(TEXT("op"));
+		if(Op == TEXT("ack"))
+		{
+			Entries.RemoveAll([&Key](const FGameJoltJournalEntry& Entry) { return Entry.Key == Key; });
+			NumStaleLines += 2;
+			continue;
+		}
+		if(Op == TEXT("sent"))
+		{
+			if(FGameJoltJournalEntry* Entry = Find(Key))
+				Entry->bSent = true;
+			NumStaleLines++;
+			continue;
+		}
+
+		const int64 Action = ActionEnum->GetValueByNameString(Object->GetStringField(TEXT("action")));
+		if(Action == INDEX_NONE)
+		{
+			UE_LOG(GJAPI, Warning, TEXT("Skipping write with unknown action in the write journal: '%s'"), *Line);
+			NumStaleLines++;
+			continue;
+		}
+
+		FGameJoltJournalEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Key = Key;
+		Entry.Action = static_cast<EGameJoltComponentEnum>(Action);
+		Entry.Endpoint = Object->GetStringField(TEXT("endpoint"));
+		Object->TryGetBoolField(TEXT("sent"), Entry.bSent);
+	}
+
+	if(Entries.Num() > 0)
+		UE_LOG(GJAPI, Log, TEXT("Found %d unacknowledged writes in the write journal"), Entries.Num());
+
+	EnforceMaxEntries();
+	Compact();
+}
+
+/* Appends a write to the journal */
+FString FGameJoltWriteJournal::Append(EGameJoltComponentEnum Action, const FString& Endpoint)
+{
+	FGameJoltJournalEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Key = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	Entry.Action = Action;
+	Entry.Endpoint = Endpoint;
+	const FString Key = Entry.Key;
+
+	TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+	Line->SetStringField(TEXT("op"), TEXT("write"));
+	Line->SetStringField(TEXT("key"), Key);
+	Line->SetStringField(TEXT("action"), StaticEnum<EGameJoltComponentEnum>()->GetNameStringByValue(static_cast<int64>(Action)));
+	Line->SetStringField(TEXT("endpoint"), Endpoint);
+	AppendLine(Line);
+
+	EnforceMaxEntries();
+	return Key;
+}
+
+/* Records that a write was handed to a transport */
+void FGameJoltWriteJournal::MarkSent(const FString& Key)
+{
+	FGameJoltJournalEntry* Entry = Find(Key);
+	if(!Entry || Entry->bSent)
+		return;
+
+	Entry->bSent = true;
+	if(IsSafeToResend(Entry->Action))
+		return;
+
+	TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+	Line->SetStringField(TEXT("op"), TEXT("sent"));
+	Line->SetStringField(TEXT("key"), Key);
+	AppendLine(Line);
+}
+
+/* Whether a write of the action can be sent again although the first attempt may have reached the server */
+bool FGameJoltWriteJournal::IsSafeToResend(EGameJoltComponentEnum Action)
+{
+	// Sets and achieved trophies end up the same when sent twice, a score shows up twice on a scoreboard at worst.
+	// An add or append of an update would change the stored value twice
+	return Action != EGameJoltComponentEnum::GJ_DATASTORE_UPDATE;
+}
+
+/* Removes an acknowledged write from the journal */
+void FGameJoltWriteJournal::Acknowledge(const FString& Key)
+{
+	if(Entries.RemoveAll([&Key](const FGameJoltJournalEntry& Entry) { return Entry.Key == Key; }) == 0)
+		return;
+
+	TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+	Line->SetStringField(TEXT("op"), TEXT("ack"));
+	Line->SetStringField(TEXT("key"), Key);
+	AppendLine(Line);
+	NumStaleLines += 2;
+
+	if(NumStaleLines > Entries.Num())
+		Compact();
+}
+
+/* Finds the entry with the specified key */
+FGameJoltJournalEntry* FGameJoltWriteJournal::Find(const FString& Key)
+{
+	return Entries.FindByPredicate([&Key](const FGameJoltJournalEntry& Entry) { return Entry.Key == Key; });
+}
+
+/* Finds the oldest write which isn't sent currently */
+FGameJoltJournalEntry* FGameJoltWriteJournal::FindNextToReplay()
+{
+	return Entries.FindByPredicate([](const FGameJoltJournalEntry& Entry) { return !Entry.bInFlight; });
+}
+
+/* Whether a write older than the specified one is waiting to be sent */
+bool FGameJoltWriteJournal::IsWaitingBehindOthers(const FString& Key) const
+{
+	for(const FGameJoltJournalEntry& Entry : Entries)
+	{
+		if(Entry.Key == Key)
+			return false;
+		if(!Entry.bInFlight)
+			return true;
+	}
+	return false;
+}
+
+/* Changes the maximum amount of unacknowledged writes */
+void FGameJoltWriteJournal::SetMaxEntries(int32 InMaxEntries)
+{
+	MaxEntries = InMaxEntries;
+	EnforceMaxEntries();
+}
+
+/* Appends a line to the journal file */
+void FGameJoltWriteJournal::AppendLine(const TSharedRef<FJsonObject>& Line)
+{
+	FString LineString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&LineString);
+	FJsonSerializer::Serialize(Line, JsonWriter);
+	LineString += TEXT("\n");
+
+	if(!FFileHelper::SaveStringToFile(LineString, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+		UE_LOG(GJAPI, Error, TEXT("Could not append to the write journal '%s'"), *Filename);
+}
+
+/* Rewrites the journal file with the remaining entries only */
+void FGameJoltWriteJournal::Compact()
+{
+	if(Entries.Num() == 0)
+	{
+		IFileManager::Get().Delete(*Filename, false, false, true);
+		NumStaleLines = 0;
+		return;
+	}
+
+	if(NumStaleLines == 0)
+		return;
+
+	const UEnum* ActionEnum = StaticEnum<EGameJoltComponentEnum>();
+	FString Content;
+	for(const FGameJoltJournalEntry& Entry : Entries)
+	{
+		TSharedRef<FJsonObject> Line = MakeShared<FJsonObject>();
+		Line->SetStringField(TEXT("op"), TEXT("write"));
+		Line->SetStringField(TEXT("key"), Entry.Key);
+		Line->SetStringField(TEXT("action"), ActionEnum->GetNameStringByValue(static_cast<int64>(Entry.Action)));
+		Line->SetStringField(TEXT("endpoint"), Entry.Endpoint);
+		if(Entry.bSent && !IsSafeToResend(Entry.Action))
+			Line->SetBoolField(TEXT("sent"), true);
+
+		FString LineString;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&LineString);
+		FJsonSerializer::Serialize(Line, JsonWriter);
+		Content += LineString + TEXT("\n");
+	}
+
+	// Write next to the journal first, so a crash never leaves a half written journal behind
+	const FString TempFilename = Filename + TEXT(".tmp");
+	if(!FFileHelper::SaveStringToFile(Content, *TempFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*Filename, *TempFilename, true, true))
+	{
+		UE_LOG(GJAPI, Error, TEXT("Could not compact the write journal '%s'"), *Filename);
+		return;
+	}
+	NumStaleLines = 0;
+}
+
+/* Drops the oldest writes which aren't in flight until the cap is met */
+void FGameJoltWriteJournal::EnforceMaxEntries()
+{
+	while(MaxEntries > 0 && Entries.Num() > MaxEntries)
+	{
+		FGameJoltJournalEntry* Oldest = FindNextToReplay();
+		if(!Oldest)
+			return;
+
+		UE_LOG(GJAPI, Warning, TEXT("Write journal is full. Dropping write '%s'"), *Oldest->Endpoint);
+		Acknowledge(FString(Oldest->Key));
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UEGameJoltAPI.h"
+
+/* A single write which hasn't been acknowledged by the server yet */
+struct FGameJoltJournalEntry
+{
+	/* Identifies the entry in the journal and its acknowledgement. Only used locally, the server never sees it */
+	FString Key;
+
+	/* The action of the write */
+	EGameJoltComponentEnum Action;
+
+	/* The endpoint with its query, including the user info at the time of the write */
+	FString Endpoint;
+
+	/* Whether the write is currently sent. Not persisted */
+	bool bInFlight;
+
+	/* Whether the write was handed to a transport before. It may have reached the server even if no answer came back */
+	bool bSent;
+
+	FGameJoltJournalEntry()
+		: Action(EGameJoltComponentEnum::GJ_OTHER)
+		, bInFlight(false)
+		, bSent(false)
+	{
+	}
+};
+
+/**
+ * Append-only journal of writes (scores, trophies, data-store) which haven't reached the server yet
+ * Every write is appended as a line before it is sent and an acknowledgement line is appended once the server answered
+ * The file is rewritten with the remaining entries when acknowledged lines outweigh them
+ * Delivery is at least once: the server doesn't know the keys, so a write whose answer got lost is sent again.
+ * Writes which would be applied twice, i.e. relative data-store updates, are dropped instead once they may have reached the server
+ */
+class FGameJoltWriteJournal
+{
+public:
+
+	/**
+	 * @param InFilename The file of the journal
+	 * @param InMaxEntries The maximum amount of unacknowledged writes. The oldest ones are dropped beyond that
+	 */
+	FGameJoltWriteJournal(const FString& InFilename, int32 InMaxEntries);
+
+	/* Reads the unacknowledged writes from the journal file */
+	void Load();
+
+	/**
+	 * Appends a write to the journal
+	 * @return The key of the new entry
+	 */
+	FString Append(EGameJoltComponentEnum Action, const FString& Endpoint);
+
+	/**
+	 * Records that a write was handed to a transport
+	 * Only persisted for writes which can't be resent safely, the others are replayed regardless
+	 */
+	void MarkSent(const FString& Key);
+
+	/* Whether a write of the action can be sent again although the first attempt may have reached the server */
+	static bool IsSafeToResend(EGameJoltComponentEnum Action);
+
+	/* Removes an acknowledged write from the journal */
+	void Acknowledge(const FString& Key);
+
+	/* Finds the entry with the specified key. Null if it was acknowledged already */
+	FGameJoltJournalEntry* Find(const FString& Key);
+
+	/* Finds the oldest write which isn't sent currently. Null if there is none */
+	FGameJoltJournalEntry* FindNextToReplay();
+
+	/* Whether a write older than the specified one is waiting to be sent */
+	bool IsWaitingBehindOthers(const FString& Key) const;
+
+	/* Changes the maximum amount of unacknowledged writes */
+	void SetMaxEntries(int32 InMaxEntries);
+
+	/* Gets the amount of unacknowledged writes */
+	int32 Num() const { return Entries.Num(); }
+
+private:
+
+	/* Appends a line to the journal file */
+	void AppendLine(const TSharedRef<FJsonObject>& Line);
+
+	/* Rewrites the journal file with the remaining entries only */
+	void Compact();
+
+	/* Drops the oldest writes which aren't in flight until the cap is met */
+	void EnforceMaxEntries();
+
+	FString Filename;
+
+	TArray<FGameJoltJournalEntry> Entries;
+
+	int32 MaxEntries;
+
+	/* The amount of lines in the file which don't represent a remaining entry */
+	int32 NumStaleLines;
+};
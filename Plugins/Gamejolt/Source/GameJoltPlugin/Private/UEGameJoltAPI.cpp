@@ -1,14 +1,101 @@
 #include "UEGameJoltAPI.h"
 #include "Engine/Engine.h"
 #include "HttpModule.h"
-#include "Interfaces/IHttpResponse.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonReader.h"
 #include "GameJoltPluginModule.h"
+#include "GameJoltWriteJournal.h"
+#include "GameJoltResponseCache.h"
+#include "GameJoltResponseDecoder.h"
+#include "GameJoltStreamDecoder.h"
+#include "GameJoltRequestBuilder.h"
+#include "GameJoltSessionHeartbeat.h"
+#include "GameJoltRequestScheduler.h"
+#include "GameJoltCircuitBreaker.h"
+#include "GameJoltStats.h"
+#include "GameJoltLocalLeaderboard.h"
+#include "GameJoltScoreSubmitter.h"
+#include "GameJoltDataStoreCache.h"
 #include "Misc/DateTime.h"
 #include "Engine/World.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Containers/Ticker.h"
+#include "Misc/CoreDelegates.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/PlatformApplicationMisc.h"
+
+/* The maximum amount of sub-requests the server accepts in a single batch request */
+#define GJAPI_MAX_BATCH_SIZE 50
+
+/* The maximum length of a batch request's URL. Servers and proxies commonly reject request lines beyond 8 KB */
+#define GJAPI_MAX_BATCH_URL_LENGTH 8000
+
+/* The room left in a batch URL for game_id and the signature, which are appended once the sub-requests are in */
+#define GJAPI_BATCH_SIGNATURE_RESERVE 96
+
+/* Gets the value of a query parameter of an endpoint. Empty if the parameter isn't set */
+static FString GetQueryParameter(const FString& Endpoint, const TCHAR* Name)
+{
+	const FString Pattern = FString(Name) + TEXT("=");
+	int32 Start = INDEX_NONE;
+	for(int32 From = 0; ; From = Start + 1)
+	{
+		Start = Endpoint.Find(Pattern, ESearchCase::CaseSensitive, ESearchDir::FromStart, From);
+		if(Start == INDEX_NONE)
+			return FString();
+		if(Start > 0 && (Endpoint[Start - 1] == TEXT('?') || Endpoint[Start - 1] == TEXT('&')))
+			break;
+	}
+
+	Start += Pattern.Len();
+	int32 End = Start;
+	while(End < Endpoint.Len() && Endpoint[End] != TEXT('&') && Endpoint[End] != TEXT('|'))
+		End++;
+	return Endpoint.Mid(Start, End - Start);
+}
+
+/* Whether the action only reads, so sending it once or several times makes no difference */
+static bool IsReadAction(EGameJoltComponentEnum Action)
+{
+	switch(Action)
+	{
+		case EGameJoltComponentEnum::GJ_USER_FETCH:
+		case EGameJoltComponentEnum::GJ_USERS_FETCH:
+		case EGameJoltComponentEnum::GJ_USER_FRIENDLIST:
+		case EGameJoltComponentEnum::GJ_SESSION_CHECK:
+		case EGameJoltComponentEnum::GJ_TROPHIES_FETCH:
+		case EGameJoltComponentEnum::GJ_SCORES_FETCH:
+		case EGameJoltComponentEnum::GJ_SCORES_TABLE:
+		case EGameJoltComponentEnum::GJ_SCORES_RANK:
+		case EGameJoltComponentEnum::GJ_DATASTORE_FETCH:
+		case EGameJoltComponentEnum::GJ_DATASTORE_KEYS:
+		case EGameJoltComponentEnum::GJ_TIME:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/* Whether sending a request of the action again can't change anything beyond what the first attempt did */
+static bool IsIdempotentAction(EGameJoltComponentEnum Action)
+{
+	return IsReadAction(Action) || Action == EGameJoltComponentEnum::GJ_SESSION_PING;
+}
+
+/* Gets the endpoint with its parameters in a fixed order, so equal queries give equal keys */
+static FString NormalizeEndpoint(const FString& Endpoint)
+{
+	FString Path;
+	FString Query;
+	if(!Endpoint.Split(TEXT("?"), &Path, &Query))
+		return Endpoint;
+
+	TArray<FString> Parameters;
+	Query.ParseIntoArray(Parameters, TEXT("&"));
+	Parameters.Sort();
+	return Path + TEXT("?") + FString::Join(Parameters, TEXT("&"));
+}
 
 /* Constructor */
 UUEGameJoltAPI::UUEGameJoltAPI(const class FObjectInitializer& PCIP) : Super(PCIP)
@@ -21,6 +108,58 @@ UUEGameJoltAPI::UUEGameJoltAPI(const class FObjectInitializer& PCIP) : Super(PCI
 	Game_ID = 0;
 	Game_PrivateKey = "";
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USER_AUTH;
+	SignatureAlgorithm = EGameJoltSignatureAlgorithm::MD5;
+	NextRequestId = 1;
+	bBatchRequests = false;
+	BatchWindow = 0.f;
+	bBatchParallel = false;
+	bBatchBreakOnError = false;
+	bQueueOfflineWrites = false;
+	MaxQueuedWrites = 256;
+	OfflineReplayInterval = 30.f;
+	bStreamLargeResponses = false;
+	bMergeIdenticalRequests = true;
+	bThrottleRequests = false;
+	RateLimits.Add(EGameJoltEndpointClass::Users, FGameJoltRateLimit(5.f, 10));
+	RateLimits.Add(EGameJoltEndpointClass::Sessions, FGameJoltRateLimit(1.f, 2));
+	RateLimits.Add(EGameJoltEndpointClass::Trophies, FGameJoltRateLimit(5.f, 10));
+	RateLimits.Add(EGameJoltEndpointClass::Scores, FGameJoltRateLimit(5.f, 10));
+	RateLimits.Add(EGameJoltEndpointClass::DataStore, FGameJoltRateLimit(10.f, 20));
+	RateLimits.Add(EGameJoltEndpointClass::Misc, FGameJoltRateLimit(10.f, 20));
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_USER_AUTH, EGameJoltRequestPriority::Critical);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_USER_AUTOLOGIN, EGameJoltRequestPriority::Critical);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_SCORES_ADD, EGameJoltRequestPriority::Critical);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_TROPHIES_ADD, EGameJoltRequestPriority::Critical);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_USER_FRIENDLIST, EGameJoltRequestPriority::Background);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_SESSION_PING, EGameJoltRequestPriority::Background);
+	RequestPriorities.Add(EGameJoltComponentEnum::GJ_DATASTORE_UPDATE, EGameJoltRequestPriority::Background);
+	MaxConcurrentRequests = 8;
+	bRetryFailedRequests = true;
+	MaxRetries = 3;
+	RetryBaseDelay = 1.f;
+	RetryMaxDelay = 30.f;
+	CircuitBreakerThreshold = 5;
+	CircuitBreakerCooldown = 30.f;
+	NumRetries = 0;
+	NumFailedFast = 0;
+	bCacheResponses = false;
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_SCORES_FETCH, 30.f);
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_SCORES_TABLE, 300.f);
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_TROPHIES_FETCH, 60.f);
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_USER_FETCH, 120.f);
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_USERS_FETCH, 120.f);
+	CacheTimeToLive.Add(EGameJoltComponentEnum::GJ_TIME, 5.f);
+	CacheStaleWindow = 60.f;
+	MaxCachedResponses = 128;
+	SessionPingInterval = 30.f;
+	bAutoSessionStatus = true;
+	SessionIdleTimeout = 60.f;
+	bKeepLocalScoreboards = false;
+	MaxLocalScores = 100;
+	bSmartSubmitScores = false;
+	ScoreSubmitWindow = 5.f;
+	bWriteBehindDataStore = false;
+	DataStoreFlushInterval = 10.f;
 }
 
 /* Prevents crashes within 'Get...' functions */
@@ -29,11 +168,62 @@ UWorld* UUEGameJoltAPI::GetWorld() const
 	return World;
 }
 
+/* Stops all tickers before the object is destroyed */
+void UUEGameJoltAPI::BeginDestroy()
+{
+	// Held writes are sent now, so queued offline writes still journal them
+	FlushScoreSubmissions();
+	FlushDataStoreWrites();
+
+	ShutdownSessionHeartbeat(false);
+
+	if(BatchTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(BatchTickerHandle);
+		BatchTickerHandle.Reset();
+	}
+
+	if(ReplayTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(ReplayTickerHandle);
+		ReplayTickerHandle.Reset();
+	}
+
+	if(DeferredTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(DeferredTickerHandle);
+		DeferredTickerHandle.Reset();
+	}
+
+	if(SchedulerTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SchedulerTickerHandle);
+		SchedulerTickerHandle.Reset();
+	}
+
+	for(const TPair<uint32, FDelegateHandle>& RetryTickerHandle : RetryTickerHandles)
+		FTicker::GetCoreTicker().RemoveTicker(RetryTickerHandle.Value);
+	RetryTickerHandles.Empty();
+
+	// Nothing which is still queued or in flight will be answered anymore
+	DEC_DWORD_STAT_BY(STAT_GameJolt_InFlight, PendingRequests.Num());
+	DEC_DWORD_STAT_BY(STAT_GameJolt_Queued, PendingBatch.Num());
+	PendingRequests.Empty();
+	PendingBatch.Empty();
+
+	Super::BeginDestroy();
+}
+
 /* Sets information needed for all requests */
 bool UUEGameJoltAPI::Init(const int32 GameID, const FString PrivateKey, const bool AutoLogin = false)
 {
 	Game_ID = GameID;
 	Game_PrivateKey = PrivateKey;
+
+	// Writes of earlier sessions which never reached the server
+	if(bQueueOfflineWrites)
+		ReplayQueuedWrites();
+
 	if(!AutoLogin)
 	{
 		UE_LOG(GJAPI, Log, TEXT("Autologin is turned off!"));
@@ -51,48 +241,42 @@ bool UUEGameJoltAPI::Init(const int32 GameID, const FString PrivateKey, const bo
 
 void UUEGameJoltAPI::AutoLogin(const FString Name, const FString Token)
 {
-	FString output;
 	UserName = Name;
 	UserToken = Token;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USER_AUTOLOGIN;
-	SendRequest(output, "/users/auth/?");
+	StartRequest(LastActionPerformed, TEXT("/users/auth/?"));
 }
 
 /* Gets the time of the GameJolt servers */
 bool UUEGameJoltAPI::FetchServerTime()
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_TIME;
-	return SendRequest(output, "/time/?", false);
+	return StartRequest(LastActionPerformed, TEXT("/time/?"), false).IsValid();
 }
 
 /* Puts the requested server time in a readable format */
 FDateTime UUEGameJoltAPI::ReadServerTime()
 {
-	UUEGameJoltAPI* responseField = NULL;
-	responseField = GetObject("response");
-	if (responseField == NULL)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if (!Response.IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("responseField Return Null"));
 		return FDateTime();
 	}
-	if(!responseField->GetBool("success"))
+	if(!FGameJoltResponseDecoder::DecodeSuccess(Response))
 	{
 		UE_LOG(GJAPI, Error, TEXT("Can't read time: Request failed!"));
-		if(responseField->GetString("message") != "")
+		const FString Message = FGameJoltResponseDecoder::DecodeString(*Response, TEXT("message"));
+		if(Message != "")
 		{
-			UE_LOG(GJAPI, Error, TEXT("Error message: %s"), *responseField->GetString("message"));
+			UE_LOG(GJAPI, Error, TEXT("Error message: %s"), *Message);
 		}
 		return FDateTime();
 	}
-	int32 Year = responseField->GetInt("year");
-	int32 Month = responseField->GetInt("month");
-	int32 Day = responseField->GetInt("day");
-	int32 Hour = responseField->GetInt("hour");
-	int32 Minute = responseField->GetInt("minute");
-	int32 Second = responseField->GetInt("second");
 
-	return FDateTime(Year, Month, Day, Hour, Minute, Second);
+	FDateTime ServerTime;
+	FGameJoltResponseDecoder::DecodeServerTime(Response, ServerTime);
+	return ServerTime;
 }
 
 /* Creates a new instance of the UUEGameJoltAPI class, for use in Blueprint graphs. */
@@ -109,30 +293,25 @@ UUEGameJoltAPI* UUEGameJoltAPI::Create(UObject* WorldContextObject) {
 /* Sends a request to authentificate the user */
 void UUEGameJoltAPI::Login(const FString name, const FString token)
 {
-	FString output;
-	FString GameIDString = FString::FromInt(Game_ID);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USER_AUTH;
 	UserName = name;
 	UserToken = token;
-	SendRequest(output, "/users/auth/?");
+	StartRequest(LastActionPerformed, TEXT("/users/auth/?"));
 }
 
 /* Checks if the authentification was succesful */
 bool UUEGameJoltAPI::isUserAuthorize()
 {
-	bool outAuthorize;
-	UUEGameJoltAPI* responseField = NULL;
-	responseField = GetObject("response");
-	if (responseField == NULL)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if (!Response.IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("responseField Return Null"));
 		return false;
 	}
-	outAuthorize = responseField->GetBool("success");
-	if (!outAuthorize)
+	if (!FGameJoltResponseDecoder::DecodeSuccess(Response))
 	{
 		bIsLoggedIn = false;
-		UE_LOG(GJAPI, Error, TEXT("Couldn't authenticate user. Message: %s"), *responseField->GetString("message"));
+		UE_LOG(GJAPI, Error, TEXT("Couldn't authenticate user. Message: %s"), *FGameJoltResponseDecoder::DecodeString(*Response, TEXT("message")));
 		return false;
 	}
 
@@ -143,11 +322,8 @@ bool UUEGameJoltAPI::isUserAuthorize()
 /* Gets information the current user */
 bool UUEGameJoltAPI::FetchUser()
 {
-	bool ret = false;
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USER_FETCH;
-	ret = SendRequest(output, "/users/?username=" + UserName, false);
-	if (!ret)
+	if (!StartRequest(LastActionPerformed, FGameJoltQueryBuilder(TEXT("/users/")).Add(TEXT("username"), UserName).Build(), false).IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Could not fetch user."));
 		return false;
@@ -158,35 +334,32 @@ bool UUEGameJoltAPI::FetchUser()
 /* Fetches an array of users */
 bool UUEGameJoltAPI::FetchUsers(const TArray<int32> Users)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USERS_FETCH;
-	FString UserIDs = "";
-	for(const int32 UserID : Users)
-		UserIDs.Append(FString::FromInt(UserID) + ",");
-	return SendRequest(output, "/users/?user_id=" + UserIDs, false);
+	return StartRequest(LastActionPerformed, FGameJoltQueryBuilder(TEXT("/users/"), 24 + Users.Num() * 8).Add(TEXT("user_id"), Users).Build(), false).IsValid();
 }
 
 /* Fetches the friendlist of the current user */
 bool UUEGameJoltAPI::FetchFriendlist()
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_USER_FRIENDLIST;
-	return SendRequest(output, "/friends/?");
+	return StartRequest(LastActionPerformed, TEXT("/friends/?")).IsValid();
 }
 
 /* Gets the friendlist */
 TArray<int32> UUEGameJoltAPI::GetFriendlist()
 {
-	TArray<UUEGameJoltAPI*> returnArray = GetObject("response")->GetObjectArray(GetObject("response"), "friends");
 	TArray<int32> returnIDs;
-	for(int i = 0; i < returnArray.Num(); i++)
-		returnIDs.Add(returnArray[i]->GetInt("friend_id"));
+	FGameJoltResponseDecoder::DecodeFriendlist(GetResponseField(), returnIDs);
 	return returnIDs;
 }
 
 /* Resets user related properties */
 void UUEGameJoltAPI::LogOffUser()
 {
+	// Held writes are sent for the user who made them
+	FlushScoreSubmissions();
+	FlushDataStoreWrites();
+
 	bIsLoggedIn = false;
 	UserName = "";
 	UserToken = "";
@@ -195,97 +368,207 @@ void UUEGameJoltAPI::LogOffUser()
 /* Opens a session */
 bool UUEGameJoltAPI::OpenSession()
 {
-	FString output;
-	FString GameIDString;
-	GameIDString = FString::FromInt(Game_ID);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SESSION_OPEN;
-	return SendRequest(output, "/sessions/open/?");
+	return StartRequest(LastActionPerformed, TEXT("/sessions/open/?")).IsValid();
 }
 
 /* Pings the session */
 bool UUEGameJoltAPI::PingSession(ESessionStatus SessionStatus)
 {
-	FString output;
-	FString SessionString = SessionStatus == ESessionStatus::Active ? FString("active") : FString("idle");
-	FString GameIDString = FString::FromInt(Game_ID);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SESSION_PING;
-	return SendRequest(output, "/sessions/ping/?status=" + SessionString);
+	return StartRequest(LastActionPerformed, FGameJoltQueryBuilder(TEXT("/sessions/ping/")).Add(TEXT("status"), SessionStatus == ESessionStatus::Active ? TEXT("active") : TEXT("idle")).Build()).IsValid();
 }
 
 /* Closes the session */
 bool UUEGameJoltAPI::CloseSession()
 {
-	FString output;
-	FString GameIDString;
-	GameIDString = FString::FromInt(Game_ID);
+	// A closed session has nothing left to ping
+	StopSessionHeartbeat(false);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SESSION_CLOSE;
-	return SendRequest(output, "/sessions/close/?");
+	return StartRequest(LastActionPerformed, TEXT("/sessions/close/?")).IsValid();
 }
 
 /* Fetches the session status */
 bool UUEGameJoltAPI::CheckSession()
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SESSION_CHECK;
-	return SendRequest(output, "/sessions/check/?");
+	return StartRequest(LastActionPerformed, TEXT("/sessions/check/?")).IsValid();
+}
+
+/* Opens a session and pings it from its own thread */
+bool UUEGameJoltAPI::StartSessionHeartbeat()
+{
+	if(IsSessionHeartbeatRunning())
+		return true;
+
+	LastActionPerformed = EGameJoltComponentEnum::GJ_SESSION_OPEN;
+	TWeakObjectPtr<UUEGameJoltAPI> WeakThis(this);
+	return StartRequest(LastActionPerformed, TEXT("/sessions/open/?"), true, [WeakThis](const FGameJoltRequest& GameJoltRequest)
+	{
+		UUEGameJoltAPI* This = WeakThis.Get();
+		if(!This || !GameJoltRequest.bSucceeded)
+			return;
+
+		if(!This->SessionHeartbeat.IsValid())
+		{
+			This->SessionHeartbeat = MakeShared<FGameJoltSessionHeartbeat>([WeakThis](bool bReachedServer, bool bSucceeded)
+			{
+				if(UUEGameJoltAPI* Owner = WeakThis.Get())
+					Owner->OnHeartbeatPinged(bReachedServer, bSucceeded);
+			});
+		}
+		if(This->SessionHeartbeat->IsRunning())
+			return;
+
+		This->UpdateHeartbeatSettings();
+		This->OnSessionStatusTick(0.f);
+		if(!This->SessionHeartbeat->Start(This->SessionPingInterval))
+			return;
+
+		if(!This->SessionStatusTickerHandle.IsValid())
+			This->SessionStatusTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(This, &UUEGameJoltAPI::OnSessionStatusTick), 1.f);
+		if(!This->PreExitHandle.IsValid())
+			This->PreExitHandle = FCoreDelegates::OnPreExit.AddUObject(This, &UUEGameJoltAPI::OnPreExit);
+	}).IsValid();
+}
+
+/* Stops the pings of the session heartbeat */
+void UUEGameJoltAPI::StopSessionHeartbeat(bool bCloseSession)
+{
+	const bool bWasRunning = IsSessionHeartbeatRunning();
+	if(SessionHeartbeat.IsValid())
+		SessionHeartbeat->Shutdown();
+
+	if(SessionStatusTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SessionStatusTickerHandle);
+		SessionStatusTickerHandle.Reset();
+	}
+	if(PreExitHandle.IsValid())
+	{
+		FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+		PreExitHandle.Reset();
+	}
+
+	if(bWasRunning && bCloseSession)
+		CloseSession();
+}
+
+/* Sets the status sent with the pings of the session heartbeat */
+void UUEGameJoltAPI::SetSessionHeartbeatStatus(ESessionStatus SessionStatus)
+{
+	if(!SessionHeartbeat.IsValid())
+		return;
+	SessionHeartbeat->SetStatus(SessionStatus);
+}
+
+/* Whether the session heartbeat is running */
+bool UUEGameJoltAPI::IsSessionHeartbeatRunning() const
+{
+	return SessionHeartbeat.IsValid() && SessionHeartbeat->IsRunning();
+}
+
+/* Derives the session status from input and window focus */
+bool UUEGameJoltAPI::OnSessionStatusTick(float DeltaTime)
+{
+	if(!IsSessionHeartbeatRunning())
+		return true;
+
+	UpdateHeartbeatSettings();
+	if(!bAutoSessionStatus)
+		return true;
+
+	bool bIdle = !FPlatformApplicationMisc::IsThisApplicationForeground();
+	if(!bIdle && SessionIdleTimeout > 0.f && FSlateApplication::IsInitialized())
+	{
+		const FSlateApplication& SlateApplication = FSlateApplication::Get();
+		bIdle = SlateApplication.GetCurrentTime() - SlateApplication.GetLastUserInteractionTime() > SessionIdleTimeout;
+	}
+	SessionHeartbeat->SetStatus(bIdle ? ESessionStatus::Idle : ESessionStatus::Active);
+	return true;
+}
+
+/* Called on the game thread once a ping of the heartbeat completed */
+void UUEGameJoltAPI::OnHeartbeatPinged(bool bReachedServer, bool bSucceeded)
+{
+	OnSessionPinged.Broadcast(bSucceeded);
+
+	// GameJolt closed the session meanwhile, e.g. after a long hitch. Open a new one, the heartbeat keeps going
+	if(bReachedServer && !bSucceeded && IsSessionHeartbeatRunning())
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Session expired. Opening a new one"));
+		StartRequest(EGameJoltComponentEnum::GJ_SESSION_OPEN, TEXT("/sessions/open/?"));
+	}
+}
+
+/* Closes the session of the running heartbeat before the engine exits */
+void UUEGameJoltAPI::OnPreExit()
+{
+	ShutdownSessionHeartbeat(true);
+}
+
+/* Copies the current request settings to the heartbeat thread */
+void UUEGameJoltAPI::UpdateHeartbeatSettings()
+{
+	if(SessionHeartbeat.IsValid())
+		SessionHeartbeat->SetRequestSettings(GetTransport(), GetRequestSigner(), UserName, UserToken);
+}
+
+/* Stops the heartbeat thread and closes its session without any callbacks */
+void UUEGameJoltAPI::ShutdownSessionHeartbeat(bool bFlush)
+{
+	if(PreExitHandle.IsValid())
+	{
+		FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+		PreExitHandle.Reset();
+	}
+	if(SessionStatusTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(SessionStatusTickerHandle);
+		SessionStatusTickerHandle.Reset();
+	}
+
+	if(!IsSessionHeartbeatRunning())
+		return;
+
+	SessionHeartbeat->Shutdown();
+	SessionHeartbeat->SendClose();
+
+	// The engine is about to exit, so wait for the close request instead of dropping it
+	if(bFlush)
+		FHttpModule::Get().GetHttpManager().Flush(false);
 }
 
 /* Gets the session status */
 bool UUEGameJoltAPI::GetSessionStatus()
 {
-	UUEGameJoltAPI* Response = GetObject("response");
-	if(!Response)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if(!Response.IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Response invalid in GetSessionStatus. Was ist called to early?"));
 		return false;
 	}
-	return Response->GetBool("success");
+	return FGameJoltResponseDecoder::DecodeSuccess(Response);
 }
 
 /* Gets an array of users and puts them in an array of FUserInfo structs */
 TArray<FUserInfo> UUEGameJoltAPI::GetUserInfo()
 {
-	TArray<UUEGameJoltAPI*> returnArray = GetObject("response")->GetObjectArray(GetObject("response"), "users");
-
 	TArray<FUserInfo> returnUserInfo;
-	
-	FUserInfo tempUser;
-
-	for (int i = 0; i< returnArray.Num(); i++)
-	{
-
-		tempUser.S_User_ID = returnArray[i]->GetInt("id");
-		tempUser.User_Name = returnArray[i]->GetString("username");
-		tempUser.User_Type = returnArray[i]->GetString("type");
-		tempUser.User_AvatarURL = returnArray[i]->GetString("avatar_url");
-		tempUser.Signed_up = returnArray[i]->GetString("signed_up");
-		tempUser.Last_Logged_in = returnArray[i]->GetString("last_logged_in");
-		tempUser.status = returnArray[i]->GetString("status");
-		returnUserInfo.Add(tempUser);
-	}
-	
+	FGameJoltResponseDecoder::DecodeUsers(GetResponseField(), returnUserInfo);
 	return returnUserInfo;
 }
 
 /* Awards the current user a trophy */
 bool UUEGameJoltAPI::RewardTrophy(const int32 Trophy_ID)
 {
-
-	bool ret = true;
-	FString output;
-	FString GameIDString;
-	FString TrophyIDString;
-	GameIDString = FString::FromInt(Game_ID);
 	if (!bIsLoggedIn)
 	{
 		UE_LOG(GJAPI, Error, TEXT("User is not logged in"));
 		return false;
 	}
-	TrophyIDString = FString::FromInt(Trophy_ID);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_TROPHIES_ADD;
-	ret = SendRequest(output, "/trophies/add-achieved/?trophy_id=" + TrophyIDString);
-
-
+	StartRequest(LastActionPerformed, FGameJoltQueryBuilder(TEXT("/trophies/add-achieved/")).Add(TEXT("trophy_id"), Trophy_ID).Build());
 	return true;
 }
 
@@ -299,12 +582,6 @@ void UUEGameJoltAPI::FetchAllTrophies(const EGameJoltAchievedTrophies AchievedTy
 /* Gets information for the selected trophies */
 void UUEGameJoltAPI::FetchTrophies(const EGameJoltAchievedTrophies AchievedType, const TArray<int32> Trophy_IDs)
 {
-	TArray<FTrophyInfo> returnTrophies;
-	bool ret = true;
-	FString output;
-	FString TrophyIDString;
-	FString AchievedString;
-
 	if (!bIsLoggedIn)
 	{
 		UE_LOG(GJAPI, Error, TEXT("User is not logged in!"));
@@ -312,33 +589,13 @@ void UUEGameJoltAPI::FetchTrophies(const EGameJoltAchievedTrophies AchievedType,
 	}
 	
 	LastActionPerformed = EGameJoltComponentEnum::GJ_TROPHIES_FETCH;
-	if(AchievedType == EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_GAME){
-
-		AchievedString ="false";
-	}
-	else
-	{
-		AchievedString = "true";
-	}
-
-	for (int32 i = 0; i < Trophy_IDs.Num(); i++){
-		TrophyIDString += FString::FromInt(Trophy_IDs[i]);
-		if (i != Trophy_IDs.Num()-1)
-		{
-			TrophyIDString += TEXT(",");
-		}
-	}
-	if (AchievedType == EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK)//if We Want to get all trophies
-	{
-		ret = SendRequest(output, "/trophies/?" + (Trophy_IDs.Num() > 0 ? "&trophy_id=" : "" + TrophyIDString));
-	}
-	else //if We Want to get what trophies the User achieved have Not Achieved
-	{
-		ret = SendRequest(output, "/trophies/?achieved=" + AchievedString +
-			(Trophy_IDs.Num() > 0 ? "&trophy_id=" : "" + TrophyIDString));
-	}
+	FGameJoltQueryBuilder Query(TEXT("/trophies/"), 48 + Trophy_IDs.Num() * 8);
+	if (AchievedType != EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_BLANK) //if We Want to get what trophies the User achieved have Not Achieved
+		Query.Add(TEXT("achieved"), AchievedType == EGameJoltAchievedTrophies::GJ_ACHIEVEDTROPHY_GAME ? TEXT("false") : TEXT("true"));
+	if (Trophy_IDs.Num() > 0)
+		Query.Add(TEXT("trophy_id"), Trophy_IDs);
 
-	if (!ret)
+	if (!StartRequest(LastActionPerformed, Query.Build()).IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Could not fetch trophies."));
 		return;
@@ -351,68 +608,46 @@ void UUEGameJoltAPI::FetchTrophies(const EGameJoltAchievedTrophies AchievedType,
 TArray<FTrophyInfo> UUEGameJoltAPI::GetTrophies()
 {
 	TArray<FTrophyInfo> returnTrophy;
-	TArray<UUEGameJoltAPI*> returnArray = GetObject("response")->GetObjectArray(GetObject("response"), "trophies");
-	FTrophyInfo tempTrophies;
-	for (int i = 0; i< returnArray.Num(); i++)
-	{
-		
-		tempTrophies.Trophy_ID = returnArray[i]->GetInt("id");
-		tempTrophies.Name = returnArray[i]->GetString("title");
-		tempTrophies.Description = returnArray[i]->GetString("description");
-		tempTrophies.Difficulty = returnArray[i]->GetString("difficulty");
-		tempTrophies.image_url = returnArray[i]->GetString("image_url");
-		tempTrophies.achieved = returnArray[i]->GetString("achieved");
-
-		returnTrophy.Add(tempTrophies);
-	}
-
-		return returnTrophy;
+	FGameJoltResponseDecoder::DecodeTrophies(GetResponseField(), returnTrophy);
+	return returnTrophy;
 }
 
 /* Unachieves a trophy */
 bool UUEGameJoltAPI::RemoveRewardedTrophy(const int32 Trophy_ID)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_TROHIES_REMOVE;
-	return SendRequest(output, "/trophies/remove-achieved/?trophy_id=" + FString::FromInt(Trophy_ID));
+	return StartRequest(LastActionPerformed, FGameJoltQueryBuilder(TEXT("/trophies/remove-achieved/")).Add(TEXT("trophy_id"), Trophy_ID).Build()).IsValid();
 }
 
 /* Checks if the trophy removel was successful */
 bool UUEGameJoltAPI::GetTrophyRemovalStatus()
 {
-	UUEGameJoltAPI* Response = GetObject("response"); 
-	if(!Response)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if(!Response.IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Response invalid in GetTrophyRemovalStatus. Was ist called to early?"));
 		return false;
 	}
-	return Response->GetBool("success");
+	return FGameJoltResponseDecoder::DecodeSuccess(Response);
 }
 
 /* Returns a list of scores either for a user or globally for a game */
 bool UUEGameJoltAPI::FetchScoreboard(const int32 ScoreLimit, const int32 Table_id, const int32 BetterThan, const int32 WorseThan)
 {
-	TArray<FTrophyInfo> returnTrophies;
-	bool ret = true;
-	FString output;
-	FString GameIDString;
-	FString TableIDString;
-	FString ScoreLimitString;
-
-	GameIDString = FString::FromInt(Game_ID);
-	TableIDString = FString::FromInt(Table_id);
-	ScoreLimitString = FString::FromInt(ScoreLimit);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SCORES_FETCH;
 
-	ret = SendRequest(output, TEXT("/scores/?game_id=") + GameIDString +
-		(!UserName.IsEmpty() || !bIsLoggedIn ? "&username=" : "") + UserName +
-		(bIsLoggedIn ? "&user_token=" : "") + UserToken +
-		(ScoreLimit > 0 ? "&limit=" + ScoreLimitString : "") +
-		(Table_id > 0 ? "&table_id=" + TableIDString : "") +
-		(BetterThan > 0 ? "&better_than=" + FString::FromInt(BetterThan) : "") +
-		(WorseThan > 0 ? "&worse_than=" + FString::FromInt(WorseThan) : ""));
-
-	if (!ret)
+	FGameJoltQueryBuilder Query(TEXT("/scores/"));
+	if (ScoreLimit > 0)
+		Query.Add(TEXT("limit"), ScoreLimit);
+	if (Table_id > 0)
+		Query.Add(TEXT("table_id"), Table_id);
+	if (BetterThan > 0)
+		Query.Add(TEXT("better_than"), BetterThan);
+	if (WorseThan > 0)
+		Query.Add(TEXT("worse_than"), WorseThan);
+
+	// The scores of the logged in user, or the global ones for guests
+	if (!StartRequest(LastActionPerformed, Query.Build(), bIsLoggedIn).IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Could not fetch scoreboard."));
 		return false;
@@ -425,42 +660,92 @@ bool UUEGameJoltAPI::FetchScoreboard(const int32 ScoreLimit, const int32 Table_i
 TArray<FScoreInfo> UUEGameJoltAPI::GetScoreboard()
 {
 	TArray<FScoreInfo> returnScoreInfo;
-	TArray<UUEGameJoltAPI*> returnArray = GetObject("response")->GetObjectArray(GetObject("response"), "scores");
-	FScoreInfo tempScore;
-	for (int i = 0; i < returnArray.Num(); i++)
-	{
-		tempScore.ScoreSort = returnArray[i]->GetInt("sort");
-		tempScore.ScoreString = returnArray[i]->GetString("score");
-		tempScore.ExtraData = returnArray[i]->GetString("extra_data");
-		tempScore.UserName = returnArray[i]->GetString("user");
-		tempScore.UserID = returnArray[i]->GetInt("user_id");
-		tempScore.Guest = returnArray[i]->GetString("guest");
-		tempScore.UnixTimestamp = returnArray[i]->GetString("stored");
-		tempScore.TimeStamp = FDateTime::FromUnixTimestamp(returnArray[i]->GetInt("stored"));
-		returnScoreInfo.Add(tempScore);
-	}
+	FGameJoltResponseDecoder::DecodeScores(GetResponseField(), returnScoreInfo);
 	return returnScoreInfo;
 }
 
 /* Adds an entry to a scoreboard */
 bool UUEGameJoltAPI::AddScore(const FString UserScore, const int32 UserScore_Sort, const FString GuestUser, const FString extra_data, const int32 table_id)
 {
-	bool ret = true;
-	FString output;
-	FString GameIDString;
-	FString TableIDString;
-
-	GameIDString = FString::FromInt(Game_ID);
-	TableIDString = FString::FromInt(table_id);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SCORES_ADD;
-	ret = SendRequest(output, "/scores/add/?score=" + UserScore +
-		TEXT("&sort=") + FString::FromInt(UserScore_Sort) +
-		(!UserName.IsEmpty() || bIsLoggedIn ? "&username=" : "") + UserName +
-		(bIsLoggedIn ? "&user_token=" : "") + UserToken +
-		(!bIsLoggedIn ? "&guest=" : "") + GuestUser +
-		(!extra_data.IsEmpty() ? "&extra_data=" : "") + extra_data +
-		(table_id > 0 ? "&table_id=" : "") + (table_id > 0 ? TableIDString : ""));
-	if (!ret)
+
+	// Shown on the local scoreboard right away, even if the score isn't sent
+	if(bKeepLocalScoreboards)
+	{
+		FScoreInfo Score;
+		Score.ScoreString = UserScore;
+		Score.ScoreSort = UserScore_Sort;
+		Score.ExtraData = extra_data;
+		if(bIsLoggedIn)
+			Score.UserName = UserName;
+		else
+			Score.Guest = GuestUser;
+		Score.TimeStamp = FDateTime::UtcNow();
+		GetLocalLeaderboard().AddLocalScore(table_id, Score);
+	}
+
+	if(!bSmartSubmitScores)
+		return SendScore(UserScore, UserScore_Sort, GuestUser, extra_data, table_id);
+
+	// A score which isn't a new personal best can't change the player's standing
+	FGameJoltScoreSubmitter& Submitter = GetScoreSubmitter();
+	const FString Player = FGameJoltScoreSubmitter::GetPlayerKey(bIsLoggedIn ? UserName : FString(), GuestUser);
+	if(!Submitter.IsImprovement(table_id, Player, UserScore_Sort))
+	{
+		UE_LOG(GJAPI, Verbose, TEXT("Not sending score %d, it doesn't beat the personal best on table %d"), UserScore_Sort, table_id);
+		INC_DWORD_STAT(STAT_GameJolt_ScoresSkipped);
+		return true;
+	}
+
+	// Without the game's settings the held score couldn't be sent either
+	if(ScoreSubmitWindow <= 0.f || Game_PrivateKey.IsEmpty() || Game_ID == 0)
+		return SendScore(UserScore, UserScore_Sort, GuestUser, extra_data, table_id);
+
+	FGameJoltHeldScore HeldScore;
+	HeldScore.UserScore = UserScore;
+	HeldScore.Sort = UserScore_Sort;
+	HeldScore.Guest = GuestUser;
+	HeldScore.ExtraData = extra_data;
+	HeldScore.TableID = table_id;
+	HeldScore.Player = Player;
+	if(Submitter.Hold(HeldScore))
+		INC_DWORD_STAT(STAT_GameJolt_ScoresSkipped);
+
+	// The window starts with the first score of a burst
+	if(!ScoreSubmitTickerHandle.IsValid())
+		ScoreSubmitTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnScoreSubmitWindowElapsed), ScoreSubmitWindow);
+	return true;
+}
+
+/* Sends a score to the server */
+bool UUEGameJoltAPI::SendScore(const FString& UserScore, int32 UserScore_Sort, const FString& GuestUser, const FString& extra_data, int32 table_id)
+{
+	FGameJoltQueryBuilder Query(TEXT("/scores/add/"), 64 + UserScore.Len() * 3 + GuestUser.Len() * 3 + extra_data.Len() * 3);
+	Query.Add(TEXT("score"), UserScore);
+	Query.Add(TEXT("sort"), UserScore_Sort);
+	if (!bIsLoggedIn)
+		Query.Add(TEXT("guest"), GuestUser);
+	if (!extra_data.IsEmpty())
+		Query.Add(TEXT("extra_data"), extra_data);
+	if (table_id > 0)
+		Query.Add(TEXT("table_id"), table_id);
+
+	// The score counts as the personal best while it is sent, so the next ones are compared against it
+	FGameJoltRequestCallback OnComplete;
+	if(bSmartSubmitScores)
+	{
+		const FString Player = FGameJoltScoreSubmitter::GetPlayerKey(bIsLoggedIn ? UserName : FString(), GuestUser);
+		const TOptional<int32> PreviousBest = GetScoreSubmitter().SetBest(table_id, Player, UserScore_Sort);
+		TWeakObjectPtr<UUEGameJoltAPI> WeakThis(this);
+		OnComplete = [WeakThis, table_id, Player, UserScore_Sort, PreviousBest](const FGameJoltRequest& CompletedRequest)
+		{
+			if(!CompletedRequest.bSucceeded && WeakThis.IsValid() && WeakThis->ScoreSubmitter.IsValid())
+				WeakThis->ScoreSubmitter->RestoreBest(table_id, Player, UserScore_Sort, PreviousBest);
+		};
+	}
+
+	// Logged in users submit with their username and token, guests with their name only
+	if (!StartRequest(EGameJoltComponentEnum::GJ_SCORES_ADD, Query.Build(), bIsLoggedIn, MoveTemp(OnComplete)).IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Failed to add user's score"));
 		return false;
@@ -469,19 +754,44 @@ bool UUEGameJoltAPI::AddScore(const FString UserScore, const int32 UserScore_Sor
 	return true;
 }
 
+/* Sends the scores held back by smart submission right away */
+void UUEGameJoltAPI::FlushScoreSubmissions()
+{
+	if(ScoreSubmitTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(ScoreSubmitTickerHandle);
+		ScoreSubmitTickerHandle.Reset();
+	}
+
+	if(!ScoreSubmitter.IsValid())
+		return;
+	for(const FGameJoltHeldScore& HeldScore : ScoreSubmitter->TakeHeldScores())
+		SendScore(HeldScore.UserScore, HeldScore.Sort, HeldScore.Guest, HeldScore.ExtraData, HeldScore.TableID);
+}
+
+/* Ticker callback which sends the best score of every burst once the submission window ended */
+bool UUEGameJoltAPI::OnScoreSubmitWindowElapsed(float DeltaTime)
+{
+	ScoreSubmitTickerHandle.Reset();
+	FlushScoreSubmissions();
+	return false;
+}
+
+/* Gets the best scores kept on disk */
+TArray<FScoreInfo> UUEGameJoltAPI::GetLocalScoreboard(const int32 Table_id, const int32 ScoreLimit)
+{
+	TArray<FScoreInfo> returnScoreInfo;
+	if(bKeepLocalScoreboards)
+		GetLocalLeaderboard().GetScores(FMath::Max(Table_id, 0), ScoreLimit, returnScoreInfo);
+	return returnScoreInfo;
+}
+
 /* Fetches all scoreboard tables */
 bool UUEGameJoltAPI::FetchScoreboardTable()
 {
-	bool ret = true;
-	FString output;
-	FString GameIDString;
-
-	GameIDString = FString::FromInt(Game_ID);
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SCORES_TABLE;
 
-	ret = SendRequest(output, "/scores/tables/?");
-
-	if (!ret)
+	if (!StartRequest(LastActionPerformed, TEXT("/scores/tables/?")).IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Could not fetch scoreboard table"));
 		return false;
@@ -494,17 +804,7 @@ bool UUEGameJoltAPI::FetchScoreboardTable()
 TArray<FScoreTableInfo> UUEGameJoltAPI::GetScoreboardTable()
 {
 	TArray<FScoreTableInfo> returnTableinfo;
-	FScoreTableInfo tempTable;
-	TArray<UUEGameJoltAPI*> returnArray = GetObject("response")->GetObjectArray(GetObject("response"), "tables");
-	for (int i = 0; i < returnArray.Num(); i++)
-	{
-		tempTable.Id = returnArray[i]->GetInt("id");
-		tempTable.Name = returnArray[i]->GetString("name");
-		tempTable.Description = returnArray[i]->GetString("description");
-		tempTable.Primary = returnArray[i]->GetString("primary");
-		returnTableinfo.Add(tempTable);
-	}
-
+	FGameJoltResponseDecoder::DecodeScoreTables(GetResponseField(), returnTableinfo);
 	return returnTableinfo;
 }
 
@@ -512,68 +812,287 @@ TArray<FScoreTableInfo> UUEGameJoltAPI::GetScoreboardTable()
 bool UUEGameJoltAPI::FetchRank(const int32 Score, const int32 TableID = 0)
 {
 	LastActionPerformed = EGameJoltComponentEnum::GJ_SCORES_RANK;
-	FString output;
-	return SendRequest(output, "/scores/get-rank/?sort=" + FString::FromInt(Score) + ((TableID != 0) ? ("&table_id=" + FString::FromInt(TableID)) : ""));
+	FGameJoltQueryBuilder Query(TEXT("/scores/get-rank/"));
+	Query.Add(TEXT("sort"), Score);
+	if (TableID != 0)
+		Query.Add(TEXT("table_id"), TableID);
+	return StartRequest(LastActionPerformed, Query.Build()).IsValid();
 }
 
 /* Gets the rank of a highscore from the response */
 int32 UUEGameJoltAPI::GetRank()
 {
-	UUEGameJoltAPI* response = GetObject("response");
-	if(!response)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if(!Response.IsValid())
 	{
 		UE_LOG(GJAPI, Error, TEXT("Response in GetRank is invalid! Was it called to early? LastActionPerformed is %s"), *UEnum::GetValueAsString<EGameJoltComponentEnum>(LastActionPerformed));
 		return 0;
 	}
-	return GetObject("response")->GetInt("rank");
+	return FGameJoltResponseDecoder::DecodeInt(*Response, TEXT("rank"));
 }
 
 #pragma region Data-Store
 
 void UUEGameJoltAPI::SetData(EDataStore Type, FString key, FString data)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_DATASTORE_SET;
-	SendRequest(output, "/data-store/set/?key=" + key + "&data=" + data, Type == EDataStore::User);
+	FGameJoltDataWrite Write;
+	Write.Kind = EGameJoltDataWriteKind::Set;
+	Write.Value = data;
+	WriteData(Type, key, Write);
 }
 
 void UUEGameJoltAPI::FetchData(EDataStore Type, FString key)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_DATASTORE_FETCH;
-	SendRequest(output, "/data-store/?key=" + key, Type == EDataStore::User);
+	const FString Endpoint = FGameJoltQueryBuilder(TEXT("/data-store/")).Add(TEXT("key"), key).Build();
+	const FString EntryKey = FGameJoltDataStoreCache::GetEntryKey(Type, UserName, key);
+	if(!DataStoreCache.IsValid() || !DataStoreCache->HasWrites(EntryKey))
+	{
+		StartRequest(LastActionPerformed, Endpoint, Type == EDataStore::User);
+		return;
+	}
+
+	// Held writes which start with a set or remove don't depend on the server, so their result is answered right away
+	bool bExists = false;
+	FString Data;
+	if(DataStoreCache->GetKnownData(EntryKey, bExists, Data))
+	{
+		TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+		Response->SetStringField(TEXT("success"), bExists ? TEXT("true") : TEXT("false"));
+		if(bExists)
+			Response->SetStringField(TEXT("data"), Data);
+		else
+			Response->SetStringField(TEXT("message"), TEXT("There is no item with the key passed in."));
+
+		TSharedRef<FGameJoltRequest> GameJoltRequest = MakeShared<FGameJoltRequest>();
+		GameJoltRequest->Id = NextRequestId++;
+		GameJoltRequest->Action = LastActionPerformed;
+		GameJoltRequest->Endpoint = Endpoint;
+		GameJoltRequest->bAppendUserInfo = Type == EDataStore::User;
+		GameJoltRequest->Data = MakeShared<FJsonObject>();
+		GameJoltRequest->Data->SetObjectField(TEXT("response"), Response);
+		GameJoltRequest->Response = Response;
+		GameJoltRequest->bFromCache = true;
+		FGameJoltRequestTrace::Begin(*GameJoltRequest);
+		FinishDeferred(GameJoltRequest);
+		return;
+	}
+
+	// Otherwise the held writes are sent first and the data is fetched after them
+	TWeakObjectPtr<UUEGameJoltAPI> WeakThis(this);
+	DataStoreCache->AddWaiter(EntryKey, [WeakThis, Endpoint, Type]()
+	{
+		if(WeakThis.IsValid())
+			WeakThis->StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_FETCH, Endpoint, Type == EDataStore::User);
+	});
+	if(DataStoreCache->BeginSending(EntryKey))
+		SendNextHeldDataWrite(EntryKey);
 }
 
 void UUEGameJoltAPI::UpdateData(EDataStore Type, FString key, EDataOperation Operation, FString value)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_DATASTORE_UPDATE;
-	SendRequest(output, "/data-store/update/?key=" + key + "&value=" + value + "&operation=" + UEnum::GetValueAsString<EDataOperation>(Operation).RightChop(16), Type == EDataStore::User);
+	FGameJoltDataWrite Write;
+	Write.Kind = EGameJoltDataWriteKind::Update;
+	Write.Operation = Operation;
+	Write.Value = value;
+	WriteData(Type, key, Write);
 }
 
 void UUEGameJoltAPI::RemoveData(EDataStore Type, FString key)
 {
-	FString output;
 	LastActionPerformed = EGameJoltComponentEnum::GJ_DATASTORE_REMOVE;
-	SendRequest(output, "/data-store/remove/?key=" + key, Type == EDataStore::User);
+	FGameJoltDataWrite Write;
+	Write.Kind = EGameJoltDataWriteKind::Remove;
+	WriteData(Type, key, Write);
+}
+
+/* Fetches the keys of the data-store */
+bool UUEGameJoltAPI::FetchDataKeys(EDataStore Type, const FString Pattern)
+{
+	LastActionPerformed = EGameJoltComponentEnum::GJ_DATASTORE_KEYS;
+
+	FGameJoltQueryBuilder Query(TEXT("/data-store/get-keys/"));
+	if(!Pattern.IsEmpty())
+		Query.Add(TEXT("pattern"), Pattern);
+
+	if(!StartRequest(LastActionPerformed, Query.Build(), Type == EDataStore::User).IsValid())
+	{
+		UE_LOG(GJAPI, Error, TEXT("Could not fetch data keys"));
+		return false;
+	}
+
+	return true;
+}
+
+/* Gets the keys fetched with FetchDataKeys */
+TArray<FString> UUEGameJoltAPI::GetDataKeys()
+{
+	TArray<FString> returnKeys;
+	FGameJoltResponseDecoder::DecodeDataKeys(GetResponseField(), returnKeys);
+	return returnKeys;
 }
 
 void UUEGameJoltAPI::GetData(bool& Success, FString& DataAsString, int32& DataAsInt)
 {
 	DataAsString = "";
 	DataAsInt = 0;
-	UUEGameJoltAPI* response = GetObject("response");
-	if(!response)
+	const TSharedPtr<FJsonObject> Response = GetResponseField();
+	if(!Response.IsValid())
 	{
 		Success = false;
 		return;
 	}
-	Success = response->GetBool("success");
+	Success = FGameJoltResponseDecoder::DecodeSuccess(Response);
 	if(!Success)
 		return;
 	
-	DataAsString = response->GetString("data");
-	DataAsInt = response->GetInt("data");
+	DataAsString = FGameJoltResponseDecoder::DecodeString(*Response, TEXT("data"));
+	DataAsInt = FCString::Atoi(*DataAsString);
+}
+
+/* Sends a data-store write to the server */
+TSharedPtr<FGameJoltRequest> UUEGameJoltAPI::SendDataWrite(EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write, FGameJoltRequestCallback OnComplete)
+{
+	static const TCHAR* const OperationNames[] = { TEXT("add"), TEXT("subtract"), TEXT("multiply"), TEXT("divide"), TEXT("append"), TEXT("prepend") };
+
+	switch(Write.Kind)
+	{
+		case EGameJoltDataWriteKind::Set:
+		{
+			FGameJoltQueryBuilder Query(TEXT("/data-store/set/"), 48 + Key.Len() * 3 + Write.Value.Len() * 3);
+			Query.Add(TEXT("key"), Key).Add(TEXT("data"), Write.Value);
+			return StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_SET, Query.Build(), Type == EDataStore::User, MoveTemp(OnComplete));
+		}
+		case EGameJoltDataWriteKind::Update:
+		{
+			FGameJoltQueryBuilder Query(TEXT("/data-store/update/"), 64 + Key.Len() * 3 + Write.Value.Len() * 3);
+			Query.Add(TEXT("key"), Key).Add(TEXT("value"), Write.Value).Add(TEXT("operation"), OperationNames[static_cast<uint8>(Write.Operation)]);
+			return StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_UPDATE, Query.Build(), Type == EDataStore::User, MoveTemp(OnComplete));
+		}
+		case EGameJoltDataWriteKind::Remove:
+			return StartRequest(EGameJoltComponentEnum::GJ_DATASTORE_REMOVE, FGameJoltQueryBuilder(TEXT("/data-store/remove/")).Add(TEXT("key"), Key).Build(), Type == EDataStore::User, MoveTemp(OnComplete));
+	}
+	return nullptr;
+}
+
+/* Sends a data-store write right away, or holds it back in the write-behind cache */
+void UUEGameJoltAPI::WriteData(EDataStore Type, const FString& Key, const FGameJoltDataWrite& Write)
+{
+	const FString EntryKey = FGameJoltDataStoreCache::GetEntryKey(Type, UserName, Key);
+	if(!bWriteBehindDataStore && (!DataStoreCache.IsValid() || !DataStoreCache->HasWrites(EntryKey)))
+	{
+		SendDataWrite(Type, Key, Write);
+		return;
+	}
+
+	// Also held if the cache was turned off in the meantime, so the write isn't sent before the ones held for its key
+	if(GetDataStoreCache().Add(EntryKey, Type, Key, Write))
+		INC_DWORD_STAT(STAT_GameJolt_DataWritesMerged);
+
+	if(!DataStoreFlushTickerHandle.IsValid())
+		DataStoreFlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnDataStoreFlushIntervalElapsed), DataStoreFlushInterval);
+}
+
+/* Sends the next held write of a key once the one before it completed */
+void UUEGameJoltAPI::SendNextHeldDataWrite(const FString& EntryKey)
+{
+	EDataStore Type = EDataStore::Global;
+	FString Key;
+	const FGameJoltDataWrite* Write = DataStoreCache->GetNextToSend(EntryKey, Type, Key);
+	if(!Write)
+	{
+		// Fetches waiting for the key need the writes held in the meantime as well
+		if(DataStoreCache->HasWaiters(EntryKey) && DataStoreCache->BeginSending(EntryKey))
+		{
+			SendNextHeldDataWrite(EntryKey);
+			return;
+		}
+		for(const TFunction<void()>& Waiter : DataStoreCache->TakeWaiters(EntryKey))
+			Waiter();
+
+		// Writes held while these were sent wait for the next interval
+		if(DataStoreCache->HasWrites(EntryKey) && !DataStoreFlushTickerHandle.IsValid())
+			DataStoreFlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnDataStoreFlushIntervalElapsed), DataStoreFlushInterval);
+		return;
+	}
+
+	// User data is only written for the user who made the write
+	if(Type == EDataStore::User && EntryKey != FGameJoltDataStoreCache::GetEntryKey(Type, UserName, Key))
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Dropping a held data-store write of %s, its user logged off"), *EntryKey);
+		DataStoreCache->OnSent(EntryKey);
+		SendNextHeldDataWrite(EntryKey);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_GameJolt_DataWritesFlushed);
+	DataStoreCache->Sent++;
+	TWeakObjectPtr<UUEGameJoltAPI> WeakThis(this);
+	const TSharedPtr<FGameJoltRequest> GameJoltRequest = SendDataWrite(Type, Key, *Write, [WeakThis, EntryKey](const FGameJoltRequest& CompletedRequest)
+	{
+		if(!WeakThis.IsValid() || !WeakThis->DataStoreCache.IsValid())
+			return;
+		if(!CompletedRequest.bSucceeded)
+			UE_LOG(GJAPI, Warning, TEXT("A held data-store write of %s failed"), *EntryKey);
+		WeakThis->DataStoreCache->OnSent(EntryKey);
+		WeakThis->SendNextHeldDataWrite(EntryKey);
+	});
+
+	// Without the game's settings none of the held writes can be sent
+	if(!GameJoltRequest.IsValid())
+	{
+		DataStoreCache->OnSent(EntryKey);
+		SendNextHeldDataWrite(EntryKey);
+	}
+}
+
+/* Sends the data-store writes held back by the write-behind cache right away */
+void UUEGameJoltAPI::FlushDataStoreWrites()
+{
+	if(DataStoreFlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(DataStoreFlushTickerHandle);
+		DataStoreFlushTickerHandle.Reset();
+	}
+
+	if(!DataStoreCache.IsValid())
+		return;
+	for(const FString& EntryKey : DataStoreCache->GetFlushableKeys())
+	{
+		if(DataStoreCache->BeginSending(EntryKey))
+			SendNextHeldDataWrite(EntryKey);
+	}
+}
+
+/* Ticker callback which sends the held data-store writes */
+bool UUEGameJoltAPI::OnDataStoreFlushIntervalElapsed(float DeltaTime)
+{
+	DataStoreFlushTickerHandle.Reset();
+	FlushDataStoreWrites();
+	return false;
+}
+
+/* Gets the merge and flush counters of the write-behind data-store cache */
+FGameJoltDataStoreWriteStats UUEGameJoltAPI::GetDataStoreWriteStats() const
+{
+	FGameJoltDataStoreWriteStats Stats;
+	if(DataStoreCache.IsValid())
+	{
+		Stats.Merged = DataStoreCache->Merged;
+		Stats.Sent = DataStoreCache->Sent;
+		Stats.Pending = DataStoreCache->NumWrites();
+	}
+	return Stats;
+}
+
+/* Gets the write-behind data-store cache, creating it on first use */
+FGameJoltDataStoreCache& UUEGameJoltAPI::GetDataStoreCache()
+{
+	if(!DataStoreCache.IsValid())
+		DataStoreCache = MakeShared<FGameJoltDataStoreCache>();
+	return *DataStoreCache;
 }
 
 #pragma endregion
@@ -598,8 +1117,17 @@ UUEGameJoltAPI* UUEGameJoltAPI::GetObject(const FString& key)
 	return fieldObj;
 }
 
-/* Gets a string field */
-FString UUEGameJoltAPI::GetString(const FString& key) const
+/* Gets the "response" object of the response which completed last */
+TSharedPtr<FJsonObject> UUEGameJoltAPI::GetResponseField() const
+{
+	const TSharedPtr<FJsonObject>* ResponseObject;
+	if(!Data.IsValid() || !Data->TryGetObjectField(TEXT("response"), ResponseObject))
+		return nullptr;
+	return *ResponseObject;
+}
+
+/* Gets a string field */
+FString UUEGameJoltAPI::GetString(const FString& key) const
 {
 	FString outString;
 	if (!Data->TryGetStringField(*key, outString))
@@ -675,89 +1203,758 @@ TArray<UUEGameJoltAPI*> UUEGameJoltAPI::GetObjectArray(UObject* WorldContextObje
 
 /* Sends a request */
 bool UUEGameJoltAPI::SendRequest(const FString& output, FString url, bool bAppendUserInfo)
+{
+	return StartRequest(LastActionPerformed, url, bAppendUserInfo, nullptr, output).IsValid();
+}
+
+/* Sends a request with its own context */
+TSharedPtr<FGameJoltRequest> UUEGameJoltAPI::StartRequest(EGameJoltComponentEnum Action, const FString& Endpoint, bool bAppendUserInfo, FGameJoltRequestCallback OnComplete, const FString& Body, bool bSilent, bool bDirect)
 {
 	if (Game_PrivateKey == TEXT(""))
 	{
 		UE_LOG(GJAPI, Error, TEXT("You must put in your game's private key before you can use any of the API functions."));
-		return false;
+		return nullptr;
 	}
 
 	if(Game_ID == 0)
 	{
 		UE_LOG(GJAPI, Error, TEXT("You must put in your game's ID before you can use any of the API functions"));
-		return false;
+		return nullptr;
 	}
 
-	FString outStr;
-	TSharedRef<TJsonWriter<TCHAR>> JsonWriter = TJsonWriterFactory<TCHAR>::Create(&outStr);
-	//Start writing the response
-	WriteObject(JsonWriter, "", new FJsonValueObject(Data));
-	JsonWriter->Close();
-	
-	//Create URL First
-	url = TEXT("https://") + GJAPI_SERVER + GJAPI_ROOT + GJAPI_VERSION + url + "&game_id=" + FString::FromInt(Game_ID);
+	TSharedRef<FGameJoltRequest> GameJoltRequest = MakeShared<FGameJoltRequest>();
+	GameJoltRequest->Id = NextRequestId++;
+	GameJoltRequest->Action = Action;
+	GameJoltRequest->Endpoint = Endpoint;
+	GameJoltRequest->Body = Body;
+	GameJoltRequest->bAppendUserInfo = bAppendUserInfo;
+	GameJoltRequest->OnComplete = MoveTemp(OnComplete);
+	GameJoltRequest->bSilent = bSilent;
+	GameJoltRequest->bDirect = bDirect;
+	FGameJoltRequestTrace::Begin(*GameJoltRequest);
+
+	if(bCacheResponses && Body.IsEmpty() && TryServeFromCache(GameJoltRequest))
+		return GameJoltRequest;
+
+	if(bMergeIdenticalRequests && Body.IsEmpty() && TryMergeInFlight(GameJoltRequest))
+		return GameJoltRequest;
+
+	const bool bIsWrite = Action == EGameJoltComponentEnum::GJ_SCORES_ADD
+		|| Action == EGameJoltComponentEnum::GJ_TROPHIES_ADD
+		|| Action == EGameJoltComponentEnum::GJ_DATASTORE_SET
+		|| Action == EGameJoltComponentEnum::GJ_DATASTORE_UPDATE;
+	if(bQueueOfflineWrites && bIsWrite && Body.IsEmpty() && !bDirect)
+	{
+		// Keep the user of the time of the write, the replay might happen in a later session
+		if(bAppendUserInfo)
+		{
+			GameJoltRequest->Endpoint += TEXT("&username=");
+			FGameJoltQueryBuilder::AppendEncoded(GameJoltRequest->Endpoint, UserName);
+			GameJoltRequest->Endpoint += TEXT("&user_token=");
+			FGameJoltQueryBuilder::AppendEncoded(GameJoltRequest->Endpoint, UserToken);
+			GameJoltRequest->bAppendUserInfo = false;
+		}
+
+		FGameJoltWriteJournal& Journal = GetWriteJournal();
+		GameJoltRequest->JournalKey = Journal.Append(Action, GameJoltRequest->Endpoint);
+		JournaledRequests.Add(GameJoltRequest->JournalKey, GameJoltRequest);
+
+		// Writes are sent in the order they were made, so this one waits for the queued ones
+		FGameJoltJournalEntry* Entry = Journal.Find(GameJoltRequest->JournalKey);
+		if(!Entry)
+		{
+			// Dropped right away, the journal is full of writes in flight
+			JournaledRequests.Remove(GameJoltRequest->JournalKey);
+			return GameJoltRequest;
+		}
+		if(Journal.IsWaitingBehindOthers(GameJoltRequest->JournalKey))
+		{
+			ReplayQueuedWrites();
+			return GameJoltRequest;
+		}
+		Entry->bInFlight = true;
+	}
+
+	SubmitRequest(GameJoltRequest);
+	return GameJoltRequest;
+}
+
+/* Adds the request to the collected batch or processes it right away */
+void UUEGameJoltAPI::SubmitRequest(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	if(!AllowByCircuit(*GameJoltRequest))
+	{
+		FailFast(GameJoltRequest);
+		return;
+	}
+
+	// Sub-requests of a batch can't carry any content
+	if(bBatchRequests && GameJoltRequest->Body.IsEmpty() && !GameJoltRequest->bDirect && GameJoltRequest->Action != EGameJoltComponentEnum::GJ_BATCH)
+	{
+		PendingBatch.Add(GameJoltRequest);
+		INC_DWORD_STAT(STAT_GameJolt_Queued);
+		if(PendingBatch.Num() >= GJAPI_MAX_BATCH_SIZE)
+			FlushBatch();
+		else if(!BatchTickerHandle.IsValid())
+			BatchTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnBatchWindowElapsed), BatchWindow);
+		return;
+	}
+
+	ProcessRequest(GameJoltRequest);
+}
+
+/* Hands the request over to the scheduler, or sends it right away if requests aren't throttled */
+void UUEGameJoltAPI::ProcessRequest(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	if(!bThrottleRequests)
+	{
+		SendToTransport(GameJoltRequest);
+		return;
+	}
+
+	GetRequestScheduler().Enqueue(GameJoltRequest, GetRequestPriority(*GameJoltRequest));
+	PumpScheduler();
+}
+
+/* Gets the priority of a request */
+EGameJoltRequestPriority UUEGameJoltAPI::GetRequestPriority(const FGameJoltRequest& GameJoltRequest) const
+{
+	if(GameJoltRequest.SubRequests.Num() > 0)
+	{
+		EGameJoltRequestPriority Highest = EGameJoltRequestPriority::Background;
+		for(const TSharedRef<FGameJoltRequest>& SubRequest : GameJoltRequest.SubRequests)
+			Highest = FMath::Min(Highest, GetRequestPriority(*SubRequest));
+		return Highest;
+	}
+
+	const EGameJoltRequestPriority* Priority = RequestPriorities.Find(GameJoltRequest.Action);
+	return Priority ? *Priority : EGameJoltRequestPriority::Normal;
+}
+
+/* Gets the request scheduler, configured with the current limits */
+FGameJoltRequestScheduler& UUEGameJoltAPI::GetRequestScheduler()
+{
+	if(!RequestScheduler.IsValid())
+		RequestScheduler = MakeShared<FGameJoltRequestScheduler>();
+	RequestScheduler->Configure(RateLimits, MaxConcurrentRequests);
+	return *RequestScheduler;
+}
+
+/* Sends the queued requests which may go out now and schedules the next attempt */
+void UUEGameJoltAPI::PumpScheduler()
+{
+	if(!RequestScheduler.IsValid() || RequestScheduler->Num() == 0)
+		return;
+
+	FGameJoltRequestScheduler& Scheduler = GetRequestScheduler();
+	float RetryIn = -1.f;
+	while(TSharedPtr<FGameJoltRequest> GameJoltRequest = Scheduler.Dequeue(PendingRequests.Num(), RetryIn))
+		SendToTransport(GameJoltRequest.ToSharedRef());
 
-	if(bAppendUserInfo)
-		url += "&username=" + UserName + "&user_token=" + UserToken;
+	// Without a retry time the next completed request frees a slot and pumps again
+	if(RetryIn >= 0.f && !SchedulerTickerHandle.IsValid())
+		SchedulerTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnSchedulerTick), RetryIn);
+}
+
+/* Sends the queued requests once tokens refilled */
+bool UUEGameJoltAPI::OnSchedulerTick(float DeltaTime)
+{
+	SchedulerTickerHandle.Reset();
+	PumpScheduler();
+	return false;
+}
 
-	FString signature(FMD5::HashAnsiString(*(url + Game_PrivateKey)));
-	url += TEXT("&signature=") + signature;
+/* Gets the counters of the request scheduler */
+FGameJoltSchedulerStats UUEGameJoltAPI::GetSchedulerStats() const
+{
+	if(!RequestScheduler.IsValid())
+		return FGameJoltSchedulerStats();
+	return RequestScheduler->GetStats();
+}
+
+/* Signs the request and hands it over to the transport */
+void UUEGameJoltAPI::SendToTransport(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	const FString url = BuildRequestUrl(*GameJoltRequest, false);
 	UE_LOG(GJAPI, Log, TEXT("%s"), *url);
 
+	// From here on a journaled write may reach the server, even if no answer comes back
+	if(JournaledRequests.Num() > 0)
+	{
+		if(!GameJoltRequest->JournalKey.IsEmpty())
+			GetWriteJournal().MarkSent(GameJoltRequest->JournalKey);
+		for(const TSharedRef<FGameJoltRequest>& SubRequest : GameJoltRequest->SubRequests)
+		{
+			if(!SubRequest->JournalKey.IsEmpty())
+				GetWriteJournal().MarkSent(SubRequest->JournalKey);
+		}
+	}
 
-	TSharedRef<IHttpRequest> HttpRequest = FHttpModule::Get().CreateRequest();
-	HttpRequest->SetVerb("POST");
-	HttpRequest->SetURL(url);
-	HttpRequest->SetHeader("Content-Type", "application/json");
-	HttpRequest->SetContentAsString(output);
-	HttpRequest->OnProcessRequestComplete().BindUObject(this, &UUEGameJoltAPI::OnReady);
-	HttpRequest->ProcessRequest();
-	
-	return true;
-	
+	PendingRequests.Add(GameJoltRequest->Id, GameJoltRequest);
+	INC_DWORD_STAT(STAT_GameJolt_InFlight);
+	TWeakObjectPtr<UUEGameJoltAPI> WeakThis(this);
+	GetTransport()->Send(url, GameJoltRequest->Body, [WeakThis, GameJoltRequest](bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& ResponseContent)
+	{
+		if(WeakThis.IsValid())
+			WeakThis->OnReady(bWasSuccessful, ResponseCode, ResponseContent, GameJoltRequest);
+	});
+}
+
+/* Sets the transport requests are sent with */
+void UUEGameJoltAPI::SetTransport(TSharedPtr<IGameJoltTransport, ESPMode::ThreadSafe> InTransport)
+{
+	Transport = InTransport;
+	UpdateHeartbeatSettings();
+}
+
+/* Gets the transport requests are sent with */
+TSharedRef<IGameJoltTransport, ESPMode::ThreadSafe> UUEGameJoltAPI::GetTransport()
+{
+	if(!Transport.IsValid())
+		Transport = MakeShared<FGameJoltHttpTransport, ESPMode::ThreadSafe>();
+	return Transport.ToSharedRef();
 }
 
-/* Writes data */
-void UUEGameJoltAPI::WriteObject(TSharedRef<TJsonWriter<TCHAR>> writer, FString key, FJsonValue* value) {
-	if (value->Type == EJson::String) {
-		// Write simple string entry, don't a key when it isn't set
-		if (key.Len() > 0) {
-			writer->WriteValue(key, value->AsString());
+/* Builds the signed URL of a request */
+FString UUEGameJoltAPI::BuildRequestUrl(const FGameJoltRequest& GameJoltRequest, bool bAsSubRequest)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameJolt_BuildUrl);
+	const FGameJoltRequestSigner& Signer = GetRequestSigner();
+	if(GameJoltRequest.bAppendUserInfo)
+		return Signer.BuildUrl(GameJoltRequest.Endpoint, !bAsSubRequest, &UserName, &UserToken);
+	return Signer.BuildUrl(GameJoltRequest.Endpoint, !bAsSubRequest, nullptr, nullptr);
+}
+
+/* Gets the request signer, configured with the current settings */
+FGameJoltRequestSigner& UUEGameJoltAPI::GetRequestSigner()
+{
+	if(!RequestSigner.IsValid())
+		RequestSigner = MakeShared<FGameJoltRequestSigner>();
+	RequestSigner->Configure(GJAPI_SERVER, GJAPI_ROOT, GJAPI_VERSION, Game_ID, Game_PrivateKey, SignatureAlgorithm);
+	return *RequestSigner;
+}
+
+/* Sends all collected requests as a single batch request */
+void UUEGameJoltAPI::FlushBatch()
+{
+	if(BatchTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(BatchTickerHandle);
+		BatchTickerHandle.Reset();
+	}
+
+	if(PendingBatch.Num() == 0)
+		return;
+
+	DEC_DWORD_STAT_BY(STAT_GameJolt_Queued, PendingBatch.Num());
+	TArray<TSharedRef<FGameJoltRequest>> SubRequests = MoveTemp(PendingBatch);
+	PendingBatch.Reset();
+
+	// The heartbeat's ping rides along if it would be due soon anyway
+	if(IsSessionHeartbeatRunning() && SubRequests.Num() < GJAPI_MAX_BATCH_SIZE && SessionHeartbeat->IsPingDue(SessionPingInterval * 0.5f))
+	{
+		TSharedRef<FGameJoltRequest> Ping = MakeShared<FGameJoltRequest>();
+		Ping->Id = NextRequestId++;
+		Ping->Action = EGameJoltComponentEnum::GJ_SESSION_PING;
+		Ping->Endpoint = SessionHeartbeat->BuildPingEndpoint();
+		Ping->bSilent = true;
+		SubRequests.Add(Ping);
+		SessionHeartbeat->NotifyPinged();
+	}
+
+	// Every sub-request's URL is percent-encoded into the batch URL, so they are split across batches before it grows too long
+	TArray<FString> EncodedUrls;
+	EncodedUrls.Reserve(SubRequests.Num());
+	for(const TSharedRef<FGameJoltRequest>& SubRequest : SubRequests)
+		FGameJoltQueryBuilder::AppendEncoded(EncodedUrls.AddDefaulted_GetRef(), BuildRequestUrl(*SubRequest, true));
+
+	static const TCHAR SubRequestKey[] = TEXT("requests[]");
+	const int32 SubRequestKeyLen = FCString::Strlen(SubRequestKey) + 2;
+	const int32 MaxEndpointLen = GJAPI_MAX_BATCH_URL_LENGTH - GetRequestSigner().GetUrlPrefix().Len() - GJAPI_BATCH_SIGNATURE_RESERVE;
+
+	int32 Next = 0;
+	while(Next < SubRequests.Num())
+	{
+		FGameJoltQueryBuilder Query(TEXT("/batch/"), FMath::Min(MaxEndpointLen, 48 + (SubRequests.Num() - Next) * 256));
+		if(bBatchParallel)
+			Query.Add(TEXT("parallel"), TEXT("true"));
+		if(bBatchBreakOnError)
+			Query.Add(TEXT("break_on_error"), TEXT("true"));
+
+		// At least one sub-request per batch, even if its URL alone is too long
+		TArray<TSharedRef<FGameJoltRequest>> BatchSubRequests;
+		while(Next < SubRequests.Num() && (BatchSubRequests.Num() == 0 || Query.Len() + SubRequestKeyLen + EncodedUrls[Next].Len() <= MaxEndpointLen))
+		{
+			Query.AddEncoded(SubRequestKey, EncodedUrls[Next]);
+			BatchSubRequests.Add(SubRequests[Next++]);
 		}
-		else {
-			writer->WriteValue(value->AsString());
+
+		// A batch of one is just a detour
+		if(BatchSubRequests.Num() == 1)
+		{
+			ProcessRequest(BatchSubRequests[0]);
+			continue;
 		}
+
+		TSharedRef<FGameJoltRequest> BatchRequest = MakeShared<FGameJoltRequest>();
+		BatchRequest->Id = NextRequestId++;
+		BatchRequest->Action = EGameJoltComponentEnum::GJ_BATCH;
+		BatchRequest->Endpoint = Query.Build();
+		BatchRequest->bAppendUserInfo = false;
+		BatchRequest->SubRequests = MoveTemp(BatchSubRequests);
+		ProcessRequest(BatchRequest);
 	}
-	else if (value->Type == EJson::Object) {
-		// Write object entry
-		if (key.Len() > 0) {
-			writer->WriteObjectStart(key);
+}
+
+/* Sends the collected batch once the batch window elapsed */
+bool UUEGameJoltAPI::OnBatchWindowElapsed(float DeltaTime)
+{
+	BatchTickerHandle.Reset();
+	FlushBatch();
+	return false;
+}
+
+/* Gets the write journal, loading it on first use */
+FGameJoltWriteJournal& UUEGameJoltAPI::GetWriteJournal()
+{
+	if(!WriteJournal.IsValid())
+	{
+		WriteJournal = MakeShared<FGameJoltWriteJournal>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameJolt"), TEXT("PendingWrites.journal")), MaxQueuedWrites);
+		WriteJournal->Load();
+	}
+	WriteJournal->SetMaxEntries(MaxQueuedWrites);
+	return *WriteJournal;
+}
+
+/* Sends the queued writes in the order they were made */
+void UUEGameJoltAPI::ReplayQueuedWrites()
+{
+	// One write at a time, the next one is sent once this one got acknowledged
+	if(!ReplayingWriteKey.IsEmpty() || Game_ID == 0 || Game_PrivateKey.IsEmpty())
+		return;
+
+	FGameJoltWriteJournal& Journal = GetWriteJournal();
+	FGameJoltJournalEntry* Entry = Journal.FindNextToReplay();
+
+	// Updates sent in an earlier session without an answer may have been applied already
+	while(Entry && Entry->bSent && !FGameJoltWriteJournal::IsSafeToResend(Entry->Action))
+	{
+		UE_LOG(GJAPI, Warning, TEXT("Dropping queued write %s, it may have reached the server already"), *Entry->Endpoint);
+		JournaledRequests.Remove(Entry->Key);
+		Journal.Acknowledge(FString(Entry->Key));
+		Entry = Journal.FindNextToReplay();
+	}
+	if(!Entry)
+		return;
+
+	TSharedPtr<FGameJoltRequest> GameJoltRequest;
+	if(TSharedRef<FGameJoltRequest>* JournaledRequest = JournaledRequests.Find(Entry->Key))
+	{
+		GameJoltRequest = *JournaledRequest;
+	}
+	else
+	{
+		// A write of an earlier session
+		GameJoltRequest = MakeShared<FGameJoltRequest>();
+		GameJoltRequest->Id = NextRequestId++;
+		GameJoltRequest->Action = Entry->Action;
+		GameJoltRequest->Endpoint = Entry->Endpoint;
+		GameJoltRequest->bAppendUserInfo = false;
+		GameJoltRequest->JournalKey = Entry->Key;
+		JournaledRequests.Add(Entry->Key, GameJoltRequest.ToSharedRef());
+	}
+
+	GameJoltRequest->Data.Reset();
+	GameJoltRequest->Response.Reset();
+	Entry->bInFlight = true;
+	ReplayingWriteKey = Entry->Key;
+	UE_LOG(GJAPI, Log, TEXT("Replaying queued write %s"), *Entry->Endpoint);
+	SubmitRequest(GameJoltRequest.ToSharedRef());
+}
+
+/* Gets the amount of writes which haven't been acknowledged yet */
+int32 UUEGameJoltAPI::GetQueuedWriteCount()
+{
+	return GetWriteJournal().Num();
+}
+
+/* Acknowledges a journaled write the server answered, or keeps it for the next replay */
+bool UUEGameJoltAPI::OnJournaledRequestFinished(FGameJoltRequest& GameJoltRequest)
+{
+	const FString Key = GameJoltRequest.JournalKey;
+	if(ReplayingWriteKey == Key)
+		ReplayingWriteKey.Reset();
+
+	FGameJoltWriteJournal& Journal = GetWriteJournal();
+	if(!GameJoltRequest.Response.IsValid())
+	{
+		FGameJoltJournalEntry* Entry = Journal.Find(Key);
+		if(!Entry)
+		{
+			// Dropped from the full journal meanwhile
+			JournaledRequests.Remove(Key);
+			return true;
 		}
-		else {
-			writer->WriteObjectStart();
+
+		if(Entry->bSent && !FGameJoltWriteJournal::IsSafeToResend(Entry->Action))
+		{
+			// Applying the write twice would be worse than losing it
+			UE_LOG(GJAPI, Warning, TEXT("Write %s may have reached the server already. It won't be replayed"), *Entry->Endpoint);
+			Journal.Acknowledge(Key);
+			JournaledRequests.Remove(Key);
+			return true;
 		}
 
-		// Loop through all the values in the object data
-		TSharedPtr<FJsonObject> objectData = value->AsObject();
-		for (auto objectValue = objectData->Values.CreateIterator(); objectValue; ++objectValue) {
-			// Using recursion to write the key and value to the writer
-			WriteObject(writer, objectValue.Key(), objectValue.Value().Get());
+		UE_LOG(GJAPI, Warning, TEXT("Write couldn't reach the server. It will be replayed in %.0f seconds"), OfflineReplayInterval);
+		Entry->bInFlight = false;
+		if(!ReplayTickerHandle.IsValid())
+			ReplayTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnReplayIntervalElapsed), OfflineReplayInterval);
+		return false;
+	}
+
+	// The server answered. Even a rejected write wouldn't succeed when sent again
+	Journal.Acknowledge(Key);
+	JournaledRequests.Remove(Key);
+	return true;
+}
+
+/* Retries the queued writes */
+bool UUEGameJoltAPI::OnReplayIntervalElapsed(float DeltaTime)
+{
+	ReplayTickerHandle.Reset();
+	ReplayQueuedWrites();
+	return false;
+}
+
+/* Attaches a read to an identical one in flight */
+bool UUEGameJoltAPI::TryMergeInFlight(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	if(!IsReadAction(GameJoltRequest->Action))
+		return false;
+
+	FString MergeKey = NormalizeEndpoint(GameJoltRequest->Endpoint);
+	if(GameJoltRequest->bAppendUserInfo)
+		MergeKey += TEXT("|") + UserName;
+
+	if(TSharedRef<FGameJoltRequest>* InFlight = InFlightReads.Find(MergeKey))
+	{
+		// The response is stored in the cache by the request in flight already
+		GameJoltRequest->CacheKey.Reset();
+		(*InFlight)->MergedRequests.Add(GameJoltRequest);
+		UE_LOG(GJAPI, Verbose, TEXT("Merged %s into the identical request in flight"), *GameJoltRequest->Endpoint);
+		return true;
+	}
+
+	GameJoltRequest->MergeKey = MergeKey;
+	InFlightReads.Add(MergeKey, GameJoltRequest);
+	return false;
+}
+
+/* Finishes the reads merged into a completed request with its response */
+void UUEGameJoltAPI::FinishMergedRequests(FGameJoltRequest& GameJoltRequest)
+{
+	if(GameJoltRequest.MergeKey.IsEmpty())
+		return;
+
+	const TSharedRef<FGameJoltRequest>* InFlight = InFlightReads.Find(GameJoltRequest.MergeKey);
+	if(InFlight && &InFlight->Get() == &GameJoltRequest)
+		InFlightReads.Remove(GameJoltRequest.MergeKey);
+	GameJoltRequest.MergeKey.Reset();
+
+	TArray<TSharedRef<FGameJoltRequest>> MergedRequests = MoveTemp(GameJoltRequest.MergedRequests);
+	GameJoltRequest.MergedRequests.Reset();
+	for(const TSharedRef<FGameJoltRequest>& MergedRequest : MergedRequests)
+	{
+		MergedRequest->Data = GameJoltRequest.Data;
+		MergedRequest->Response = GameJoltRequest.Response;
+		MergedRequest->bStreamed = GameJoltRequest.bStreamed;
+		MergedRequest->Scores = GameJoltRequest.Scores;
+		MergedRequest->Users = GameJoltRequest.Users;
+		FinishRequest(*MergedRequest);
+	}
+}
+
+/* Whether the request may be sent again after it failed */
+bool UUEGameJoltAPI::ShouldRetry(const FGameJoltRequest& GameJoltRequest)
+{
+	if(!bRetryFailedRequests || GameJoltRequest.RetryCount >= MaxRetries)
+		return false;
+
+	// A batch is only sent again as a whole, so every sub-request has to be safe to repeat
+	if(GameJoltRequest.SubRequests.Num() > 0)
+	{
+		for(const TSharedRef<FGameJoltRequest>& SubRequest : GameJoltRequest.SubRequests)
+		{
+			if(!IsIdempotentAction(SubRequest->Action) || GetCircuitState(SubRequest->Action) == EGameJoltCircuitState::Open)
+				return false;
 		}
+		return true;
+	}
 
-		writer->WriteObjectEnd();
+	return IsIdempotentAction(GameJoltRequest.Action) && GetCircuitState(GameJoltRequest.Action) != EGameJoltCircuitState::Open;
+}
+
+/* Sends a failed request again after a capped exponential backoff with jitter */
+void UUEGameJoltAPI::ScheduleRetry(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	const float Backoff = FMath::Min(RetryBaseDelay * FMath::Pow(2.f, GameJoltRequest->RetryCount), RetryMaxDelay);
+	const float Delay = Backoff * FMath::FRandRange(0.5f, 1.f);
+	GameJoltRequest->RetryCount++;
+	INC_DWORD_STAT(STAT_GameJolt_Retried);
+
+	UE_LOG(GJAPI, Warning, TEXT("Request failed. Retry %d of %d in %.1f seconds"), GameJoltRequest->RetryCount, MaxRetries, Delay);
+	RetryTickerHandles.Add(GameJoltRequest->Id, FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnRetryElapsed, GameJoltRequest), Delay));
+}
+
+/* Sends a request again */
+bool UUEGameJoltAPI::OnRetryElapsed(float DeltaTime, TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	RetryTickerHandles.Remove(GameJoltRequest->Id);
+	NumRetries++;
+
+	// The circuit might have opened meanwhile
+	if(!AllowByCircuit(*GameJoltRequest))
+	{
+		FailFast(GameJoltRequest);
+		return false;
+	}
+
+	ProcessRequest(GameJoltRequest);
+	return false;
+}
+
+/* Gets the circuit breaker, configured with the current settings */
+FGameJoltCircuitBreaker& UUEGameJoltAPI::GetCircuitBreaker()
+{
+	if(!CircuitBreaker.IsValid())
+		CircuitBreaker = MakeShared<FGameJoltCircuitBreaker>();
+	CircuitBreaker->Configure(CircuitBreakerThreshold, CircuitBreakerCooldown);
+	return *CircuitBreaker;
+}
+
+/* Whether the circuit of the request lets it through */
+bool UUEGameJoltAPI::AllowByCircuit(const FGameJoltRequest& GameJoltRequest)
+{
+	if(CircuitBreakerThreshold <= 0 || GameJoltRequest.Action == EGameJoltComponentEnum::GJ_BATCH)
+		return true;
+
+	FGameJoltCircuitBreaker& Breaker = GetCircuitBreaker();
+	const EGameJoltCircuitState PreviousState = Breaker.GetState(GameJoltRequest.Action);
+	const bool bAllowed = Breaker.AllowRequest(GameJoltRequest.Action);
+	const EGameJoltCircuitState State = Breaker.GetState(GameJoltRequest.Action);
+	if(State != PreviousState)
+		OnCircuitStateChanged.Broadcast(GameJoltRequest.Action, State);
+	return bAllowed;
+}
+
+/* Updates the circuits of a request with whether the server answered */
+void UUEGameJoltAPI::RecordCircuitOutcome(const FGameJoltRequest& GameJoltRequest, bool bReachedServer)
+{
+	if(CircuitBreakerThreshold <= 0)
+		return;
+
+	if(GameJoltRequest.SubRequests.Num() > 0)
+	{
+		for(const TSharedRef<FGameJoltRequest>& SubRequest : GameJoltRequest.SubRequests)
+			RecordCircuitOutcome(*SubRequest, bReachedServer);
+		return;
 	}
-	else if (value->Type == EJson::Array) {
-		// Process array entry
-		writer->WriteArrayStart(key);
 
-		TArray<TSharedPtr<FJsonValue>> objectArray = value->AsArray();
-		for (int32 i = 0; i < objectArray.Num(); i++) {
-			// Use recursion with an empty key to process all the values in the array
-			WriteObject(writer, "", objectArray[i].Get());
+	FGameJoltCircuitBreaker& Breaker = GetCircuitBreaker();
+	const EGameJoltCircuitState PreviousState = Breaker.GetState(GameJoltRequest.Action);
+	if(bReachedServer)
+		Breaker.RecordSuccess(GameJoltRequest.Action);
+	else
+		Breaker.RecordFailure(GameJoltRequest.Action);
+
+	const EGameJoltCircuitState State = Breaker.GetState(GameJoltRequest.Action);
+	if(State != PreviousState)
+	{
+		if(State == EGameJoltCircuitState::Open)
+			UE_LOG(GJAPI, Warning, TEXT("Circuit of %s opened. Requests fail fast for %.0f seconds"), *UEnum::GetValueAsString<EGameJoltComponentEnum>(GameJoltRequest.Action), CircuitBreakerCooldown);
+		OnCircuitStateChanged.Broadcast(GameJoltRequest.Action, State);
+	}
+}
+
+/* Finishes a request whose circuit is open, with its last cached response if there is one */
+void UUEGameJoltAPI::FailFast(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	NumFailedFast++;
+
+	// A revalidation has to fail, so its cache entry can be revalidated again later. Other silent requests still get the cached response
+	TSharedPtr<FJsonObject> CachedData;
+	if(!GameJoltRequest->bRevalidation && !GameJoltRequest->CacheKey.IsEmpty() && ResponseCache.IsValid() && ResponseCache->FindAnyAge(GameJoltRequest->CacheKey, CachedData))
+	{
+		GameJoltRequest->Data = CachedData;
+		const TSharedPtr<FJsonObject>* ResponseObject;
+		if(CachedData->TryGetObjectField(TEXT("response"), ResponseObject))
+			GameJoltRequest->Response = *ResponseObject;
+		GameJoltRequest->bFromCache = true;
+	}
+	FinishDeferred(GameJoltRequest);
+}
+
+/* Gets the state of the circuit breaker of an action */
+EGameJoltCircuitState UUEGameJoltAPI::GetCircuitState(EGameJoltComponentEnum Action) const
+{
+	return CircuitBreaker.IsValid() ? CircuitBreaker->GetState(Action) : EGameJoltCircuitState::Closed;
+}
+
+/* Gets the retry and circuit breaker counters */
+FGameJoltRetryStats UUEGameJoltAPI::GetRetryStats() const
+{
+	FGameJoltRetryStats Stats;
+	Stats.Retries = NumRetries;
+	Stats.PendingRetries = RetryTickerHandles.Num();
+	Stats.FailedFast = NumFailedFast;
+	Stats.OpenCircuits = CircuitBreaker.IsValid() ? CircuitBreaker->NumOpen() : 0;
+	return Stats;
+}
+
+/* Gets the local scoreboards, creating them on first use */
+FGameJoltLocalLeaderboard& UUEGameJoltAPI::GetLocalLeaderboard()
+{
+	if(!LocalLeaderboard.IsValid())
+		LocalLeaderboard = MakeShared<FGameJoltLocalLeaderboard>(FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameJolt"), TEXT("Leaderboards")), MaxLocalScores);
+	LocalLeaderboard->SetMaxScores(MaxLocalScores);
+	return *LocalLeaderboard;
+}
+
+/* Gets the score submitter, creating it on first use */
+FGameJoltScoreSubmitter& UUEGameJoltAPI::GetScoreSubmitter()
+{
+	if(!ScoreSubmitter.IsValid())
+		ScoreSubmitter = MakeShared<FGameJoltScoreSubmitter>();
+	ScoreSubmitter->SetAscendingTables(AscendingScoreTables);
+	return *ScoreSubmitter;
+}
+
+/* Gets the response cache, creating it on first use */
+FGameJoltResponseCache& UUEGameJoltAPI::GetResponseCache()
+{
+	if(!ResponseCache.IsValid())
+		ResponseCache = MakeShared<FGameJoltResponseCache>(MaxCachedResponses);
+	ResponseCache->SetMaxEntries(MaxCachedResponses);
+	return *ResponseCache;
+}
+
+/* Answers a read request from the response cache */
+bool UUEGameJoltAPI::TryServeFromCache(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	const float* TimeToLive = CacheTimeToLive.Find(GameJoltRequest->Action);
+	if(!TimeToLive || *TimeToLive <= 0.f)
+		return false;
+
+	GameJoltRequest->CacheKey = GameJoltRequest->Endpoint;
+	if(GameJoltRequest->bAppendUserInfo)
+		GameJoltRequest->CacheKey += TEXT("|") + UserName;
+
+	TSharedPtr<FJsonObject> CachedData;
+	bool bNeedsRefresh = false;
+	if(GetResponseCache().Find(GameJoltRequest->CacheKey, *TimeToLive, CacheStaleWindow, CachedData, bNeedsRefresh) == EGameJoltCacheLookup::Miss)
+		return false;
+
+	if(bNeedsRefresh)
+	{
+		TSharedRef<FGameJoltRequest> Refresh = MakeShared<FGameJoltRequest>();
+		Refresh->Id = NextRequestId++;
+		Refresh->Action = GameJoltRequest->Action;
+		Refresh->Endpoint = GameJoltRequest->Endpoint;
+		Refresh->bAppendUserInfo = GameJoltRequest->bAppendUserInfo;
+		Refresh->CacheKey = GameJoltRequest->CacheKey;
+		Refresh->bSilent = true;
+		Refresh->bRevalidation = true;
+		SubmitRequest(Refresh);
+	}
+
+	GameJoltRequest->Data = CachedData;
+	const TSharedPtr<FJsonObject>* ResponseObject;
+	if(CachedData->TryGetObjectField(TEXT("response"), ResponseObject))
+		GameJoltRequest->Response = *ResponseObject;
+	GameJoltRequest->bFromCache = true;
+	FinishDeferred(GameJoltRequest);
+	return true;
+}
+
+/* Removes the cached responses a successful write made outdated */
+void UUEGameJoltAPI::InvalidateCachedResponses(const FGameJoltRequest& GameJoltRequest)
+{
+	if(!ResponseCache.IsValid())
+		return;
+
+	switch(GameJoltRequest.Action)
+	{
+		case EGameJoltComponentEnum::GJ_SCORES_ADD:
+		{
+			// Without a table the score went to the primary one, whose id isn't known here
+			const FString TableID = GetQueryParameter(GameJoltRequest.Endpoint, TEXT("table_id"));
+			ResponseCache->Invalidate([&TableID](const FString& Key, EGameJoltComponentEnum Action)
+			{
+				if(Action != EGameJoltComponentEnum::GJ_SCORES_FETCH && Action != EGameJoltComponentEnum::GJ_SCORES_RANK)
+					return false;
+				const FString CachedTableID = GetQueryParameter(Key, TEXT("table_id"));
+				return TableID.IsEmpty() || CachedTableID.IsEmpty() || CachedTableID == TableID;
+			});
+			break;
 		}
+		case EGameJoltComponentEnum::GJ_TROPHIES_ADD:
+		case EGameJoltComponentEnum::GJ_TROHIES_REMOVE:
+			ResponseCache->Invalidate([](const FString& Key, EGameJoltComponentEnum Action)
+			{
+				return Action == EGameJoltComponentEnum::GJ_TROPHIES_FETCH;
+			});
+			break;
+		default:
+			break;
+	}
+}
 
-		writer->WriteArrayEnd();
+/* Gets the counters of the response cache */
+FGameJoltCacheStats UUEGameJoltAPI::GetCacheStats()
+{
+	FGameJoltCacheStats Stats;
+	if(ResponseCache.IsValid())
+	{
+		Stats.Hits = ResponseCache->Hits;
+		Stats.StaleHits = ResponseCache->StaleHits;
+		Stats.Misses = ResponseCache->Misses;
+		Stats.Evictions = ResponseCache->Evictions;
+		Stats.Entries = ResponseCache->Num();
 	}
+	return Stats;
+}
+
+/* Removes all cached responses */
+void UUEGameJoltAPI::ClearResponseCache()
+{
+	if(ResponseCache.IsValid())
+		ResponseCache->Empty();
+}
+
+/* Finishes a request which is answered without the server on the next tick */
+void UUEGameJoltAPI::FinishDeferred(TSharedRef<FGameJoltRequest> GameJoltRequest)
+{
+	DeferredRequests.Add(GameJoltRequest);
+	if(!DeferredTickerHandle.IsValid())
+		DeferredTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEGameJoltAPI::OnDeferredRequestsTick), 0.f);
+}
+
+/* Finishes the deferred requests */
+bool UUEGameJoltAPI::OnDeferredRequestsTick(float DeltaTime)
+{
+	DeferredTickerHandle.Reset();
+	TArray<TSharedRef<FGameJoltRequest>> Requests = MoveTemp(DeferredRequests);
+	DeferredRequests.Reset();
+	for(const TSharedRef<FGameJoltRequest>& GameJoltRequest : Requests)
+		FinishRequest(*GameJoltRequest);
+	return false;
+}
+
+/* Gets the amount of requests in flight */
+int32 UUEGameJoltAPI::GetPendingRequestCount() const
+{
+	const int32 NumScheduled = RequestScheduler.IsValid() ? RequestScheduler->Num() : 0;
+	return PendingRequests.Num() + PendingBatch.Num() + DeferredRequests.Num() + NumScheduled + RetryTickerHandles.Num();
 }
 
 /* Creates data from a string */
@@ -776,79 +1973,306 @@ void UUEGameJoltAPI::FromString(const FString& dataString) {
 	Content = dataString;
 }
 
-/* Callback for IHttpRequest::OnProcessRequestComplete() */
-void UUEGameJoltAPI::OnReady(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful) {
+/* Called by the transport once a request completed */
+void UUEGameJoltAPI::OnReady(bool bWasSuccessful, int32 ResponseCode, const TArray<uint8>& ResponseContent, TSharedRef<FGameJoltRequest> GameJoltRequest) {
+	if (PendingRequests.Remove(GameJoltRequest->Id) > 0)
+		DEC_DWORD_STAT(STAT_GameJolt_InFlight);
+	GameJoltRequest->ResponseSize = ResponseContent.Num();
+
+	// A slot is free again
+	PumpScheduler();
+
+	// Rejections by the server are answers as well, only missing answers and server errors count as failures
+	const bool bReachedServer = bWasSuccessful && ResponseCode < 500 && ResponseCode != 429;
+	RecordCircuitOutcome(*GameJoltRequest, bReachedServer);
+	if (!bReachedServer && ShouldRetry(*GameJoltRequest))
+	{
+		ScheduleRetry(GameJoltRequest);
+		return;
+	}
+
+	const bool bStream = bStreamLargeResponses && GameJoltRequest->CacheKey.IsEmpty()
+		&& (GameJoltRequest->Action == EGameJoltComponentEnum::GJ_SCORES_FETCH || GameJoltRequest->Action == EGameJoltComponentEnum::GJ_USERS_FETCH);
+
 	if (!bWasSuccessful) {
 		UE_LOG(GJAPI, Warning, TEXT("Response was invalid! Please check the URL."));
+	}
+	else if (bStream)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GameJolt_Parse);
+		FGameJoltStreamEnvelope Envelope;
+		bool bDecoded;
+		if (GameJoltRequest->Action == EGameJoltComponentEnum::GJ_SCORES_FETCH)
+		{
+			const FString Limit = GetQueryParameter(GameJoltRequest->Endpoint, TEXT("limit"));
+			bDecoded = FGameJoltStreamDecoder::DecodeScores(ResponseContent, Limit.IsEmpty() ? 10 : FCString::Atoi(*Limit), Envelope, GameJoltRequest->Scores);
+		}
+		else
+		{
+			const FString UserIDs = GetQueryParameter(GameJoltRequest->Endpoint, TEXT("user_id"));
+			int32 NumUserIDs = 1;
+			for (const TCHAR Character : UserIDs)
+				NumUserIDs += Character == TEXT(',') ? 1 : 0;
+			bDecoded = FGameJoltStreamDecoder::DecodeUsers(ResponseContent, NumUserIDs, Envelope, GameJoltRequest->Users);
+		}
 
-		// Broadcast the failed event
-		OnFailed.Broadcast();
+		// Only the envelope is kept, which is what FinishRequest checks
+		if (bDecoded)
+		{
+			GameJoltRequest->bStreamed = true;
+			GameJoltRequest->Response = MakeShared<FJsonObject>();
+			GameJoltRequest->Response->SetBoolField(TEXT("success"), Envelope.bSuccess);
+			if (!Envelope.Message.IsEmpty())
+				GameJoltRequest->Response->SetStringField(TEXT("message"), Envelope.Message);
+		}
+	}
+	else
+	{
+		// Process the string into the request's own data
+		SCOPE_CYCLE_COUNTER(STAT_GameJolt_Parse);
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(ResponseContent.GetData()), ResponseContent.Num());
+		const FString ResponseString(Converted.Length(), Converted.Get());
+		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ResponseString);
+		if (!FJsonSerializer::Deserialize(JsonReader, GameJoltRequest->Data) || !GameJoltRequest->Data.IsValid())
+		{
+			UE_LOG(GJAPI, Error, TEXT("JSON data is invalid! Input:\n'%s'"), *ResponseString);
+			GameJoltRequest->Data.Reset();
+		}
+		else
+		{
+			const TSharedPtr<FJsonObject>* ResponseObject;
+			if (GameJoltRequest->Data->TryGetObjectField(TEXT("response"), ResponseObject))
+				GameJoltRequest->Response = *ResponseObject;
+			Content = ResponseString;
+		}
+	}
+
+	if (GameJoltRequest->Action == EGameJoltComponentEnum::GJ_BATCH)
+	{
+		RouteBatchResponse(*GameJoltRequest);
 		return;
 	}
 
-	// Process the string
-	FromString(Response->GetContentAsString());
+	FinishRequest(*GameJoltRequest);
+}
 
-	if(!GetObject("response") || (GetObject("response")->GetBool("success") == false && LastActionPerformed != EGameJoltComponentEnum::GJ_SESSION_CHECK))
+/* Splits the response of a batch request into the responses of its sub-requests */
+void UUEGameJoltAPI::RouteBatchResponse(FGameJoltRequest& BatchRequest)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Responses = nullptr;
+	if (BatchRequest.Response.IsValid())
+		BatchRequest.Response->TryGetArrayField(TEXT("responses"), Responses);
+
+	for (int32 i = 0; i < BatchRequest.SubRequests.Num(); i++)
 	{
-		OnFailed.Broadcast();
+		FGameJoltRequest& SubRequest = BatchRequest.SubRequests[i].Get();
+
+		// Sub-responses come without the "response" envelope of a regular request
+		// Sub-requests after a failing one are missing if break_on_error was set
+		if (Responses && Responses->IsValidIndex(i) && (*Responses)[i].IsValid() && (*Responses)[i]->Type == EJson::Object)
+		{
+			SubRequest.Response = (*Responses)[i]->AsObject();
+			SubRequest.Data = MakeShared<FJsonObject>();
+			SubRequest.Data->SetObjectField(TEXT("response"), SubRequest.Response);
+		}
+		FinishRequest(SubRequest);
+	}
+
+	bool bSuccess = false;
+	if (BatchRequest.Response.IsValid())
+		BatchRequest.Response->TryGetBoolField(TEXT("success"), bSuccess);
+	BatchRequest.bSucceeded = bSuccess;
+	if (BatchRequest.OnComplete)
+		BatchRequest.OnComplete(BatchRequest);
+}
+
+/* Checks the response of a request, broadcasts its delegates and calls its callback */
+void UUEGameJoltAPI::FinishRequest(FGameJoltRequest& GameJoltRequest)
+{
+	// Unsent writes stay queued and finish once they got replayed
+	if(!GameJoltRequest.JournalKey.IsEmpty() && !OnJournaledRequestFinished(GameJoltRequest))
 		return;
+
+	// The server can be reached (again), so catch up on the queued writes
+	if(GameJoltRequest.Response.IsValid() && WriteJournal.IsValid() && WriteJournal->Num() > 0)
+		ReplayQueuedWrites();
+
+	bool bSuccess = false;
+	if (GameJoltRequest.Response.IsValid())
+		GameJoltRequest.Response->TryGetBoolField(TEXT("success"), bSuccess);
+	GameJoltRequest.bSucceeded = bSuccess;
+	if(!bSuccess)
+		INC_DWORD_STAT(STAT_GameJolt_Failed);
+	FGameJoltRequestTrace::End(GameJoltRequest);
+
+	if(!GameJoltRequest.CacheKey.IsEmpty() && !GameJoltRequest.bFromCache)
+	{
+		if(bSuccess)
+			GetResponseCache().Store(GameJoltRequest.CacheKey, GameJoltRequest.Action, GameJoltRequest.Data);
+		else
+			GetResponseCache().EndRefresh(GameJoltRequest.CacheKey);
 	}
+	if(bSuccess && !GameJoltRequest.bFromCache)
+		InvalidateCachedResponses(GameJoltRequest);
 
-	switch(LastActionPerformed)
+	// Fetched scoreboards keep the local ones up to date, including the pages of leaderboard cursors
+	// and teach the personal bests of their players, e.g. from an earlier session
+	if(bSuccess && !GameJoltRequest.bFromCache && (bKeepLocalScoreboards || bSmartSubmitScores) && GameJoltRequest.Action == EGameJoltComponentEnum::GJ_SCORES_FETCH)
+	{
+		TArray<FScoreInfo> Scores;
+		if(GameJoltRequest.bStreamed)
+			Scores = GameJoltRequest.Scores;
+		else
+			FGameJoltResponseDecoder::DecodeScores(GameJoltRequest.Response, Scores);
+
+		const int32 TableID = FCString::Atoi(*GetQueryParameter(GameJoltRequest.Endpoint, TEXT("table_id")));
+		if(bKeepLocalScoreboards)
+			GetLocalLeaderboard().MergeServerScores(TableID, Scores);
+		if(bSmartSubmitScores)
+		{
+			FGameJoltScoreSubmitter& Submitter = GetScoreSubmitter();
+			for(const FScoreInfo& Score : Scores)
+				Submitter.UpdateBest(TableID, FGameJoltScoreSubmitter::GetPlayerKey(Score.UserName, Score.Guest), Score.ScoreSort);
+		}
+	}
+
+	if(GameJoltRequest.bSilent)
+	{
+		if (GameJoltRequest.OnComplete)
+			GameJoltRequest.OnComplete(GameJoltRequest);
+		FinishMergedRequests(GameJoltRequest);
+		return;
+	}
+
+	// Keep the 'Get' nodes working on the response which completed last
+	if (GameJoltRequest.Data.IsValid())
+		Data = GameJoltRequest.Data;
+
+	if(!GameJoltRequest.Response.IsValid() || (!bSuccess && GameJoltRequest.Action != EGameJoltComponentEnum::GJ_SESSION_CHECK))
+	{
+		// Broadcast the failed event
+		SCOPE_CYCLE_COUNTER(STAT_GameJolt_Broadcast);
+		OnFailed.Broadcast();
+	}
+	else
+	{
+		DispatchResponse(GameJoltRequest);
+	}
+
+	if (GameJoltRequest.OnComplete)
+		GameJoltRequest.OnComplete(GameJoltRequest);
+
+	// Every merged caller gets its own events and callback, after the request it shared the call with
+	FinishMergedRequests(GameJoltRequest);
+}
+
+/* Broadcasts the delegates matching the action of a completed request */
+void UUEGameJoltAPI::DispatchResponse(const FGameJoltRequest& GameJoltRequest)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameJolt_Broadcast);
+
+	switch(GameJoltRequest.Action)
 	{
 		case EGameJoltComponentEnum::GJ_USER_AUTH:
-			OnUserAuthorized.Broadcast(isUserAuthorize());
+			bIsLoggedIn = GameJoltRequest.bSucceeded;
+			OnUserAuthorized.Broadcast(bIsLoggedIn);
 			break;
 		case EGameJoltComponentEnum::GJ_USER_AUTOLOGIN:
-			OnAutoLogin.Broadcast(isUserAuthorize());
+			bIsLoggedIn = GameJoltRequest.bSucceeded;
+			OnAutoLogin.Broadcast(bIsLoggedIn);
 			break;
 		case EGameJoltComponentEnum::GJ_USER_FETCH:
-			OnUserFetched.Broadcast(GetUserInfo()[0]);
+		{
+			TArray<FUserInfo> Users;
+			if(FGameJoltResponseDecoder::DecodeUsers(GameJoltRequest.Response, Users) && Users.Num() > 0)
+				OnUserFetched.Broadcast(Users[0]);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_USERS_FETCH:
-			OnUsersFetched.Broadcast(GetUserInfo());
+		{
+			if (GameJoltRequest.bStreamed)
+			{
+				OnUsersFetched.Broadcast(GameJoltRequest.Users);
+				break;
+			}
+			TArray<FUserInfo> Users;
+			FGameJoltResponseDecoder::DecodeUsers(GameJoltRequest.Response, Users);
+			OnUsersFetched.Broadcast(Users);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_USER_FRIENDLIST:
-			OnFriendlistFetched.Broadcast(GetFriendlist());
+		{
+			TArray<int32> FriendIDs;
+			FGameJoltResponseDecoder::DecodeFriendlist(GameJoltRequest.Response, FriendIDs);
+			OnFriendlistFetched.Broadcast(FriendIDs);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_SESSION_OPEN:
-			OnSessionOpened.Broadcast(GetSessionStatus());
+			OnSessionOpened.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_SESSION_PING:
-			OnSessionPinged.Broadcast(GetSessionStatus());
+			OnSessionPinged.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_SESSION_CLOSE:
-			OnSessionClosed.Broadcast(GetSessionStatus());
+			OnSessionClosed.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_SESSION_CHECK:
-			OnSessionChecked.Broadcast(GetSessionStatus());
+			OnSessionChecked.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_TROPHIES_FETCH:
-			OnTrophiesFetched.Broadcast(GetTrophies());
+		{
+			TArray<FTrophyInfo> Trophies;
+			FGameJoltResponseDecoder::DecodeTrophies(GameJoltRequest.Response, Trophies);
+			OnTrophiesFetched.Broadcast(Trophies);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_TROHIES_REMOVE:
-			OnTrophyRemoved.Broadcast(GetTrophyRemovalStatus());
+			OnTrophyRemoved.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_SCORES_ADD:
-			OnScoreAdded.Broadcast(GetObject("response")->GetBool("success"));
+			OnScoreAdded.Broadcast(GameJoltRequest.bSucceeded);
 			break;
 		case EGameJoltComponentEnum::GJ_SCORES_FETCH:
-			OnScoreboardFetched.Broadcast(GetScoreboard());
+		{
+			if (GameJoltRequest.bStreamed)
+			{
+				OnScoreboardFetched.Broadcast(GameJoltRequest.Scores);
+				break;
+			}
+			TArray<FScoreInfo> Scores;
+			FGameJoltResponseDecoder::DecodeScores(GameJoltRequest.Response, Scores);
+			OnScoreboardFetched.Broadcast(Scores);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_SCORES_TABLE:
-			OnScoreboardTableFetched.Broadcast(GetScoreboardTable());
+		{
+			TArray<FScoreTableInfo> Tables;
+			FGameJoltResponseDecoder::DecodeScoreTables(GameJoltRequest.Response, Tables);
+			OnScoreboardTableFetched.Broadcast(Tables);
 			break;
+		}
 		case EGameJoltComponentEnum::GJ_SCORES_RANK:
-			OnRankFetched.Broadcast(GetRank());
+			OnRankFetched.Broadcast(FGameJoltResponseDecoder::DecodeInt(*GameJoltRequest.Response, TEXT("rank")));
 			break;
 		case EGameJoltComponentEnum::GJ_TIME:
-			OnTimeFetched.Broadcast(ReadServerTime());
+		{
+			FDateTime ServerTime;
+			FGameJoltResponseDecoder::DecodeServerTime(GameJoltRequest.Response, ServerTime);
+			OnTimeFetched.Broadcast(ServerTime);
+			break;
+		}
+		case EGameJoltComponentEnum::GJ_DATASTORE_KEYS:
+		{
+			TArray<FString> Keys;
+			FGameJoltResponseDecoder::DecodeDataKeys(GameJoltRequest.Response, Keys);
+			OnDataKeysFetched.Broadcast(Keys);
+			break;
+		}
+		default:
 			break;
 	}
 	// Broadcast the result event
 	OnGetResult.Broadcast();
-	return;
 }
 
 /* Resets the saved data */